@@ -0,0 +1,2355 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// Micro-benchmarks for MPML
+// Compares the current implementations against plain scalar references.
+// Prints a single JSON document on stdout, one entry per (benchmark, type, variant), so that runs can be diffed.
+// ===================================================
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "mpml/mpml.hpp"
+#include "mpml/functions/trigo.hpp"
+#include "mpml/functions/batch.hpp"
+#include "mpml/functions/fast.hpp"
+#include "mpml/functions/morton.hpp"
+#include "mpml/utilities/expression.hpp"
+#include "mpml/utilities/flat_hash_map.hpp"
+#include "mpml/scene/transform.hpp"
+#include "mpml/scene/hierarchy.hpp"
+#include "mpml/geometry/frustum.hpp"
+#include "mpml/geometry/ray.hpp"
+#include "mpml/geometry/bvh.hpp"
+#include "mpml/geometry/voxel_ray.hpp"
+
+#if defined(MPML_BENCH_DISPATCH)
+#	include "mpml/dispatch/dispatch.hpp"
+#endif
+
+
+namespace
+{
+
+	struct Result
+	{
+		std::string name;
+		std::string type;
+		std::string variant;
+		double ns_per_op;
+		std::optional<double> max_diff;	// against the reference variant of the same benchmark
+	};
+
+	std::vector<Result> results;
+
+	void report(std::string name, std::string type, std::string variant, double ns_per_op, std::optional<double> max_diff = std::nullopt)
+	{
+		results.push_back(Result{ std::move(name), std::move(type), std::move(variant), ns_per_op, max_diff });
+	}
+
+	[[nodiscard]] std::string json_string(const std::string& str)
+	{
+		std::string str_r{ '"' };
+
+		for (char c : str)
+		{
+			if (c == '"' || c == '\\')
+				str_r += '\\';
+			str_r += c;
+		}
+
+		return str_r + '"';
+	}
+
+	void print_json()
+	{
+		std::printf("{\n\t\"simd\": [");
+
+		const char* separator{ "" };
+
+		for (const char* isa : {
+#if defined(MPML_SIMD_SSE2)
+			"sse2",
+#endif
+#if defined(MPML_SIMD_SSE41)
+			"sse4.1",
+#endif
+#if defined(MPML_SIMD_AVX)
+			"avx",
+#endif
+#if defined(MPML_SIMD_AVX2)
+			"avx2",
+#endif
+#if defined(MPML_SIMD_FMA)
+			"fma",
+#endif
+			"" })
+		{
+			if (*isa == '\0')
+				continue;
+
+			std::printf("%s\"%s\"", separator, isa);
+			separator = ", ";
+		}
+
+		std::printf("],\n\t\"results\": [\n");
+
+		for (size_t i{}; i < results.size(); i++)
+		{
+			const Result& result{ results[i] };
+
+			std::printf("\t\t{ \"name\": %s, \"type\": %s, \"variant\": %s, \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f",
+				json_string(result.name).c_str(), json_string(result.type).c_str(), json_string(result.variant).c_str(),
+				result.ns_per_op, 1e9 / result.ns_per_op);
+
+			// JSON has no nan or inf, a diverging variant reports null
+			if (result.max_diff && std::isfinite(*result.max_diff))
+				std::printf(", \"max_diff\": %g", *result.max_diff);
+			else if (result.max_diff)
+				std::printf(", \"max_diff\": null");
+
+			std::printf(" }%s\n", i + 1 < results.size() ? "," : "");
+		}
+
+		std::printf("\t]\n}\n");
+	}
+
+	// Runs op rounds times, op processing count elements each time
+	template<typename F>
+	[[nodiscard]] double time_batch(size_t count, size_t rounds, F&& op)
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+
+		for (size_t r{}; r < rounds; r++)
+			op();
+
+		const auto end{ std::chrono::steady_clock::now() };
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * count);
+	}
+
+
+	// The scalar product operator*(Matrix4, Matrix4) used before the SIMD kernels
+	template<typename T>
+	[[nodiscard]] mpml::Matrix4<T> scalar_multiply(const mpml::Matrix4<T>& mat1, const mpml::Matrix4<T>& mat2) noexcept
+	{
+		return mpml::Matrix4<T>
+		{
+			mat1.a * mat2.a + mat1.b * mat2.e + mat1.c * mat2.i + mat1.d * mat2.m,
+			mat1.a * mat2.b + mat1.b * mat2.f + mat1.c * mat2.j + mat1.d * mat2.n,
+			mat1.a * mat2.c + mat1.b * mat2.g + mat1.c * mat2.k + mat1.d * mat2.o,
+			mat1.a * mat2.d + mat1.b * mat2.h + mat1.c * mat2.l + mat1.d * mat2.p,
+
+			mat1.e * mat2.a + mat1.f * mat2.e + mat1.g * mat2.i + mat1.h * mat2.m,
+			mat1.e * mat2.b + mat1.f * mat2.f + mat1.g * mat2.j + mat1.h * mat2.n,
+			mat1.e * mat2.c + mat1.f * mat2.g + mat1.g * mat2.k + mat1.h * mat2.o,
+			mat1.e * mat2.d + mat1.f * mat2.h + mat1.g * mat2.l + mat1.h * mat2.p,
+
+			mat1.i * mat2.a + mat1.j * mat2.e + mat1.k * mat2.i + mat1.l * mat2.m,
+			mat1.i * mat2.b + mat1.j * mat2.f + mat1.k * mat2.j + mat1.l * mat2.n,
+			mat1.i * mat2.c + mat1.j * mat2.g + mat1.k * mat2.k + mat1.l * mat2.o,
+			mat1.i * mat2.d + mat1.j * mat2.h + mat1.k * mat2.l + mat1.l * mat2.p,
+
+			mat1.m * mat2.a + mat1.n * mat2.e + mat1.o * mat2.i + mat1.p * mat2.m,
+			mat1.m * mat2.b + mat1.n * mat2.f + mat1.o * mat2.j + mat1.p * mat2.n,
+			mat1.m * mat2.c + mat1.n * mat2.g + mat1.o * mat2.k + mat1.p * mat2.o,
+			mat1.m * mat2.d + mat1.n * mat2.h + mat1.o * mat2.l + mat1.p * mat2.p
+		};
+	}
+
+	// det() and inverse() as they were before the closed form: one Matrix3 minor per cofactor
+	template<typename T>
+	[[nodiscard]] T minor_det(const mpml::Matrix4<T>& mat) noexcept
+	{
+		return mat.a * mat.minor(0).det() - mat.b * mat.minor(1).det() + mat.c * mat.minor(2).det() - mat.d * mat.minor(3).det();
+	}
+
+	template<typename T>
+	[[nodiscard]] std::optional<mpml::Matrix4<T>> minor_inverse(const mpml::Matrix4<T>& mat) noexcept
+	{
+		const T determinant{ minor_det(mat) };
+
+		if (determinant == T{})
+			return std::nullopt;
+
+		mpml::Matrix4<T> cofactors;
+
+		for (size_t i{}; i < 16; i++)
+			cofactors.data[i] = mat.cofactor(i);
+
+		return std::optional<mpml::Matrix4<T>>{ cofactors.transpose() / determinant };
+	}
+
+	template<typename T>
+	[[nodiscard]] std::vector<mpml::Matrix4<T>> random_matrices(size_t count)
+	{
+		std::mt19937 gen{ 42 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1), static_cast<T>(1) };
+
+		std::vector<mpml::Matrix4<T>> mats(count);
+
+		for (auto& mat : mats)
+			for (auto& x : mat.data)
+				x = dist(gen);
+
+		return mats;
+	}
+
+	// Multiplies every matrix of the buffer by another one of it (its size must be a power of two)
+	// The results are kept so that nothing gets optimized away
+	template<typename T, typename F>
+	[[nodiscard]] double time_products(const std::vector<mpml::Matrix4<T>>& mats, size_t rounds, F&& multiply)
+	{
+		std::vector<mpml::Matrix4<T>> results(mats.size());
+
+		const auto start{ std::chrono::steady_clock::now() };
+
+		for (size_t r{}; r < rounds; r++)
+			for (size_t i{}; i < mats.size(); i++)
+				results[i] = multiply(mats[i], mats[(i + r + 1) & (mats.size() - 1)]);
+
+		const auto end{ std::chrono::steady_clock::now() };
+
+		volatile T sink{ results[rounds % mats.size()].a };
+		(void)sink;
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * mats.size());
+	}
+
+	template<typename T, typename R, typename F>
+	[[nodiscard]] double time_unary(const std::vector<mpml::Matrix4<T>>& mats, size_t rounds, F&& op)
+	{
+		std::vector<R> results(mats.size());
+
+		const auto start{ std::chrono::steady_clock::now() };
+
+		for (size_t r{}; r < rounds; r++)
+			for (size_t i{}; i < mats.size(); i++)
+				results[i] = op(mats[i]);
+
+		const auto end{ std::chrono::steady_clock::now() };
+
+		volatile unsigned char sink{ *reinterpret_cast<const unsigned char*>(&results[rounds % mats.size()]) };
+		(void)sink;
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * mats.size());
+	}
+
+	template<typename T>
+	void bench_matrix4_inverse(const char* type_name)
+	{
+		const auto mats{ random_matrices<T>(128) };
+		constexpr size_t rounds{ 2000 };
+
+		using Inverse = std::optional<mpml::Matrix4<T>>;
+
+		const double minors_det{ time_unary<T, T>(mats, rounds, [](const auto& m) { return minor_det(m); }) };
+		const double current_det{ time_unary<T, T>(mats, rounds, [](const auto& m) { return m.det(); }) };
+
+		const double minors_inv{ time_unary<T, Inverse>(mats, rounds, [](const auto& m) { return minor_inverse(m); }) };
+		const double current_inv{ time_unary<T, Inverse>(mats, rounds, [](const auto& m) { return m.inverse(); }) };
+
+		report("Matrix4 det", type_name, "minors", minors_det);
+		report("Matrix4 det", type_name, "mpml", current_det);
+		report("Matrix4 inverse", type_name, "minors", minors_inv);
+		report("Matrix4 inverse", type_name, "mpml", current_inv);
+	}
+
+	template<typename T>
+	void bench_matrix4_inverse_fast_paths(const char* type_name)
+	{
+		std::mt19937 gen{ 7 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-10), static_cast<T>(10) };
+
+		// View matrices: rigid-body, hence also affine
+		std::vector<mpml::Matrix4<T>> views(128);
+
+		for (auto& view : views)
+			view = mpml::lookAt<T>({ dist(gen), dist(gen), dist(gen) }, { dist(gen), dist(gen), dist(gen) }, { 0, 1, 0 });
+
+		constexpr size_t rounds{ 2000 };
+
+		using Inverse = std::optional<mpml::Matrix4<T>>;
+
+		const double general{ time_unary<T, Inverse>(views, rounds, [](const auto& m) { return m.inverse(); }) };
+		const double affine{ time_unary<T, Inverse>(views, rounds, [](const auto& m) { return m.inverse_affine(); }) };
+		const double rigid{ time_unary<T, mpml::Matrix4<T>>(views, rounds, [](const auto& m) { return m.inverse_rigid(); }) };
+
+		report("Matrix4 view inverse", type_name, "inverse", general);
+		report("Matrix4 view inverse", type_name, "inverse_affine", affine);
+		report("Matrix4 view inverse", type_name, "inverse_rigid", rigid);
+	}
+
+	template<typename T>
+	void bench_matrix4_multiply(const char* type_name)
+	{
+		const auto mats{ random_matrices<T>(128) };
+		constexpr size_t rounds{ 20000 };
+
+		const double scalar{ time_products(mats, rounds, [](const auto& a, const auto& b) { return scalar_multiply(a, b); }) };
+		const double current{ time_products(mats, rounds, [](const auto& a, const auto& b) { return a * b; }) };
+
+		report("Matrix4 operator*", type_name, "scalar", scalar);
+		report("Matrix4 operator*", type_name, "mpml", current);
+	}
+
+	// Normalizes the cross product of neighbouring vectors, for both the packed and the padded layout
+	template<typename V>
+	[[nodiscard]] double time_cross_normal(const std::vector<V>& vecs, size_t rounds)
+	{
+		std::vector<V> results(vecs.size());
+
+		const auto start{ std::chrono::steady_clock::now() };
+
+		for (size_t r{}; r < rounds; r++)
+			for (size_t i{}; i < vecs.size(); i++)
+				results[i] = vecs[i].cross(vecs[(i + r + 1) & (vecs.size() - 1)]).normal() + vecs[i];
+
+		const auto end{ std::chrono::steady_clock::now() };
+
+		volatile auto sink{ results[rounds % vecs.size()].x };
+		(void)sink;
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * vecs.size());
+	}
+
+	void bench_vector3a()
+	{
+		std::mt19937 gen{ 3 };
+		std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+
+		std::vector<mpml::Vector3<float>> packed(1024);
+		std::vector<mpml::Vector3A<float>> padded(packed.size());
+
+		for (size_t i{}; i < packed.size(); i++)
+		{
+			packed[i] = { dist(gen), dist(gen), dist(gen) };
+			padded[i] = packed[i];
+		}
+
+		constexpr size_t rounds{ 2000 };
+
+		const double scalar{ time_cross_normal(packed, rounds) };
+		const double simd{ time_cross_normal(padded, rounds) };
+
+		report("cross + normal + add", "float", "Vector3", scalar);
+		report("cross + normal + add", "float", "Vector3A", simd);
+	}
+
+	// The scalar operator*(Quaternion, Quaternion) and the q * v * conj(q) rotation used before rotate_vector
+	template<typename T>
+	[[nodiscard]] mpml::Quaternion<T> scalar_multiply(const mpml::Quaternion<T>& q1, const mpml::Quaternion<T>& q2) noexcept
+	{
+		return mpml::Quaternion<T>
+		{
+			q1.s * q2.s - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z,
+			q1.s * q2.x + q2.s * q1.x + q1.y * q2.z - q2.y * q1.z,
+			q1.s * q2.y + q2.s * q1.y + q1.z * q2.x - q2.z * q1.x,
+			q1.s * q2.z + q2.s * q1.z + q1.x * q2.y - q2.x * q1.y
+		};
+	}
+
+	template<typename T>
+	[[nodiscard]] mpml::Vector3<T> sandwich_rotate(const mpml::Quaternion<T>& q, const mpml::Vector3<T>& vec) noexcept
+	{
+		const mpml::Quaternion<T> rotated{ scalar_multiply(scalar_multiply(q, mpml::Quaternion<T>{ 0, vec }), q.conjugate()) };
+		return mpml::Vector3<T>{ rotated.x, rotated.y, rotated.z };
+	}
+
+	template<typename T, typename F>
+	[[nodiscard]] double time_quaternions(const std::vector<mpml::Quaternion<T>>& quats, size_t rounds, F&& op)
+	{
+		std::vector<decltype(op(quats[0], quats[0]))> results(quats.size());
+
+		const auto start{ std::chrono::steady_clock::now() };
+
+		for (size_t r{}; r < rounds; r++)
+			for (size_t i{}; i < quats.size(); i++)
+				results[i] = op(quats[i], quats[(i + r + 1) & (quats.size() - 1)]);
+
+		const auto end{ std::chrono::steady_clock::now() };
+
+		volatile T sink{ results[rounds % quats.size()].x };
+		(void)sink;
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * quats.size());
+	}
+
+	template<typename T>
+	void bench_quaternion(const char* type_name)
+	{
+		std::mt19937 gen{ 5 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1), static_cast<T>(1) };
+
+		std::vector<mpml::Quaternion<T>> quats(1024);
+
+		for (auto& q : quats)
+			q = mpml::Quaternion<T>{ dist(gen), dist(gen), dist(gen), dist(gen) }.normal();
+
+		constexpr size_t rounds{ 2000 };
+
+		const double scalar_product{ time_quaternions(quats, rounds, [](const auto& a, const auto& b) { return scalar_multiply(a, b); }) };
+		const double current_product{ time_quaternions(quats, rounds, [](const auto& a, const auto& b) { return a * b; }) };
+
+		// The vector part of the other quaternion is used as the vector to rotate
+		const double sandwich{ time_quaternions(quats, rounds, [](const auto& q, const auto& v) { return sandwich_rotate(q, mpml::Vector3<T>{ v.x, v.y, v.z }); }) };
+		const double current_rotate{ time_quaternions(quats, rounds, [](const auto& q, const auto& v) { return q.rotate_vector(mpml::Vector3<T>{ v.x, v.y, v.z }); }) };
+
+		report("Quaternion operator*", type_name, "scalar", scalar_product);
+		report("Quaternion operator*", type_name, "mpml", current_product);
+		report("Quaternion vector rotation", type_name, "q * v * conj(q)", sandwich);
+		report("Quaternion vector rotation", type_name, "rotate_vector", current_rotate);
+	}
+
+	template<typename T>
+	void bench_batch_transforms(const char* type_name)
+	{
+		std::mt19937 gen{ 13 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-100), static_cast<T>(100) };
+
+		constexpr size_t count{ 10000 };
+		constexpr size_t rounds{ 200 };
+
+		std::vector<mpml::Vector3<T>> points(count);
+
+		for (auto& point : points)
+			point = { dist(gen), dist(gen), dist(gen) };
+
+		const mpml::Matrix4<T> mat{ mpml::lookAt<T>({ 3, 4, 5 }, { 0, 0, 0 }, { 0, 1, 0 }) };
+
+		std::vector<mpml::Vector4<T>> per_point(count);
+		std::vector<mpml::Vector3<T>> batched(count);
+
+		const auto time{ [&](auto&& op) {
+			const auto start{ std::chrono::steady_clock::now() };
+
+			for (size_t r{}; r < rounds; r++)
+				op();
+
+			const auto end{ std::chrono::steady_clock::now() };
+
+			return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * count);
+		} };
+
+		const double single{ time([&] {
+			for (size_t i{}; i < count; i++)
+				per_point[i] = mat * points[i];
+		}) };
+
+		const double batch{ time([&] { mpml::transform_points(mat, points, batched); }) };
+		const double project{ time([&] { mpml::transform_points_project(mat, points, batched); }) };
+
+		volatile T sink{ per_point[count / 2].x + batched[count / 2].x };
+		(void)sink;
+
+		report("Matrix4 points", type_name, "operator*(Matrix4, Vector3)", single);
+		report("Matrix4 points", type_name, "transform_points", batch);
+		report("Matrix4 points", type_name, "transform_points_project", project);
+	}
+
+	void bench_soa()
+	{
+		std::mt19937 gen{ 17 };
+		std::uniform_real_distribution<float> dist{ -100.f, 100.f };
+
+		constexpr size_t count{ 10000 };
+		constexpr size_t rounds{ 200 };
+
+		std::vector<mpml::Vector3<float>> aos(count);
+
+		for (auto& vec : aos)
+			vec = { dist(gen), dist(gen), dist(gen) };
+
+		const mpml::Vec3SoA<float> soa{ aos };
+
+		std::vector<float> lengths(count);
+		std::vector<mpml::Vector3<float>> aos_normals(count);
+		mpml::Vec3SoA<float> soa_normals;
+
+		const auto time{ [&](auto&& op) {
+			const auto start{ std::chrono::steady_clock::now() };
+
+			for (size_t r{}; r < rounds; r++)
+				op();
+
+			const auto end{ std::chrono::steady_clock::now() };
+
+			return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * count);
+		} };
+
+		const double aos_length{ time([&] {
+			for (size_t i{}; i < count; i++)
+				lengths[i] = aos[i].length();
+		}) };
+		const double soa_length{ time([&] { soa.length(lengths); }) };
+
+		const double aos_normal{ time([&] {
+			for (size_t i{}; i < count; i++)
+				aos_normals[i] = aos[i].normal();
+		}) };
+		const double soa_normal{ time([&] { soa_normals = soa.normal(); }) };
+
+		const double aos_bounds{ time([&] {
+			mpml::Vector3<float> low{ aos[0] }, high{ aos[0] };
+
+			for (const auto& vec : aos)
+			{
+				low = mpml::min(low, vec);
+				high = mpml::max(high, vec);
+			}
+
+			volatile float sink{ low.x + high.x };
+			(void)sink;
+		}) };
+		const double soa_bounds{ time([&] {
+			volatile float sink{ soa.min().x + soa.max().x };
+			(void)sink;
+		}) };
+
+		volatile float sink{ lengths[count / 2] + aos_normals[count / 2].x + soa_normals.x()[count / 2] };
+		(void)sink;
+
+		report("Vector3 array length", "float", "AoS", aos_length);
+		report("Vector3 array length", "float", "Vec3SoA", soa_length);
+		report("Vector3 array normal", "float", "AoS", aos_normal);
+		report("Vector3 array normal", "float", "Vec3SoA", soa_normal);
+		report("Vector3 array min/max", "float", "AoS", aos_bounds);
+		report("Vector3 array min/max", "float", "Vec3SoA", soa_bounds);
+	}
+
+	void bench_pack()
+	{
+		using mpml::float8;
+
+		std::mt19937 gen{ 23 };
+		std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+
+		constexpr size_t count{ 8192 };
+		constexpr size_t rounds{ 200 };
+		constexpr size_t width{ float8::size };
+
+		std::vector<mpml::Quaternion<float>> quats(count);
+		std::vector<mpml::Vector3<float>> vecs(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			quats[i] = mpml::Quaternion<float>{ dist(gen), dist(gen), dist(gen), dist(gen) };
+			vecs[i] = mpml::Vector3<float>{ dist(gen), dist(gen), dist(gen) };
+		}
+
+		// Same data, 8 quaternions and vectors per element
+		std::vector<mpml::Quaternion<float8>> wide_quats(count / width);
+		std::vector<mpml::Vector3<float8>> wide_vecs(count / width);
+
+		for (size_t i{}; i < count; i++)
+		{
+			auto& quat{ wide_quats[i / width] };
+			auto& vec{ wide_vecs[i / width] };
+
+			quat.s[i % width] = quats[i].s;
+			quat.x[i % width] = quats[i].x;
+			quat.y[i % width] = quats[i].y;
+			quat.z[i % width] = quats[i].z;
+
+			vec.x[i % width] = vecs[i].x;
+			vec.y[i % width] = vecs[i].y;
+			vec.z[i % width] = vecs[i].z;
+		}
+
+		std::vector<mpml::Vector3<float>> rotated(count);
+		std::vector<mpml::Vector3<float8>> wide_rotated(count / width);
+
+		const auto time{ [&](auto&& op) {
+			const auto start{ std::chrono::steady_clock::now() };
+
+			for (size_t r{}; r < rounds; r++)
+				op();
+
+			const auto end{ std::chrono::steady_clock::now() };
+
+			return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * count);
+		} };
+
+		const double scalar{ time([&] {
+			for (size_t i{}; i < count; i++)
+				rotated[i] = quats[i].normal().rotate_vector(vecs[i]);
+		}) };
+		const double wide{ time([&] {
+			for (size_t i{}; i < count / width; i++)
+				wide_rotated[i] = wide_quats[i].normal().rotate_vector(wide_vecs[i]);
+		}) };
+
+		float max_diff{};
+
+		for (size_t i{}; i < count; i++)
+		{
+			const auto& vec{ wide_rotated[i / width] };
+
+			max_diff = std::max({ max_diff,
+				std::abs(vec.x[i % width] - rotated[i].x),
+				std::abs(vec.y[i % width] - rotated[i].y),
+				std::abs(vec.z[i % width] - rotated[i].z) });
+		}
+
+		report("Quaternion normal + rotate_vector", "float", "Quaternion<float>", scalar);
+		report("Quaternion normal + rotate_vector", "float", "Quaternion<float8>", wide, max_diff);
+	}
+
+	template<typename T>
+	void bench_vector3(const char* type_name)
+	{
+		std::mt19937 gen{ 19 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-100), static_cast<T>(100) };
+
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 2000 };
+
+		std::vector<mpml::Vector3<T>> vecs(count), out(count);
+
+		for (auto& vec : vecs)
+			vec = { dist(gen), dist(gen), dist(gen) };
+
+		const double normal{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				out[i] = vecs[i].normal();
+		}) };
+		const double cross{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				out[i] = vecs[i].cross(vecs[(i + 1) & (count - 1)]);
+		}) };
+
+		volatile T sink{ out[count / 2].x };
+		(void)sink;
+
+		report("Vector3 normal", type_name, "mpml", normal);
+		report("Vector3 cross", type_name, "mpml", cross);
+	}
+
+	template<typename T>
+	void bench_camera(const char* type_name)
+	{
+		std::mt19937 gen{ 29 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-10), static_cast<T>(10) };
+
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 500 };
+
+		std::vector<mpml::Vector3<T>> eyes(count);
+		std::vector<T> aspects(count);
+		std::vector<mpml::Matrix4<T>> out(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			eyes[i] = { dist(gen), dist(gen), dist(gen) };
+			aspects[i] = static_cast<T>(1) + std::abs(dist(gen));
+		}
+
+		const double look_at{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				out[i] = mpml::lookAt<T>(eyes[i], { 0, 0, 0 }, { 0, 1, 0 });
+		}) };
+		const double perspective{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				out[i] = mpml::perspective<T>(mpml::Angle<>::from_degrees(60.f), aspects[i], static_cast<T>(1), static_cast<T>(0.1), static_cast<T>(100));
+		}) };
+
+		volatile T sink{ out[count / 2].a };
+		(void)sink;
+
+		report("lookAt", type_name, "mpml", look_at);
+		report("perspective", type_name, "mpml", perspective);
+	}
+
+	// translate/scale/rotate against multiplying by the full transform matrix, max_diff is the largest element difference
+	template<typename T>
+	void bench_model_transforms(const char* type_name)
+	{
+		std::mt19937 gen{ 31 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1), static_cast<T>(1) };
+
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 1000 };
+
+		std::vector<mpml::Matrix4<T>> mats(count), full(count), structured(count);
+		std::vector<mpml::Vector3<T>> vecs(count), undo(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			for (T& value : mats[i].data)
+				value = dist(gen);
+
+			vecs[i] = { dist(gen), dist(gen), dist(gen) };
+		}
+
+		const mpml::Quaternion<T> rotation{ mpml::Quaternion<T>{ 0, mpml::Vector3<T>{ 1, 2, 3 }.normal() }.rotate(mpml::Angle<>::from_degrees(35.f)) };
+
+		const auto diff{ [&] {
+			double diff_r{};
+
+			for (size_t i{}; i < count; i++)
+				for (size_t j{}; j < 16; j++)
+					diff_r = std::max(diff_r, static_cast<double>(std::abs(full[i].data[j] - structured[i].data[j])));
+
+			return diff_r;
+		} };
+
+		// The in-place rounds work on the same matrices, every other one applies the inverse transform so that the values stay bounded.
+		// Copying mats[i] before each call would time the copy and its store forwarding instead of the transform
+		const auto compare{ [&](const char* name, auto&& make_matrix, auto&& apply, auto&& apply_inplace, auto&& invert) {
+			const double full_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					full[i] = mats[i] * make_matrix(vecs[i]);
+			}) };
+			const double structured_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					structured[i] = apply(mats[i], vecs[i]);
+			}) };
+
+			for (size_t i{}; i < count; i++)
+			{
+				structured[i] = mats[i];
+				undo[i] = invert(vecs[i]);
+			}
+
+			bool forward{ true };
+
+			const double inplace_time{ time_batch(count, rounds, [&] {
+				const std::vector<mpml::Vector3<T>>& args{ forward ? vecs : undo };
+
+				for (size_t i{}; i < count; i++)
+					apply_inplace(structured[i], args[i]);
+
+				forward = !forward;
+			}) };
+
+			for (size_t i{}; i < count; i++)
+			{
+				structured[i] = mats[i];
+				apply_inplace(structured[i], vecs[i]);
+			}
+
+			report(name, type_name, "operator*", full_time);
+			report(name, type_name, "mpml", structured_time, diff());
+			report(name, type_name, "mpml inplace", inplace_time, diff());
+		} };
+
+		compare("Matrix4 translate",
+			[](const mpml::Vector3<T>& vec) { mpml::Matrix4<T> mat_r{ mpml::Matrix4<T>::Identity }; mat_r.m = vec.x; mat_r.n = vec.y; mat_r.o = vec.z; return mat_r; },
+			[](const mpml::Matrix4<T>& mat, const mpml::Vector3<T>& vec) { return mpml::translate(mat, vec); },
+			[](mpml::Matrix4<T>& mat, const mpml::Vector3<T>& vec) { mpml::translate_inplace(mat, vec); },
+			[](const mpml::Vector3<T>& vec) { return -vec; });
+		compare("Matrix4 scale",
+			[](const mpml::Vector3<T>& vec) { mpml::Matrix4<T> mat_r{ mpml::Matrix4<T>::Identity }; mat_r.a = vec.x; mat_r.f = vec.y; mat_r.k = vec.z; return mat_r; },
+			[](const mpml::Matrix4<T>& mat, const mpml::Vector3<T>& vec) { return mpml::scale(mat, vec); },
+			[](mpml::Matrix4<T>& mat, const mpml::Vector3<T>& vec) { mpml::scale_inplace(mat, vec); },
+			[](const mpml::Vector3<T>& vec) { return mpml::Vector3<T>{ 1 / vec.x, 1 / vec.y, 1 / vec.z }; });
+		compare("Matrix4 rotate",
+			[&](const mpml::Vector3<T>&) { return mpml::Matrix4<T>{ mpml::rotation_matrix<T>(rotation) }; },
+			[&](const mpml::Matrix4<T>& mat, const mpml::Vector3<T>&) { return mpml::rotate(mat, rotation); },
+			[&](mpml::Matrix4<T>& mat, const mpml::Vector3<T>&) { mpml::rotate_inplace(mat, rotation); },
+			[](const mpml::Vector3<T>& vec) { return vec; });
+	}
+
+	// Affine3 against Matrix4 on the same affine matrices, max_diff is the largest element difference after conversion
+	template<typename T>
+	void bench_affine3(const char* type_name)
+	{
+		std::mt19937 gen{ 37 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1), static_cast<T>(1) };
+
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 1000 };
+
+		std::vector<mpml::Matrix4<T>> mats(count), mats_out(count);
+		std::vector<mpml::Affine3<T>> affines(count), affines_out(count);
+		std::vector<mpml::Vector3<T>> points(count), mat_points(count), affine_points(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			const mpml::Quaternion<T> rotation{ mpml::Quaternion<T>{ 0, mpml::Vector3<T>{ dist(gen), dist(gen), static_cast<T>(1) }.normal() }.rotate(mpml::Angle<>::from_radians(static_cast<float>(dist(gen)))) };
+
+			mats[i] = mpml::translate(mpml::rotate(mpml::scale(mpml::Matrix4<T>{ mpml::Matrix4<T>::Identity }, static_cast<T>(2) + dist(gen)), rotation), mpml::Vector3<T>{ dist(gen), dist(gen), dist(gen) });
+			affines[i] = mpml::Affine3<T>{ mats[i] };
+			points[i] = { dist(gen), dist(gen), dist(gen) };
+		}
+
+		const auto diff{ [&] {
+			double diff_r{};
+
+			for (size_t i{}; i < count; i++)
+			{
+				const mpml::Matrix4<T> converted{ affines_out[i] };
+
+				for (size_t j{}; j < 16; j++)
+					diff_r = std::max(diff_r, static_cast<double>(std::abs(converted.data[j] - mats_out[i].data[j])));
+			}
+
+			return diff_r;
+		} };
+
+		const double mat_product{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				mats_out[i] = mats[i] * mats[(i + 1) & (count - 1)];
+		}) };
+		const double affine_product{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				affines_out[i] = affines[i] * affines[(i + 1) & (count - 1)];
+		}) };
+		const double product_diff{ diff() };
+
+		const double mat_inverse{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				mats_out[i] = *mats[i].inverse_affine();
+		}) };
+		const double affine_inverse{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				affines_out[i] = *affines[i].inverse();
+		}) };
+		const double inverse_diff{ diff() };
+
+		const double mat_point{ time_batch(count, rounds, [&] {
+			mpml::transform_points(mats[count / 2], std::span<const mpml::Vector3<T>>{ points }, std::span<mpml::Vector3<T>>{ mat_points });
+		}) };
+		const double affine_point{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				affine_points[i] = affines[count / 2].transform_point(points[i]);
+		}) };
+
+		double point_diff{};
+		for (size_t i{}; i < count; i++)
+			point_diff = std::max({ point_diff, static_cast<double>(std::abs(mat_points[i].x - affine_points[i].x)),
+				static_cast<double>(std::abs(mat_points[i].y - affine_points[i].y)), static_cast<double>(std::abs(mat_points[i].z - affine_points[i].z)) });
+
+		report("affine operator*", type_name, "Matrix4", mat_product);
+		report("affine operator*", type_name, "Affine3", affine_product, product_diff);
+		report("affine inverse", type_name, "Matrix4::inverse_affine", mat_inverse);
+		report("affine inverse", type_name, "Affine3::inverse", affine_inverse, inverse_diff);
+		report("affine points", type_name, "transform_points(Matrix4)", mat_point);
+		report("affine points", type_name, "Affine3::transform_point", affine_point, point_diff);
+	}
+
+	// Transform against rebuilding the matrix with translate(rotate(scale(...))), max_diff is the largest element difference
+	template<typename T>
+	void bench_trs(const char* type_name)
+	{
+		std::mt19937 gen{ 41 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1), static_cast<T>(1) };
+
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 1000 };
+
+		std::vector<mpml::Transform<T>> transforms(count);
+		std::vector<mpml::Matrix4<T>> reference(count), out(count);
+
+		for (mpml::Transform<T>& transform : transforms)
+		{
+			transform.set_position({ dist(gen), dist(gen), dist(gen) });
+			transform.set_rotation(mpml::Quaternion<T>{ 0, mpml::Vector3<T>{ dist(gen), dist(gen), static_cast<T>(1) }.normal() }.rotate(mpml::Angle<>::from_radians(static_cast<float>(dist(gen)))));
+			transform.set_scale({ static_cast<T>(2) + dist(gen), static_cast<T>(2) + dist(gen), static_cast<T>(2) + dist(gen) });
+		}
+
+		const auto diff{ [&] {
+			double diff_r{};
+
+			for (size_t i{}; i < count; i++)
+				for (size_t j{}; j < 16; j++)
+					diff_r = std::max(diff_r, static_cast<double>(std::abs(out[i].data[j] - reference[i].data[j])));
+
+			return diff_r;
+		} };
+
+		const double products{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				reference[i] = mpml::translate(mpml::rotate(mpml::scale(mpml::Matrix4<T>{ mpml::Matrix4<T>::Identity }, transforms[i].scale()), transforms[i].rotation()), transforms[i].position());
+		}) };
+		const double compose{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				out[i] = transforms[i].compose();
+		}) };
+		const double compose_diff{ diff() };
+		const double cached{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				out[i] = transforms[i].matrix();
+		}) };
+		const double cached_diff{ diff() };
+
+		const double general_inverse{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				reference[i] = *transforms[i].matrix().inverse_affine();
+		}) };
+		const double trs_inverse{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				out[i] = transforms[i].inverse();
+		}) };
+
+		report("TRS matrix", type_name, "translate(rotate(scale))", products);
+		report("TRS matrix", type_name, "Transform::compose", compose, compose_diff);
+		report("TRS matrix", type_name, "Transform::matrix (cached)", cached, cached_diff);
+		report("TRS inverse", type_name, "Matrix4::inverse_affine", general_inverse);
+		report("TRS inverse", type_name, "Transform::inverse", trs_inverse, diff());
+	}
+
+	// Frustum culling of 500k spheres and boxes spread around the camera, against a per-object loop over AoS data
+	// max_diff is the difference in visible count with the per-object loop
+	template<typename T>
+	void bench_frustum(const char* type_name)
+	{
+		std::mt19937 gen{ 53 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-200), static_cast<T>(200) };
+		std::uniform_real_distribution<T> size_dist{ static_cast<T>(0.1), static_cast<T>(4) };
+
+		constexpr size_t count{ 500'000 };
+		constexpr size_t rounds{ 20 };
+
+		const mpml::Matrix4<T> view{ mpml::lookAt<T>({ 0, 2, 0 }, { 1, 2, -3 }, { 0, 1, 0 }) };
+		const mpml::Matrix4<T> projection{ mpml::perspective<T>(mpml::Angle<>::from_degrees(70.f), static_cast<T>(16), static_cast<T>(9), static_cast<T>(0.1), static_cast<T>(150)) };
+		const mpml::Frustum<T> frustum{ view * projection };
+
+		struct Sphere
+		{
+			mpml::Vector3<T> center;
+			T radius;
+		};
+
+		struct Box
+		{
+			mpml::Vector3<T> min;
+			mpml::Vector3<T> max;
+		};
+
+		std::vector<Sphere> spheres(count);
+		std::vector<Box> boxes(count);
+
+		mpml::Vec3SoA<T> centers(count), mins(count), maxs(count);
+		std::vector<T> radii(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			const mpml::Vector3<T> center{ dist(gen), dist(gen), dist(gen) };
+			const mpml::Vector3<T> extent{ size_dist(gen), size_dist(gen), size_dist(gen) };
+
+			spheres[i] = { center, extent.length() };
+			boxes[i] = { center - extent, center + extent };
+
+			centers.set(i, center);
+			radii[i] = spheres[i].radius;
+			mins.set(i, boxes[i].min);
+			maxs.set(i, boxes[i].max);
+		}
+
+		std::vector<std::uint32_t> visible(count);
+		size_t loop_count{}, batch_count{};
+
+		// What a renderer writes by hand: every object against every plane, early out on the first one it is behind
+		const auto sphere_loop{ [&] {
+			loop_count = 0;
+
+			for (size_t i{}; i < count; i++)
+			{
+				bool inside{ true };
+
+				for (const mpml::Vector4<T>& plane : frustum.planes())
+					inside = inside && plane.x * spheres[i].center.x + plane.y * spheres[i].center.y + plane.z * spheres[i].center.z + plane.w >= -spheres[i].radius;
+
+				if (inside)
+					visible[loop_count++] = static_cast<std::uint32_t>(i);
+			}
+		} };
+
+		const auto box_loop{ [&] {
+			loop_count = 0;
+
+			for (size_t i{}; i < count; i++)
+			{
+				if (frustum.intersects_aabb(boxes[i].min, boxes[i].max))
+					visible[loop_count++] = static_cast<std::uint32_t>(i);
+			}
+		} };
+
+		const double sphere_single{ time_batch(count, rounds, sphere_loop) };
+		const size_t sphere_expected{ loop_count };
+		const double sphere_batch{ time_batch(count, rounds, [&] { batch_count = frustum.cull_spheres(centers, radii, visible); }) };
+		const double sphere_diff{ static_cast<double>(batch_count) - static_cast<double>(sphere_expected) };
+
+		const double box_single{ time_batch(count, rounds, box_loop) };
+		const size_t box_expected{ loop_count };
+		const double box_batch{ time_batch(count, rounds, [&] { batch_count = frustum.cull_aabbs(mins, maxs, visible); }) };
+		const double box_diff{ static_cast<double>(batch_count) - static_cast<double>(box_expected) };
+
+		report("frustum spheres 500k", type_name, "per-object loop (AoS)", sphere_single);
+		report("frustum spheres 500k", type_name, "Frustum::cull_spheres (SoA)", sphere_batch, std::abs(sphere_diff));
+		report("frustum aabbs 500k", type_name, "per-object loop (AoS)", box_single);
+		report("frustum aabbs 500k", type_name, "Frustum::cull_aabbs (SoA)", box_batch, std::abs(box_diff));
+	}
+
+	// Ray-box slab tests: a textbook test dividing by the direction and exiting early, Ray::intersect,
+	// and the two packet forms; ns_per_op is per ray-box pair, max_diff counts the pairs disagreeing with Ray::intersect
+	template<typename T>
+	void bench_ray_aabb(const char* type_name)
+	{
+		std::mt19937 gen{ 59 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-10), static_cast<T>(10) };
+		std::uniform_real_distribution<T> size_dist{ static_cast<T>(0.5), static_cast<T>(3) };
+
+		constexpr size_t packets{ 4096 };
+		constexpr size_t count{ packets * 8 };
+		constexpr size_t rounds{ 100 };
+
+		std::vector<mpml::Ray<T>> rays(count);
+		std::vector<mpml::AABB<T>> boxes(count);
+		std::vector<mpml::RayPacket<T>> ray_packets(packets);
+		std::vector<mpml::AABBPacket<T>> box_packets(packets);
+
+		for (size_t i{}; i < count; i++)
+		{
+			const mpml::Vector3<T> center{ dist(gen), dist(gen), dist(gen) };
+			const mpml::Vector3<T> half{ size_dist(gen), size_dist(gen), size_dist(gen) };
+
+			boxes[i] = mpml::AABB<T>{ center - half, center + half };
+			rays[i] = mpml::Ray<T>{ { dist(gen), dist(gen), dist(gen) }, { dist(gen), dist(gen), dist(gen) } };
+
+			ray_packets[i / 8].set(i % 8, rays[i]);
+			box_packets[i / 8].set(i % 8, boxes[i]);
+		}
+
+		const auto textbook{ [](const mpml::Vector3<T>& origin, const mpml::Vector3<T>& direction, const mpml::AABB<T>& box) {
+			T enter{}, exit{ std::numeric_limits<T>::infinity() };
+
+			for (size_t axis{}; axis < 3; axis++)
+			{
+				T t1{ (box.min[axis] - origin[axis]) / direction[axis] };
+				T t2{ (box.max[axis] - origin[axis]) / direction[axis] };
+
+				if (t1 > t2)
+					std::swap(t1, t2);
+
+				enter = std::max(enter, t1);
+				exit = std::min(exit, t2);
+
+				if (enter > exit)
+					return false;
+			}
+
+			return true;
+		} };
+
+		// Ray i against boxes i & ~7 .. (i & ~7) + 7, so that every form tests the same pairs
+		std::vector<unsigned> single_hits(count), textbook_hits(count), box_packet_hits(count), ray_packet_hits(count);
+
+		const double textbook_time{ time_batch(count * 8, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+			{
+				unsigned mask{};
+
+				for (size_t k{}; k < 8; k++)
+					mask |= static_cast<unsigned>(textbook(rays[i].origin(), rays[i].direction(), boxes[(i & ~size_t{ 7 }) + k])) << k;
+
+				textbook_hits[i] = mask;
+			}
+		}) };
+
+		const double single_time{ time_batch(count * 8, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+			{
+				unsigned mask{};
+
+				for (size_t k{}; k < 8; k++)
+					mask |= static_cast<unsigned>(rays[i].intersect(boxes[(i & ~size_t{ 7 }) + k]).has_value()) << k;
+
+				single_hits[i] = mask;
+			}
+		}) };
+
+		const double box_packet_time{ time_batch(count * 8, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				box_packet_hits[i] = rays[i].intersect(box_packets[i / 8]).mask;
+		}) };
+
+		// Transposed: box j against rays j & ~7 .. (j & ~7) + 7, bit k of ray i's mask is bit (i % 8) of box ((i & ~7) + k)'s
+		std::vector<unsigned> per_box(count);
+
+		const double ray_packet_time{ time_batch(count * 8, rounds, [&] {
+			for (size_t j{}; j < count; j++)
+				per_box[j] = ray_packets[j / 8].intersect(boxes[j]).mask;
+		}) };
+
+		for (size_t i{}; i < count; i++)
+		{
+			unsigned mask{};
+
+			for (size_t k{}; k < 8; k++)
+				mask |= ((per_box[(i & ~size_t{ 7 }) + k] >> (i % 8)) & 1u) << k;
+
+			ray_packet_hits[i] = mask;
+		}
+
+		const auto mismatches{ [&](const std::vector<unsigned>& hits) {
+			double diff_r{};
+
+			for (size_t i{}; i < count; i++)
+				diff_r += std::popcount(hits[i] ^ single_hits[i]);
+
+			return diff_r;
+		} };
+
+		report("ray vs aabb", type_name, "textbook slab (divide, early out)", textbook_time, mismatches(textbook_hits));
+		report("ray vs aabb", type_name, "Ray::intersect(AABB)", single_time);
+		report("ray vs aabb", type_name, "Ray::intersect(AABBPacket), 1 ray x 8 boxes", box_packet_time, mismatches(box_packet_hits));
+		report("ray vs aabb", type_name, "RayPacket::intersect(AABB), 8 rays x 1 box", ray_packet_time, mismatches(ray_packet_hits));
+	}
+
+	// BVH over random boxes in a 2000^3 region: builds (ns per build, ops_per_sec = builds/s), closest hits (rays/s),
+	// overlap and frustum queries and refits; max_diff counts the rays whose closest hit differs from a brute-force search
+	void bench_bvh()
+	{
+		const size_t hardware_threads{ std::max<size_t>(std::thread::hardware_concurrency(), 1) };
+
+		for (const size_t count : { size_t{ 100'000 }, size_t{ 500'000 } })
+		{
+			std::mt19937 gen{ 61 };
+			std::uniform_real_distribution<float> dist{ -1000.f, 1000.f };
+			std::uniform_real_distribution<float> size_dist{ 0.5f, 5.f };
+
+			// Appended piece by piece, " " + std::string trips a false -Wrestrict in GCC 12 at -O3
+			std::string suffix{ " " };
+			suffix += std::to_string(count / 1000);
+			suffix += 'k';
+
+			std::vector<mpml::AABB<float>> boxes(count);
+
+			for (mpml::AABB<float>& box : boxes)
+			{
+				const mpml::Vector3<float> center{ dist(gen), dist(gen), dist(gen) };
+				const mpml::Vector3<float> half{ size_dist(gen), size_dist(gen), size_dist(gen) };
+
+				box = mpml::AABB<float>{ center - half, center + half };
+			}
+
+			const size_t build_rounds{ count > 100'000 ? size_t{ 2 } : size_t{ 5 } };
+
+			std::optional<mpml::BVH<float>> bvh;
+
+			const auto bench_build{ [&](size_t threads) {
+				const double time{ time_batch(1, build_rounds, [&] { bvh.emplace(boxes, threads); }) };
+				report("bvh build" + suffix, "float", "binned SAH, threads=" + std::to_string(threads), time);
+			} };
+
+			bench_build(1);
+
+			if (hardware_threads > 1)
+				bench_build(hardware_threads);
+
+			// Rays through the whole region, most of them hit something
+			constexpr size_t ray_count{ 100'000 };
+			constexpr size_t checked_rays{ 64 };
+
+			std::vector<mpml::Ray<float>> rays(ray_count);
+			for (mpml::Ray<float>& ray : rays)
+				ray = mpml::Ray<float>{ { dist(gen), dist(gen), dist(gen) }, { dist(gen), dist(gen), dist(gen) } };
+
+			std::vector<float> distances(ray_count);
+
+			const double ray_time{ time_batch(ray_count, 1, [&] {
+				for (size_t i{}; i < ray_count; i++)
+				{
+					const std::optional<mpml::BVHHit<float>> hit{ bvh->closest_hit(rays[i]) };
+					distances[i] = hit ? hit->distance : -1.f;
+				}
+			}) };
+
+			double ray_diff{};
+			for (size_t i{}; i < checked_rays; i++)
+			{
+				float nearest{ -1.f };
+
+				for (const mpml::AABB<float>& box : boxes)
+				{
+					const std::optional<float> entry{ rays[i].intersect(box) };
+
+					if (entry && (nearest < 0.f || *entry < nearest))
+						nearest = *entry;
+				}
+
+				ray_diff += nearest != distances[i];
+			}
+
+			const double brute_time{ time_batch(checked_rays, 1, [&] {
+				for (size_t i{}; i < checked_rays; i++)
+				{
+					bool any{};
+
+					for (const mpml::AABB<float>& box : boxes)
+						any = any | rays[i].intersect(box).has_value();
+
+					distances[i] = any;
+				}
+			}) };
+
+			report("bvh closest hit" + suffix, "float", "brute force over every box", brute_time);
+			report("bvh closest hit" + suffix, "float", "BVH::closest_hit", ray_time, ray_diff);
+
+			// 20^3 query boxes and a 90 degree camera looking at the region
+			constexpr size_t query_count{ 10'000 };
+			size_t found{};
+
+			std::vector<mpml::AABB<float>> queries(query_count);
+			for (mpml::AABB<float>& query : queries)
+			{
+				const mpml::Vector3<float> center{ dist(gen), dist(gen), dist(gen) };
+				query = mpml::AABB<float>{ center - mpml::Vector3<float>{ 10.f }, center + mpml::Vector3<float>{ 10.f } };
+			}
+
+			const double overlap_time{ time_batch(query_count, 1, [&] {
+				for (const mpml::AABB<float>& query : queries)
+					bvh->query_overlap(query, [&](std::uint32_t) { found++; });
+			}) };
+
+			const mpml::Frustum<float> frustum{ mpml::lookAt<float>({ 0, 0, 1200 }, { 0, 0, 0 }, { 0, 1, 0 })
+				* mpml::perspective<float>(mpml::Angle<>::from_degrees(40.f), 16.f, 9.f, 1.f, 1500.f) };
+
+			const double frustum_time{ time_batch(1, 10, [&] { bvh->query_frustum(frustum, [&](std::uint32_t) { found++; }); }) };
+
+			// Every box moves a little, as animated bounds would
+			for (mpml::AABB<float>& box : boxes)
+			{
+				const mpml::Vector3<float> move{ size_dist(gen), -size_dist(gen), size_dist(gen) };
+				box = mpml::AABB<float>{ box.min + move, box.max + move };
+			}
+
+			const double refit_time{ time_batch(1, 10, [&] { bvh->refit(boxes); }) };
+
+			volatile size_t sink{ found };
+			(void)sink;
+
+			report("bvh query" + suffix, "float", "query_overlap, per query", overlap_time);
+			report("bvh query" + suffix, "float", "query_frustum, per frustum", frustum_time);
+			report("bvh refit" + suffix, "float", "refit, per tree", refit_time);
+		}
+	}
+
+	// Voxel traversal of 4096 rays over 256 cells each, ns per cell visited (per chunk entered for next_chunk);
+	// max_diff counts the rays whose last cell differs from VoxelRay's
+	template<typename T>
+	void bench_voxel_ray(const char* type_name)
+	{
+		std::mt19937 gen{ 67 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-256), static_cast<T>(256) };
+		std::uniform_real_distribution<T> dir_dist{ static_cast<T>(-1), static_cast<T>(1) };
+
+		constexpr size_t count{ 4096 };
+		constexpr size_t rounds{ 20 };
+		constexpr T max_distance{ 256 };
+		constexpr int chunk_size{ 32 };
+
+		std::vector<mpml::Vector3<T>> origins(count), directions(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			origins[i] = mpml::Vector3<T>{ dist(gen), dist(gen), dist(gen) };
+			const mpml::Vector3<T> direction{ dir_dist(gen), dir_dist(gen), dir_dist(gen) };
+			directions[i] = direction / direction.length();
+		}
+
+		// Amanatides & Woo as written on top of Vector3<T> / Vector3<int>: divisions, branches on the direction and operator[]
+		const auto textbook{ [](const mpml::Vector3<T>& origin, const mpml::Vector3<T>& direction, T max_t, mpml::Vector3<int>& cell_r) {
+			mpml::Vector3<int> cell{ static_cast<int>(std::floor(origin.x)), static_cast<int>(std::floor(origin.y)), static_cast<int>(std::floor(origin.z)) };
+			mpml::Vector3<int> step{};
+			mpml::Vector3<T> t_max{}, t_delta{};
+
+			for (size_t axis{}; axis < 3; axis++)
+			{
+				if (direction[axis] > T{})
+				{
+					step[axis] = 1;
+					t_max[axis] = (static_cast<T>(cell[axis] + 1) - origin[axis]) / direction[axis];
+					t_delta[axis] = T{ 1 } / direction[axis];
+				}
+				else if (direction[axis] < T{})
+				{
+					step[axis] = -1;
+					t_max[axis] = (static_cast<T>(cell[axis]) - origin[axis]) / direction[axis];
+					t_delta[axis] = -T{ 1 } / direction[axis];
+				}
+				else
+				{
+					t_max[axis] = std::numeric_limits<T>::infinity();
+					t_delta[axis] = std::numeric_limits<T>::infinity();
+				}
+			}
+
+			size_t visited{ 1 };
+
+			while (true)
+			{
+				size_t axis{};
+
+				if (t_max.x <= t_max.y)
+					axis = t_max.x <= t_max.z ? 0 : 2;
+				else
+					axis = t_max.y <= t_max.z ? 1 : 2;
+
+				if (t_max[axis] > max_t)
+					break;
+
+				cell[axis] += step[axis];
+				t_max[axis] += t_delta[axis];
+				visited++;
+			}
+
+			cell_r = cell;
+			return visited;
+		} };
+
+		std::vector<mpml::Vector3<int>> reference(count), textbook_cells(count), packet_cells(count);
+
+		size_t cells{};
+		for (size_t i{}; i < count; i++)
+			cells += textbook(origins[i], directions[i], max_distance, textbook_cells[i]);
+
+		const double textbook_time{ time_batch(cells, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				(void)textbook(origins[i], directions[i], max_distance, textbook_cells[i]);
+		}) };
+
+		size_t visited{};
+
+		const double single_time{ time_batch(cells, rounds, [&] {
+			visited = 0;
+
+			for (size_t i{}; i < count; i++)
+			{
+				mpml::VoxelRay<T> ray{ origins[i], directions[i], max_distance };
+				mpml::Vector3<int> last{};
+
+				for (const mpml::VoxelRay<T>& voxel : ray)
+				{
+					last = voxel.cell();
+					visited++;
+				}
+
+				reference[i] = last;
+			}
+		}) };
+
+		int index_sum{};
+
+		const double chunked_time{ time_batch(cells, rounds, [&] {
+			index_sum = 0;
+
+			for (size_t i{}; i < count; i++)
+			{
+				mpml::ChunkedVoxelRay<T> ray{ mpml::VoxelRay<T>{ origins[i], directions[i], max_distance }, chunk_size };
+
+				do
+					index_sum += ray.index();
+				while (ray.next());
+			}
+		}) };
+
+		size_t chunks{};
+
+		for (size_t i{}; i < count; i++)
+		{
+			mpml::ChunkedVoxelRay<T> ray{ mpml::VoxelRay<T>{ origins[i], directions[i], max_distance }, chunk_size };
+
+			while (ray.next_chunk())
+				chunks++;
+		}
+
+		const double skip_time{ time_batch(chunks, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+			{
+				mpml::ChunkedVoxelRay<T> ray{ mpml::VoxelRay<T>{ origins[i], directions[i], max_distance }, chunk_size };
+
+				while (ray.next_chunk())
+					index_sum += ray.index();
+			}
+		}) };
+
+		// Packets hold 8 rays whose lanes finish one after the other, the steps of finished lanes are counted as wasted
+		const double packet_time{ time_batch(cells, rounds, [&] {
+			for (size_t i{}; i < count; i += 8)
+			{
+				mpml::VoxelRayPacket<T> packet;
+
+				for (size_t k{}; k < 8; k++)
+					packet.set(k, mpml::VoxelRay<T>{ origins[i + k], directions[i + k], max_distance });
+
+				unsigned lanes{ packet.lanes() };
+
+				while (lanes != 0)
+				{
+					for (unsigned going{ lanes }; going != 0; going &= going - 1)
+						packet_cells[i + static_cast<size_t>(std::countr_zero(going))] = packet.cell(static_cast<size_t>(std::countr_zero(going)));
+
+					lanes = packet.next();
+				}
+			}
+		}) };
+
+		volatile int sink{ index_sum };
+		(void)sink;
+
+		const auto mismatches{ [&](const std::vector<mpml::Vector3<int>>& last_cells) {
+			double diff_r{};
+
+			for (size_t i{}; i < count; i++)
+				diff_r += (last_cells[i].x != reference[i].x || last_cells[i].y != reference[i].y || last_cells[i].z != reference[i].z) ? 1.0 : 0.0;
+
+			return diff_r;
+		} };
+
+		report("voxel ray", type_name, "textbook Amanatides & Woo on Vector3, per cell", textbook_time, mismatches(textbook_cells));
+		report("voxel ray", type_name, "VoxelRay range-for, per cell", single_time, visited == cells ? 0.0 : 1.0);
+		report("voxel ray", type_name, "ChunkedVoxelRay::next, chunk 32, per cell", chunked_time);
+		report("voxel ray", type_name, "ChunkedVoxelRay::next_chunk, chunk 32, per chunk", skip_time);
+		report("voxel ray", type_name, "VoxelRayPacket::next, 8 rays, per cell", packet_time, mismatches(packet_cells));
+	}
+
+	// 128^3 grid of std::uint32_t (8 MB) stored with func::index_map and with Morton codes, ns per cell;
+	// the sweeps and the 6-neighbour stencil sum the cells, max_diff is the difference between the two layouts' sums
+	void bench_morton()
+	{
+		constexpr std::uint32_t side{ 128 };
+		constexpr size_t cell_count{ size_t{ side } * side * side };
+		constexpr size_t rounds{ 5 };
+
+		std::mt19937 gen{ 71 };
+		std::uniform_int_distribution<std::uint32_t> dist{ 0, 1000 };
+
+		std::vector<std::uint32_t> linear(cell_count), morton(cell_count);
+
+		for (std::uint32_t z{}; z < side; z++)
+			for (std::uint32_t y{}; y < side; y++)
+				for (std::uint32_t x{}; x < side; x++)
+				{
+					const std::uint32_t value{ dist(gen) };
+
+					linear[mpml::func::index_map(x, y, z, side)] = value;
+					morton[mpml::func::morton_encode(x, y, z)] = value;
+				}
+
+		const std::uint64_t unit_x{ mpml::func::morton_encode(1u, 0u, 0u) };
+		const std::uint64_t unit_y{ mpml::func::morton_encode(0u, 1u, 0u) };
+		const std::uint64_t unit_z{ mpml::func::morton_encode(0u, 0u, 1u) };
+
+		std::uint64_t linear_sum{}, morton_sum{};
+
+		// Columns along z, the worst order for index_map: every step is side^2 cells away
+		const double linear_column_time{ time_batch(cell_count, rounds, [&] {
+			linear_sum = 0;
+
+			for (std::uint32_t x{}; x < side; x++)
+				for (std::uint32_t y{}; y < side; y++)
+					for (std::uint32_t z{}; z < side; z++)
+						linear_sum += linear[mpml::func::index_map(x, y, z, side)];
+		}) };
+
+		const double morton_column_time{ time_batch(cell_count, rounds, [&] {
+			morton_sum = 0;
+
+			for (std::uint32_t x{}; x < side; x++)
+				for (std::uint32_t y{}; y < side; y++)
+				{
+					std::uint64_t code{ mpml::func::morton_encode(x, y, 0u) };
+
+					for (std::uint32_t z{}; z < side; z++, code = mpml::func::morton_add3(code, unit_z))
+						morton_sum += morton[code];
+				}
+		}) };
+
+		const double column_diff{ static_cast<double>(linear_sum > morton_sum ? linear_sum - morton_sum : morton_sum - linear_sum) };
+
+		// Rows along x, index_map's own order
+		const double linear_row_time{ time_batch(cell_count, rounds, [&] {
+			linear_sum = 0;
+
+			for (std::uint32_t z{}; z < side; z++)
+				for (std::uint32_t y{}; y < side; y++)
+					for (std::uint32_t x{}; x < side; x++)
+						linear_sum += linear[mpml::func::index_map(x, y, z, side)];
+		}) };
+
+		const double morton_row_time{ time_batch(cell_count, rounds, [&] {
+			morton_sum = 0;
+
+			for (std::uint32_t z{}; z < side; z++)
+				for (std::uint32_t y{}; y < side; y++)
+				{
+					std::uint64_t code{ mpml::func::morton_encode(0u, y, z) };
+
+					for (std::uint32_t x{}; x < side; x++, code = mpml::func::morton_add3(code, unit_x))
+						morton_sum += morton[code];
+				}
+		}) };
+
+		const double row_diff{ static_cast<double>(linear_sum > morton_sum ? linear_sum - morton_sum : morton_sum - linear_sum) };
+
+		// Each interior cell with its 6 face neighbours, in the storage order of the layout
+		constexpr size_t interior{ size_t{ side - 2 } * (side - 2) * (side - 2) };
+
+		const double linear_stencil_time{ time_batch(interior, rounds, [&] {
+			linear_sum = 0;
+
+			constexpr size_t stride_y{ side }, stride_z{ size_t{ side } * side };
+
+			for (std::uint32_t z{ 1 }; z < side - 1; z++)
+				for (std::uint32_t y{ 1 }; y < side - 1; y++)
+					for (std::uint32_t x{ 1 }; x < side - 1; x++)
+					{
+						const size_t i{ mpml::func::index_map(size_t{ x }, size_t{ y }, size_t{ z }, size_t{ side }) };
+						linear_sum += linear[i] + linear[i - 1] + linear[i + 1] + linear[i - stride_y] + linear[i + stride_y] + linear[i - stride_z] + linear[i + stride_z];
+					}
+		}) };
+
+		const double morton_stencil_time{ time_batch(interior, rounds, [&] {
+			morton_sum = 0;
+
+			for (std::uint32_t z{ 1 }; z < side - 1; z++)
+				for (std::uint32_t y{ 1 }; y < side - 1; y++)
+				{
+					std::uint64_t code{ mpml::func::morton_encode(1u, y, z) };
+
+					for (std::uint32_t x{ 1 }; x < side - 1; x++, code = mpml::func::morton_add3(code, unit_x))
+					{
+						morton_sum += morton[code]
+							+ morton[mpml::func::morton_sub3(code, unit_x)] + morton[mpml::func::morton_add3(code, unit_x)]
+							+ morton[mpml::func::morton_sub3(code, unit_y)] + morton[mpml::func::morton_add3(code, unit_y)]
+							+ morton[mpml::func::morton_sub3(code, unit_z)] + morton[mpml::func::morton_add3(code, unit_z)];
+					}
+				}
+		}) };
+
+		const double stencil_diff{ static_cast<double>(linear_sum > morton_sum ? linear_sum - morton_sum : morton_sum - linear_sum) };
+
+		report("grid 128^3 column sweep (z inner)", "uint32", "func::index_map layout", linear_column_time);
+		report("grid 128^3 column sweep (z inner)", "uint32", "Morton layout, morton_add3", morton_column_time, column_diff);
+		report("grid 128^3 row sweep (x inner)", "uint32", "func::index_map layout", linear_row_time);
+		report("grid 128^3 row sweep (x inner)", "uint32", "Morton layout, morton_add3", morton_row_time, row_diff);
+		report("grid 128^3 6-neighbour stencil", "uint32", "func::index_map layout", linear_stencil_time);
+		report("grid 128^3 6-neighbour stencil", "uint32", "Morton layout, morton_add3 / morton_sub3", morton_stencil_time, stencil_diff);
+
+		// Index computations alone, over random cells of a 64^3 block
+		constexpr std::uint32_t block{ 64 };
+		constexpr size_t index_count{ size_t{ 1 } << 18 };
+
+		std::uniform_int_distribution<std::uint32_t> cell_dist{ 0, block - 1 };
+		std::vector<mpml::Vector3<std::uint32_t>> cells(index_count);
+
+		for (mpml::Vector3<std::uint32_t>& cell : cells)
+			cell = mpml::Vector3<std::uint32_t>{ cell_dist(gen), cell_dist(gen), cell_dist(gen) };
+
+		std::uint64_t checksum{};
+
+		const auto bench_index{ [&](const char* variant, auto&& index) {
+			const double time{ time_batch(index_count, rounds * 4, [&] {
+				for (const mpml::Vector3<std::uint32_t>& cell : cells)
+					checksum += index(cell.x, cell.y, cell.z);
+			}) };
+
+			report("3D cell index", "uint32", variant, time);
+		} };
+
+		bench_index("func::index_map", [](std::uint32_t x, std::uint32_t y, std::uint32_t z) { return std::uint64_t{ mpml::func::index_map(x, y, z, block) }; });
+		bench_index("func::morton_encode", [](std::uint32_t x, std::uint32_t y, std::uint32_t z) { return mpml::func::morton_encode(x, y, z); });
+		bench_index("portable bit spreading, vectorized by the compiler", [](std::uint32_t x, std::uint32_t y, std::uint32_t z) { return mpml::detail::morton::spread3(x) | (mpml::detail::morton::spread3(y) << 1) | (mpml::detail::morton::spread3(z) << 2); });
+		bench_index("func::hilbert_encode, order 6", [](std::uint32_t x, std::uint32_t y, std::uint32_t z) { return mpml::func::hilbert_encode(x, y, z, 6); });
+
+		volatile std::uint64_t sink{ checksum };
+		(void)sink;
+	}
+
+	// World positions split into chunk coordinates and local cells, chunks of 16^3, about half of the positions negative
+	void bench_chunk_split()
+	{
+		constexpr size_t count{ size_t{ 1 } << 20 };
+		constexpr size_t rounds{ 10 };
+
+		// Read at run time so that the divisions are not turned into shifts at compile time
+		volatile unsigned shift_source{ 4 };
+		const unsigned shift{ shift_source };
+		const std::int32_t size{ std::int32_t{ 1 } << shift };
+
+		std::mt19937 gen{ 79 };
+		std::uniform_real_distribution<float> dist{ -10000.f, 10000.f };
+
+		std::vector<mpml::Vector3<float>> positions(count);
+
+		for (mpml::Vector3<float>& position : positions)
+			position = mpml::Vector3<float>{ dist(gen), dist(gen), dist(gen) };
+
+		std::vector<mpml::Vector3<std::int32_t>> reference_chunks(count), reference_locals(count), chunks(count), locals(count);
+
+		const auto mismatches{ [&] {
+			size_t count_r{};
+
+			for (size_t i{}; i < count; i++)
+				count_r += !(chunks[i] == reference_chunks[i]) || !(locals[i] == reference_locals[i]);
+
+			return static_cast<double>(count_r);
+		} };
+
+		// std::floor, then / and % corrected for the negative cells
+		const double textbook_time{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+			{
+				const mpml::Vector3<float>& position{ positions[i] };
+
+				for (size_t axis{}; axis < 3; axis++)
+				{
+					const std::int32_t cell{ static_cast<std::int32_t>(std::floor(position[axis])) };
+					std::int32_t chunk{ cell / size }, local{ cell % size };
+
+					if (local < 0)
+					{
+						chunk--;
+						local += size;
+					}
+
+					reference_chunks[i][axis] = chunk;
+					reference_locals[i][axis] = local;
+				}
+			}
+		}) };
+
+		const double vector_time{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+			{
+				const mpml::Vector3<std::int32_t> cell{ mpml::floor_to_int(positions[i]) };
+
+				chunks[i] = mpml::floor_div_pow2(cell, shift);
+				locals[i] = mpml::mod_pow2(cell, shift);
+			}
+		}) };
+
+		const double vector_diff{ mismatches() };
+
+		std::fill(chunks.begin(), chunks.end(), mpml::Vector3<std::int32_t>{});
+		std::fill(locals.begin(), locals.end(), mpml::Vector3<std::int32_t>{});
+
+		const double batch_time{ time_batch(count, rounds, [&] {
+			mpml::func::split_pow2(positions, shift, chunks, locals);
+		}) };
+
+		const double batch_diff{ mismatches() };
+
+		report("chunk / local split of 2^20 positions", "float -> int32", "std::floor, / and % with the sign fix-up", textbook_time);
+		report("chunk / local split of 2^20 positions", "float -> int32", "floor_to_int, floor_div_pow2, mod_pow2 per Vector3", vector_time, vector_diff);
+		report("chunk / local split of 2^20 positions", "float -> int32", "func::split_pow2 batch", batch_time, batch_diff);
+	}
+
+	// Scene graph with one heap allocation per node, updated depth-first through child pointers
+	struct PointerNode
+	{
+		mpml::Matrix4<float> local{ mpml::Matrix4<float>::Identity };
+		mpml::Matrix4<float> world{ mpml::Matrix4<float>::Identity };
+		std::vector<PointerNode*> children;
+	};
+
+	void update_pointer_node(PointerNode& node, const mpml::Matrix4<float>& parent_world) noexcept
+	{
+		node.world = node.local * parent_world;
+
+		for (PointerNode* child : node.children)
+			update_pointer_node(*child, node.world);
+	}
+
+	// TransformHierarchy against the pointer scene graph on random trees (parent drawn among the previous nodes, ids shuffled)
+	// Every round sets the local matrix of every node, or of 1% of them, then updates; max_diff is against the pointer graph
+	void bench_hierarchy()
+	{
+		const size_t hardware_threads{ std::max<size_t>(std::thread::hardware_concurrency(), 1) };
+
+		for (const size_t count : { size_t{ 10'000 }, size_t{ 100'000 }, size_t{ 1'000'000 } })
+		{
+			std::mt19937 gen{ 47 };
+			std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+
+			const size_t rounds{ std::max<size_t>(2'000'000 / count, 3) };
+			const std::string name{ "hierarchy update " + std::to_string(count / 1000) + "k" };
+
+			// Node i of the generation order is node ids[i], its parent comes earlier in that order
+			std::vector<std::uint32_t> ids(count);
+			for (size_t i{}; i < count; i++)
+				ids[i] = static_cast<std::uint32_t>(i);
+			std::shuffle(ids.begin(), ids.end(), gen);
+
+			std::vector<std::uint32_t> parents(count, mpml::TransformHierarchy<mpml::Affine3<float>>::no_parent);
+			for (size_t i{ 1 }; i < count; i++)
+			{
+				if (gen() % 1000 != 0)
+					parents[ids[i]] = ids[gen() % i];
+			}
+
+			std::vector<mpml::Matrix4<float>> locals(count);
+			for (mpml::Matrix4<float>& local : locals)
+			{
+				const mpml::Quaternion<float> rotation{ mpml::Quaternion<float>{ 0, mpml::Vector3<float>{ dist(gen), dist(gen), 1.f }.normal() }.rotate(mpml::Angle<>::from_radians(dist(gen))) };
+				local = mpml::translate(mpml::rotate(mpml::Matrix4<float>{ mpml::Matrix4<float>::Identity }, rotation), mpml::Vector3<float>{ dist(gen), dist(gen), dist(gen) });
+			}
+
+			std::vector<std::uint32_t> partial(count / 100);
+			for (std::uint32_t& node : partial)
+				node = static_cast<std::uint32_t>(gen() % count);
+
+			// Pointer graph, allocated in id order
+			std::vector<std::unique_ptr<PointerNode>> nodes(count);
+			std::vector<PointerNode*> roots;
+
+			for (std::unique_ptr<PointerNode>& node : nodes)
+				node = std::make_unique<PointerNode>();
+
+			for (size_t i{}; i < count; i++)
+			{
+				if (parents[i] == mpml::TransformHierarchy<mpml::Affine3<float>>::no_parent)
+					roots.push_back(nodes[i].get());
+				else
+					nodes[parents[i]]->children.push_back(nodes[i].get());
+			}
+
+			const double pointer_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					nodes[i]->local = locals[i];
+
+				for (PointerNode* root : roots)
+					update_pointer_node(*root, mpml::Matrix4<float>::Identity);
+			}) };
+
+			report(name, "float", "pointer graph (Matrix4)", pointer_time);
+
+			const auto bench_flat{ [&]<typename M>(mpml::TransformHierarchy<M>& hierarchy, const char* variant, size_t threads) {
+				const double full_time{ time_batch(count, rounds, [&] {
+					for (size_t i{}; i < count; i++)
+						hierarchy.set_local(static_cast<std::uint32_t>(i), M{ locals[i] });
+
+					hierarchy.update(threads);
+				}) };
+
+				double diff_r{};
+				for (size_t i{}; i < count; i++)
+				{
+					const mpml::Matrix4<float> world{ hierarchy.world(static_cast<std::uint32_t>(i)) };
+
+					for (size_t j{}; j < 16; j++)
+						diff_r = std::max(diff_r, static_cast<double>(std::abs(world.data[j] - nodes[i]->world.data[j])));
+				}
+
+				const double partial_time{ time_batch(count, rounds, [&] {
+					for (const std::uint32_t node : partial)
+						hierarchy.set_local(node, M{ locals[node] });
+
+					hierarchy.update(threads);
+				}) };
+
+				report(name, "float", variant + std::string{ ", threads=" } + std::to_string(threads), full_time, diff_r);
+				report(name, "float", variant + std::string{ " 1% dirty, threads=" } + std::to_string(threads), partial_time);
+			} };
+
+			mpml::TransformHierarchy<mpml::Matrix4<float>> matrices{ parents };
+			mpml::TransformHierarchy<mpml::Affine3<float>> affines{ parents };
+
+			bench_flat(matrices, "TransformHierarchy<Matrix4>", 1);
+			bench_flat(affines, "TransformHierarchy<Affine3>", 1);
+
+			if (hardware_threads > 1)
+			{
+				bench_flat(matrices, "TransformHierarchy<Matrix4>", hardware_threads);
+				bench_flat(affines, "TransformHierarchy<Affine3>", hardware_threads);
+			}
+		}
+	}
+
+	// func::sin/cos/tan/sincos against the standard library over [-10, 10] rad
+	template<typename T>
+	void bench_trigo(const char* type_name)
+	{
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 200 };
+
+		std::vector<T> xs(count), out(count), reference(count);
+
+		for (size_t i{}; i < count; i++)
+			xs[i] = static_cast<T>(-10) + static_cast<T>(20) * static_cast<T>(i) / static_cast<T>(count - 1);
+
+		const auto run{ [&](const char* name, auto&& mpml_op, auto&& std_op) {
+			const double std_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					reference[i] = std_op(xs[i]);
+			}) };
+			const double mpml_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					out[i] = mpml_op(mpml::Angle<T>::from_radians(xs[i]));
+			}) };
+
+			// Relative past 1, so that tan near its poles stays comparable
+			T max_diff{};
+
+			for (size_t i{}; i < count; i++)
+				max_diff = std::max(max_diff, std::abs(out[i] - reference[i]) / std::max(static_cast<T>(1), std::abs(reference[i])));
+
+			report(name, type_name, "std", std_time);
+			report(name, type_name, "mpml::func", mpml_time, static_cast<double>(max_diff));
+		} };
+
+		run("sin", [](const auto& angle) { return mpml::func::sin(angle); }, [](T x) { return std::sin(x); });
+		run("cos", [](const auto& angle) { return mpml::func::cos(angle); }, [](T x) { return std::cos(x); });
+		run("tan", [](const auto& angle) { return mpml::func::tan(angle); }, [](T x) { return std::tan(x); });
+		run("sin + cos", [](const auto& angle) { const auto [sin, cos]{ mpml::func::sincos(angle) }; return sin + cos; }, [](T x) { return std::sin(x) + std::cos(x); });
+	}
+
+	template<typename T>
+	void bench_batch_math(const char* type_name)
+	{
+		std::mt19937 gen{ 37 };
+
+		constexpr size_t count{ 4096 };
+		constexpr size_t rounds{ 200 };
+
+		const auto fill{ [&](T low, T high) {
+			std::uniform_real_distribution<T> dist{ low, high };
+			std::vector<T> values(count);
+
+			for (T& value : values)
+				value = dist(gen);
+
+			return values;
+		} };
+
+		const std::vector<T> angles{ fill(static_cast<T>(-10), static_cast<T>(10)) };
+		const std::vector<T> unit{ fill(static_cast<T>(-1), static_cast<T>(1)) };
+		const std::vector<T> wide{ fill(static_cast<T>(-50), static_cast<T>(50)) };
+		const std::vector<T> positive{ fill(static_cast<T>(0.001), static_cast<T>(1000)) };
+		const std::vector<T> exponents{ fill(static_cast<T>(-4), static_cast<T>(4)) };
+
+		std::vector<T> out(count), reference(count);
+
+		// Relative past 1, as in bench_trigo
+		const auto max_diff{ [&] {
+			T diff{};
+
+			for (size_t i{}; i < count; i++)
+				diff = std::max(diff, std::abs(out[i] - reference[i]) / std::max(static_cast<T>(1), std::abs(reference[i])));
+
+			return static_cast<double>(diff);
+		} };
+
+		// batch_op(out, precision) runs the whole array, std_op(i) a single element
+		const auto run{ [&](const char* name, auto&& batch_op, auto&& std_op) {
+			const double std_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					reference[i] = std_op(i);
+			}) };
+
+			report(name, type_name, "std", std_time);
+
+			for (const auto& [variant, precision] : { std::pair{ "mpml::func standard", mpml::func::Precision::standard }, std::pair{ "mpml::func fast", mpml::func::Precision::fast } })
+			{
+				const double time{ time_batch(count, rounds, [&] { batch_op(std::span<T>{ out }, precision); }) };
+				report(name, type_name, variant, time, max_diff());
+			}
+		} };
+
+		run("batch sin", [&](auto o, auto p) { mpml::func::sin(angles, o, p); }, [&](size_t i) { return std::sin(angles[i]); });
+		run("batch cos", [&](auto o, auto p) { mpml::func::cos(angles, o, p); }, [&](size_t i) { return std::cos(angles[i]); });
+		run("batch tan", [&](auto o, auto p) { mpml::func::tan(angles, o, p); }, [&](size_t i) { return std::tan(angles[i]); });
+		run("batch asin", [&](auto o, auto p) { mpml::func::asin(unit, o, p); }, [&](size_t i) { return std::asin(unit[i]); });
+		run("batch acos", [&](auto o, auto p) { mpml::func::acos(unit, o, p); }, [&](size_t i) { return std::acos(unit[i]); });
+		run("batch atan", [&](auto o, auto p) { mpml::func::atan(wide, o, p); }, [&](size_t i) { return std::atan(wide[i]); });
+		run("batch atan2", [&](auto o, auto p) { mpml::func::atan2(angles, wide, o, p); }, [&](size_t i) { return std::atan2(angles[i], wide[i]); });
+		run("batch exp", [&](auto o, auto p) { mpml::func::exp(wide, o, p); }, [&](size_t i) { return std::exp(wide[i]); });
+		run("batch log", [&](auto o, auto p) { mpml::func::log(positive, o, p); }, [&](size_t i) { return std::log(positive[i]); });
+		run("batch pow", [&](auto o, auto p) { mpml::func::pow(positive, exponents, o, p); }, [&](size_t i) { return std::pow(positive[i], exponents[i]); });
+
+		// Vector3::angle per element against angle_between
+		std::vector<mpml::Vector3<T>> a(count), b(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			a[i] = { angles[i], unit[i], wide[i] };
+			b[i] = { wide[i], angles[i], exponents[i] };
+		}
+
+		const double std_time{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				reference[i] = static_cast<T>(a[i].angle(b[i]).as_radians());
+		}) };
+
+		report("angle_between", type_name, "Vector3::angle", std_time);
+
+		for (const auto& [variant, precision] : { std::pair{ "mpml::func standard", mpml::func::Precision::standard }, std::pair{ "mpml::func fast", mpml::func::Precision::fast } })
+		{
+			const double time{ time_batch(count, rounds, [&] { mpml::func::angle_between(a, b, out, precision); }) };
+			report("angle_between", type_name, variant, time, max_diff());
+		}
+	}
+
+	// Exact member functions against mpml::fast, max_diff is the largest component difference
+	template<typename T>
+	void bench_fast(const char* type_name)
+	{
+		std::mt19937 gen{ 41 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-100), static_cast<T>(100) };
+
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 2000 };
+
+		std::vector<mpml::Vector3<T>> vecs(count), exact(count), fast(count);
+		std::vector<mpml::Vector4<T>> vecs4(count), exact4(count), fast4(count);
+		std::vector<mpml::Quaternion<T>> quats(count), exact_q(count), fast_q(count);
+		std::vector<T> exact_len(count), fast_len(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			vecs[i] = { dist(gen), dist(gen), dist(gen) };
+			vecs4[i] = { dist(gen), dist(gen), dist(gen) };
+			quats[i] = { dist(gen), dist(gen), dist(gen), dist(gen) };
+		}
+
+		const auto diff{ [](const auto& a, const auto& b) {
+			double diff_r{};
+
+			for (size_t i{}; i < a.size(); i++)
+			{
+				if constexpr (requires { a[i].s; })
+					diff_r = std::max({ diff_r, static_cast<double>(std::abs(a[i].s - b[i].s)), static_cast<double>(std::abs(a[i].x - b[i].x)),
+						static_cast<double>(std::abs(a[i].y - b[i].y)), static_cast<double>(std::abs(a[i].z - b[i].z)) });
+				else if constexpr (requires { a[i].x; })
+					diff_r = std::max({ diff_r, static_cast<double>(std::abs(a[i].x - b[i].x)),
+						static_cast<double>(std::abs(a[i].y - b[i].y)), static_cast<double>(std::abs(a[i].z - b[i].z)) });
+				else
+					diff_r = std::max(diff_r, static_cast<double>(std::abs(a[i] - b[i]) / std::max(static_cast<T>(1), std::abs(b[i]))));
+			}
+
+			return diff_r;
+		} };
+
+		const auto run{ [&](const char* name, auto& exact_out, auto& fast_out, auto&& exact_op, auto&& fast_op) {
+			const double exact_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					exact_out[i] = exact_op(i);
+			}) };
+			const double fast_time{ time_batch(count, rounds, [&] {
+				for (size_t i{}; i < count; i++)
+					fast_out[i] = fast_op(i);
+			}) };
+
+			report(name, type_name, "mpml", exact_time);
+			report(name, type_name, "mpml::fast", fast_time, diff(fast_out, exact_out));
+		} };
+
+		run("Vector3 length", exact_len, fast_len, [&](size_t i) { return vecs[i].length(); }, [&](size_t i) { return mpml::fast::length(vecs[i]); });
+		run("Vector3 normal", exact, fast, [&](size_t i) { return vecs[i].normal(); }, [&](size_t i) { return mpml::fast::normal(vecs[i]); });
+		run("Vector4 normal", exact4, fast4, [&](size_t i) { return vecs4[i].normal(); }, [&](size_t i) { return mpml::fast::normal(vecs4[i]); });
+		run("Quaternion normal", exact_q, fast_q, [&](size_t i) { return quats[i].normal(); }, [&](size_t i) { return mpml::fast::normal(quats[i]); });
+
+		// In place over the whole array, normalizing unit vectors again costs the same
+		fast = vecs;
+
+		const double span_time{ time_batch(count, rounds, [&] { mpml::fast::normalize(std::span{ fast }); }) };
+
+		fast = vecs;
+		mpml::fast::normalize(std::span{ fast });
+
+		report("Vector3 array normalize", type_name, "mpml::fast", span_time, diff(fast, exact));
+
+		mpml::VecSoA<T, 3> soa{ vecs }, soa_fast{ vecs };
+
+		const double soa_time{ time_batch(count, rounds, [&] { soa.normalize(); }) };
+		const double soa_fast_time{ time_batch(count, rounds, [&] { mpml::fast::normalize(soa_fast); }) };
+
+		soa_fast = mpml::VecSoA<T, 3>{ vecs };
+		mpml::fast::normalize(soa_fast);
+
+		for (size_t i{}; i < count; i++)
+			fast[i] = { soa_fast.component(0)[i], soa_fast.component(1)[i], soa_fast.component(2)[i] };
+
+		report("Vec3SoA normalize", type_name, "mpml", soa_time);
+		report("Vec3SoA normalize", type_name, "mpml::fast", soa_fast_time, diff(fast, exact));
+	}
+
+	// Eager operators against the same chains built with expr::lazy()
+	template<typename T>
+	void bench_expression(const char* type_name)
+	{
+		std::mt19937 gen{ 43 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1), static_cast<T>(1) };
+
+		constexpr size_t count{ 1024 };
+		constexpr size_t rounds{ 2000 };
+
+		std::vector<mpml::Vector3<T>> a(count), b(count), c(count), eager(count), lazy(count);
+		std::vector<mpml::Matrix4<T>> mats(count);
+		std::vector<mpml::Vector4<T>> points(count), eager4(count), lazy4(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			a[i] = { dist(gen), dist(gen), dist(gen) };
+			b[i] = { dist(gen), dist(gen), dist(gen) };
+			c[i] = { dist(gen), dist(gen), dist(gen) };
+			points[i] = { dist(gen), dist(gen), dist(gen), dist(gen) };
+
+			for (T& value : mats[i].data)
+				value = dist(gen);
+		}
+
+		// Read back every round, otherwise GCC merges consecutive rounds of one loop but not of the other
+		volatile T s_round{ dist(gen) };
+		volatile T t_round{ dist(gen) };
+
+		const auto diff{ [](const auto& x, const auto& y) {
+			double diff_r{};
+
+			for (size_t i{}; i < x.size(); i++)
+				diff_r = std::max({ diff_r, static_cast<double>(std::abs(x[i].x - y[i].x)),
+					static_cast<double>(std::abs(x[i].y - y[i].y)), static_cast<double>(std::abs(x[i].z - y[i].z)) });
+
+			return diff_r;
+		} };
+
+		const double eager_axpy{ time_batch(count, rounds, [&] {
+			const T s{ s_round }, t{ t_round };
+
+			for (size_t i{}; i < count; i++)
+				eager[i] = a[i] * s + b[i] * t - c[i];
+		}) };
+		const double lazy_axpy{ time_batch(count, rounds, [&] {
+			const T s{ s_round }, t{ t_round };
+
+			for (size_t i{}; i < count; i++)
+				lazy[i] = mpml::expr::lazy(a[i]) * s + b[i] * t - c[i];
+		}) };
+
+		const double eager_chain{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				eager4[i] = mats[i] * mats[(i + 1) & (count - 1)] * points[i];
+		}) };
+		const double lazy_chain{ time_batch(count, rounds, [&] {
+			for (size_t i{}; i < count; i++)
+				lazy4[i] = mpml::expr::lazy(mats[i]) * mats[(i + 1) & (count - 1)] * points[i];
+		}) };
+
+		report("a * s + b * t - c", type_name, "operators", eager_axpy);
+		report("a * s + b * t - c", type_name, "expr::lazy", lazy_axpy, diff(lazy, eager));
+		report("M1 * M2 * v", type_name, "operators", eager_chain);
+		report("M1 * M2 * v", type_name, "expr::lazy", lazy_chain, diff(lazy4, eager4));
+	}
+
+	template<typename T>
+	void bench_hash(const char* type_name)
+	{
+		std::mt19937 gen{ 31 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1000), static_cast<T>(1000) };
+
+		constexpr size_t count{ 4096 };
+		constexpr size_t rounds{ 500 };
+
+		std::vector<mpml::Vector4<T>> vecs(count);
+
+		for (auto& vec : vecs)
+			vec = { dist(gen), dist(gen), dist(gen), dist(gen) };
+
+		const auto run{ [&](const char* name, auto&& hash) {
+			size_t seed{};
+
+			const double time{ time_batch(count, rounds, [&] {
+				for (const auto& vec : vecs)
+					seed += hash(vec);
+			}) };
+
+			volatile size_t sink{ seed };
+			(void)sink;
+
+			report(name, type_name, "mpml", time);
+		} };
+
+		run("std::hash<Vector2>", [](const auto& vec) { return std::hash<mpml::Vector2<T>>{}(mpml::Vector2<T>{ vec.x, vec.y }); });
+		run("std::hash<Vector3>", [](const auto& vec) { return std::hash<mpml::Vector3<T>>{}(mpml::Vector3<T>{ vec.x, vec.y, vec.z }); });
+		run("std::hash<Vector4>", [](const auto& vec) { return std::hash<mpml::Vector4<T>>{}(vec); });
+	}
+
+	// std::hash<Vector3<int>> before func::hash: the identity of each int, folded by hash_combine
+	struct CombineHash
+	{
+		[[nodiscard]] size_t operator()(const mpml::Vector3<std::int32_t>& vec) const noexcept
+		{
+			std::size_t seed{};
+			hash_combine(seed, vec.x, vec.y, vec.z);
+
+			return seed;
+		}
+	};
+
+	// Chunk index lookups by chunk coordinates, in a box of chunks centred on the origin, a quarter of the lookups outside of it
+	void bench_chunk_map(const char* name, mpml::Vector3<std::int32_t> extent)
+	{
+		using Key = mpml::Vector3<std::int32_t>;
+
+		constexpr size_t lookup_count{ size_t{ 1 } << 20 };
+		constexpr size_t rounds{ 4 };
+
+		std::vector<Key> chunks;
+
+		for (std::int32_t z{ -extent.z / 2 }; z < extent.z / 2; z++)
+			for (std::int32_t y{ -extent.y / 2 }; y < extent.y / 2; y++)
+				for (std::int32_t x{ -extent.x / 2 }; x < extent.x / 2; x++)
+					chunks.push_back(Key{ x, y, z });
+
+		std::mt19937 gen{ 83 };
+		std::shuffle(chunks.begin(), chunks.end(), gen);
+
+		std::uniform_int_distribution<std::int32_t> dist_x{ -extent.x * 2 / 3, extent.x * 2 / 3 - 1 };
+		std::uniform_int_distribution<std::int32_t> dist_y{ -extent.y * 2 / 3, extent.y * 2 / 3 - 1 };
+		std::uniform_int_distribution<std::int32_t> dist_z{ -extent.z / 2, extent.z / 2 - 1 };
+
+		std::vector<Key> lookups(lookup_count);
+
+		for (Key& key : lookups)
+			key = Key{ dist_x(gen), dist_y(gen), dist_z(gen) };
+
+		std::vector<std::uint64_t> reference(lookup_count), results(lookup_count);
+
+		const auto mismatches{ [&] {
+			size_t count_r{};
+
+			for (size_t i{}; i < lookup_count; i++)
+				count_r += results[i] != reference[i];
+
+			return static_cast<double>(count_r);
+		} };
+
+		// Value + 1 of each lookup, 0 when missing
+		const auto bench_std{ [&]<typename H>(const char* variant, H, std::vector<std::uint64_t>& out) {
+			std::unordered_map<Key, std::uint32_t, H> map;
+
+			const double build_time{ time_batch(chunks.size(), 1, [&] {
+				for (size_t i{}; i < chunks.size(); i++)
+					map.emplace(chunks[i], static_cast<std::uint32_t>(i));
+			}) };
+
+			const double find_time{ time_batch(lookup_count, rounds, [&] {
+				for (size_t i{}; i < lookup_count; i++)
+				{
+					const auto it{ map.find(lookups[i]) };
+					out[i] = it == map.end() ? 0 : it->second + std::uint64_t{ 1 };
+				}
+			}) };
+
+			report(name, "build, per chunk", variant, build_time);
+			report(name, "find", variant, find_time, &out == &results ? std::optional<double>{ mismatches() } : std::nullopt);
+		} };
+
+		bench_std("std::unordered_map, hash_combine of std::hash<int>", CombineHash{}, reference);
+		bench_std("std::unordered_map, std::hash (func::hash)", std::hash<Key>{}, results);
+
+		mpml::FlatHashMap<Key, std::uint32_t> map;
+
+		const double build_time{ time_batch(chunks.size(), 1, [&] {
+			for (size_t i{}; i < chunks.size(); i++)
+				map.insert(chunks[i], static_cast<std::uint32_t>(i));
+		}) };
+
+		std::fill(results.begin(), results.end(), std::uint64_t{});
+
+		const double find_time{ time_batch(lookup_count, rounds, [&] {
+			for (size_t i{}; i < lookup_count; i++)
+			{
+				const std::uint32_t* value{ map.find(lookups[i]) };
+				results[i] = value == nullptr ? 0 : *value + std::uint64_t{ 1 };
+			}
+		}) };
+
+		const double find_diff{ mismatches() };
+
+		std::fill(results.begin(), results.end(), std::uint64_t{});
+
+		std::vector<const std::uint32_t*> values(lookup_count);
+
+		const double batch_time{ time_batch(lookup_count, rounds, [&] {
+			map.find(std::span<const Key>{ lookups }, std::span<const std::uint32_t*>{ values });
+
+			for (size_t i{}; i < lookup_count; i++)
+				results[i] = values[i] == nullptr ? 0 : *values[i] + std::uint64_t{ 1 };
+		}) };
+
+		const double batch_diff{ mismatches() };
+
+		report(name, "build, per chunk", "mpml::FlatHashMap", build_time);
+		report(name, "find", "mpml::FlatHashMap", find_time, find_diff);
+		report(name, "find", "mpml::FlatHashMap, batch find with prefetching", batch_time, batch_diff);
+	}
+
+#if defined(MPML_BENCH_DISPATCH)
+
+	[[nodiscard]] float max_difference(const std::vector<mpml::Vector3<float>>& a, const std::vector<mpml::Vector3<float>>& b)
+	{
+		float diff{};
+
+		for (size_t i{}; i < a.size(); i++)
+			diff = std::max({ diff, std::abs(a[i].x - b[i].x), std::abs(a[i].y - b[i].y), std::abs(a[i].z - b[i].z) });
+
+		return diff;
+	}
+
+	// Every level up to the detected one, checked against the scalar level
+	void bench_dispatch()
+	{
+		using namespace mpml::dispatch;
+
+		std::mt19937 gen{ 11 };
+		std::uniform_real_distribution<float> dist{ -100.f, 100.f };
+
+		constexpr size_t count{ 10003 };
+		constexpr size_t rounds{ 200 };
+
+		std::vector<mpml::Vector3<float>> points(count);
+
+		for (auto& point : points)
+			point = { dist(gen), dist(gen), dist(gen) };
+
+		std::vector<mpml::Vector4<float>> spheres(count);
+
+		for (auto& sphere : spheres)
+			sphere = { dist(gen), dist(gen), dist(gen), std::abs(dist(gen)) * 0.05f };
+
+		// Box of half extent 50 around the origin
+		const std::vector<mpml::Vector4<float>> planes
+		{
+			{ 1, 0, 0, 50 }, { -1, 0, 0, 50 },
+			{ 0, 1, 0, 50 }, { 0, -1, 0, 50 },
+			{ 0, 0, 1, 50 }, { 0, 0, -1, 50 }
+		};
+
+		const mpml::Matrix4<float> mat{ mpml::lookAt<float>({ 3, 4, 5 }, { 0, 0, 0 }, { 0, 1, 0 }) };
+
+		std::vector<mpml::Vector3<float>> reference_points(count), reference_normals{ points };
+		std::vector<std::uint32_t> reference_visible(count);
+
+		force_level(Level::scalar);
+		transform_points(mat, points, reference_points);
+		normalize(reference_normals);
+		const size_t reference_count{ cull_spheres(planes, spheres, reference_visible) };
+
+		for (Level level : { Level::scalar, Level::sse2, Level::avx2, Level::avx512 })
+		{
+			if (level > detected_level())
+				break;
+
+			force_level(level);
+
+			std::vector<mpml::Vector3<float>> transformed(count), normals(count);
+			std::vector<std::uint32_t> visible(count);
+			size_t visible_count{};
+
+			const double transform_time{ time_batch(count, rounds, [&] { transform_points(mat, points, transformed); }) };
+			const double normalize_time{ time_batch(count, rounds, [&] { normals = points; normalize(normals); }) };
+			const double cull_time{ time_batch(count, rounds, [&] { visible_count = cull_spheres(planes, spheres, visible); }) };
+
+			const bool same_visible{ visible_count == reference_count && std::equal(visible.begin(), visible.begin() + visible_count, reference_visible.begin()) };
+
+			report("dispatch transform_points", "float", level_name(level), transform_time, max_difference(transformed, reference_points));
+			report("dispatch normalize", "float", level_name(level), normalize_time, max_difference(normals, reference_normals));
+
+			// 1 when the visible set differs from the scalar one
+			report("dispatch cull_spheres", "float", level_name(level), cull_time, same_visible ? 0.0 : 1.0);
+		}
+
+		reset_level();
+	}
+
+#endif
+
+}
+
+
+int main()
+{
+	bench_matrix4_multiply<float>("float");
+	bench_matrix4_multiply<double>("double");
+
+	bench_matrix4_inverse<float>("float");
+	bench_matrix4_inverse<double>("double");
+
+	bench_matrix4_inverse_fast_paths<float>("float");
+	bench_matrix4_inverse_fast_paths<double>("double");
+
+	bench_vector3<float>("float");
+	bench_vector3<double>("double");
+
+	bench_vector3a();
+
+	bench_quaternion<float>("float");
+	bench_quaternion<double>("double");
+
+	bench_batch_transforms<float>("float");
+	bench_batch_transforms<double>("double");
+
+	bench_camera<float>("float");
+	bench_camera<double>("double");
+
+	bench_model_transforms<float>("float");
+	bench_model_transforms<double>("double");
+
+	bench_affine3<float>("float");
+	bench_affine3<double>("double");
+
+	bench_trs<float>("float");
+	bench_trs<double>("double");
+
+	bench_hierarchy();
+
+	bench_frustum<float>("float");
+	bench_frustum<double>("double");
+
+	bench_ray_aabb<float>("float");
+	bench_ray_aabb<double>("double");
+
+	bench_bvh();
+
+	bench_voxel_ray<float>("float");
+	bench_voxel_ray<double>("double");
+
+	bench_morton();
+
+	bench_chunk_split();
+
+	bench_trigo<float>("float");
+	bench_trigo<double>("double");
+
+	bench_batch_math<float>("float");
+	bench_batch_math<double>("double");
+
+	bench_fast<float>("float");
+	bench_fast<double>("double");
+
+	bench_expression<float>("float");
+	bench_expression<double>("double");
+
+	bench_hash<float>("float");
+	bench_hash<double>("double");
+
+	bench_chunk_map("chunk lookup, 32 x 32 x 8 chunks", { 32, 32, 8 });
+	bench_chunk_map("chunk lookup, 256 x 256 x 16 chunks", { 256, 256, 16 });
+
+	bench_soa();
+
+	bench_pack();
+
+#if defined(MPML_BENCH_DISPATCH)
+	bench_dispatch();
+#endif
+
+	print_json();
+
+	return 0;
+}
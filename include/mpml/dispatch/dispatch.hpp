@@ -0,0 +1,70 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Batch kernels dispatched at runtime on the instruction sets of the running CPU
+//
+// Note:
+//	Unlike the rest of MPML, these functions are compiled: link against MPML::dispatch (CMake option MPML_BUILD_DISPATCH).
+//	The CPU is queried once, on the first call, and the best available level is used from then on.
+//	force_level() overrides that choice, which is mostly useful to test and benchmark every variant on one machine.
+//
+//	Points are transformed the way the matrices of transforms.hpp are meant to be uploaded (column-major):
+//	p' = col0 * x + col1 * y + col2 * z + col3
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/vectors/vector4.hpp"
+#include "mpml/matrices/matrix4.hpp"
+
+
+namespace mpml::dispatch
+{
+
+	// Ordered from the least to the most capable
+	enum class Level : std::uint8_t
+	{
+		scalar,
+		sse2,
+		avx2,	// AVX2 + FMA
+		avx512	// AVX-512 F
+	};
+
+
+	// Levels
+
+	// Most capable level supported by both this build and the running CPU
+	[[nodiscard]] Level detected_level() noexcept;
+
+	// Level the kernels currently run at
+	[[nodiscard]] Level active_level() noexcept;
+
+	// Runs the kernels at level, clamped to detected_level(), and returns the level actually in use
+	Level force_level(Level level) noexcept;
+
+	// Goes back to detected_level()
+	void reset_level() noexcept;
+
+	[[nodiscard]] const char* level_name(Level level) noexcept;
+
+
+	// Kernels
+
+	// out[i] = mat applied to the point points[i], out must be at least as large as points and may alias it
+	void transform_points(const Matrix4<float>& mat, std::span<const Vector3<float>> points, std::span<Vector3<float>> out) noexcept;
+
+	// Normalizes every vector in place, null vectors stay null
+	void normalize(std::span<Vector3<float>> vectors) noexcept;
+
+	// Spheres are stored as (center, radius) and planes as (normal, distance), a point p being inside a plane when dot(normal, p) + distance >= 0
+	// Writes the index of every sphere that is not fully outside one of the planes into visible and returns how many there are
+	// visible must be at least as large as spheres
+	std::size_t cull_spheres(std::span<const Vector4<float>> planes, std::span<const Vector4<float>> spheres, std::span<std::uint32_t> visible) noexcept;
+
+} // mpml::dispatch
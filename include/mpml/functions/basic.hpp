@@ -7,8 +7,10 @@
 
 #include <cstdint>
 #include <concepts>
+#include <algorithm>
 #include <numbers>
 #include <vector>
+#include <type_traits>
 
 #include "mpml/vectors/vector2.hpp"
 #include "mpml/vectors/vector3.hpp"
@@ -33,7 +35,7 @@ namespace mpml::func
 	{
 		T temp{1}; 
 
-		for (T i{1}; i < k; i++)
+		for (T i{1}; i <= k; i++)
 		{
 			temp *= (n - i + 1);
 			temp /= i; // less precision loss	
@@ -42,10 +44,11 @@ namespace mpml::func
 		return temp;
 	}
 
-	template<std::integral T>
+	// B(n) with the B(1) = -1/2 convention
+	template<std::floating_point T>
 	[[nodiscard]] constexpr T bernoulli(std::size_t n) noexcept
 	{
-		if (n == )
+		if (n == 0)
 			return static_cast<T>(1);
 
 		std::vector<T> values(static_cast<std::size_t>(n + 1));
@@ -57,7 +60,7 @@ namespace mpml::func
 			T sum{ static_cast<T>(0) };
 
 			for (std::size_t k{}; k < m; k++)
-				sum += bin_coef(m + 1, k) * values[k]; 
+				sum += bin_coef(static_cast<T>(m + 1), static_cast<T>(k)) * values[k];
 
 			values[m] = -sum / static_cast<T>(m + 1);
 		}
@@ -66,11 +69,53 @@ namespace mpml::func
 	}
 
 
+	// Rounds toward -inf, b must be positive
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr T floor_div(T a, T b) noexcept
+	{
+		return static_cast<T>(a / b - (a % b < T{}));
+	}
+
+	// Remainder in [0, b), b must be positive
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr T euclid_mod(T a, T b) noexcept
+	{
+		const T r{ static_cast<T>(a % b) };
+		return static_cast<T>(r + b * (r < T{}));
+	}
+
+	// floor_div and euclid_mod by 2^shift, an arithmetic shift and a mask
+	template<std::integral T>
+	[[nodiscard]] constexpr T floor_div_pow2(T a, unsigned shift) noexcept
+	{
+		return a >> shift;
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr T mod_pow2(T a, unsigned shift) noexcept
+	{
+		return a & static_cast<T>((std::make_unsigned_t<T>{ 1 } << shift) - 1u);
+	}
+
+	// floor(value) as an integer, value must fit in I
+	template<std::integral I, std::floating_point T>
+	[[nodiscard]] constexpr I floor_to_int(T value) noexcept
+	{
+		const I truncated{ static_cast<I>(value) };
+		return truncated - static_cast<I>(value < static_cast<T>(truncated));
+	}
+
+
+	// x brought back into [a, b]
 	template<typename T>
 	[[nodiscard]] constexpr T wrap(T x, T a, T b) noexcept
 	{
-		T l{b - a + 1};
-		return ((x - a) % l) + a;
+		const T l{ static_cast<T>(b - a + 1) };
+
+		if constexpr (std::is_signed_v<T>)
+			return static_cast<T>(euclid_mod(static_cast<T>(x - a), l) + a);
+		else
+			return ((x - a) % l) + a;
 	}
 
 	template<typename T>
@@ -88,7 +133,7 @@ namespace mpml::func
 	template<typename T>
 	[[nodiscard]] constexpr T index_map(const mpml::Vector2<T>& index, T size) noexcept
 	{
-		return index_mapping(index.x, index.y, size);
+		return index_map(index.x, index.y, size);
 	}
 
 	template<typename T>
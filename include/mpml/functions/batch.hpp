@@ -0,0 +1,1259 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Evaluates sin, cos, tan, asin, acos, atan, atan2, exp, log and pow over whole arrays
+//
+// Note:
+//	Every function reads std::span<const T> and writes std::span<T>, for float and double, out may be the input span itself.
+//	The arrays are processed 8 floats / 4 doubles (AVX2) or 4 floats / 2 doubles (SSE2) at a time,
+//	the remaining elements are padded into one last register so that every element goes through the same polynomial.
+//
+//	Precision::standard, measured against a long double reference with every instruction set:
+//		sin, cos, sincos	2.4 ulp (float), 1.6 ulp (double)
+//		tan			3.2 ulp (float), 2.6 ulp (double)
+//		asin			3 ulp (float), 2.5 ulp (double)
+//		acos			1.5 ulp (float), 2.2 ulp (double)
+//		atan, atan2		3 ulp (float), 1.6 ulp (double)
+//		exp			1.3 ulp
+//		log			2 ulp
+//		pow			0.5 ulp (float, evaluated in double), about 2 + |y * ln(x)| ulp (double)
+//	The angles past 8192 rad (float) or 2^20 rad (double), inf and NaN go through the scalar functions of trigo.hpp.
+//	Special values (0, inf, NaN, subnormals, negative bases raised to integers) follow <cmath>.
+//
+//	Precision::fast keeps float grade polynomials for both types, about 2^-18 relative error (4e-6),
+//	and skips the special values: angles within the limits above, positive normal inputs for log and pow.
+//	Precision::strict calls <cmath> for every element.
+// ===================================================
+
+
+// Dependencies
+#include <bit>
+#include <span>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/angle.hpp"
+#include "mpml/functions/trigo.hpp"
+#include "mpml/vectors/vector3.hpp"
+
+
+namespace mpml::func
+{
+
+	enum class Precision
+	{
+		fast,		// about 2^-18 relative error, no special values
+		standard,	// a few ulp of T, see the header note
+		strict		// <cmath>, element by element
+	};
+
+}
+
+namespace mpml::detail::batch
+{
+
+	// Lanes, the kernels below are written once against these overloads and the scalar ones,
+	// value_of() only names the element type of a lane type (e.g. decltype(value_of(x))) and is never called
+
+#if defined(MPML_SIMD_AVX2)
+
+	using FloatLanes = __m256;
+	using DoubleLanes = __m256d;
+
+	float value_of(FloatLanes) noexcept;
+	double value_of(DoubleLanes) noexcept;
+
+	FloatLanes lanes_of(float) noexcept;
+	DoubleLanes lanes_of(double) noexcept;
+
+	[[nodiscard]] inline FloatLanes loadu(const float* src, FloatLanes) noexcept { return _mm256_loadu_ps(src); }
+	inline void storeu(float* dst, FloatLanes vec) noexcept { _mm256_storeu_ps(dst, vec); }
+
+	[[nodiscard]] inline FloatLanes splat(FloatLanes, double value) noexcept { return _mm256_set1_ps(static_cast<float>(value)); }
+
+	[[nodiscard]] inline FloatLanes add(FloatLanes a, FloatLanes b) noexcept { return _mm256_add_ps(a, b); }
+	[[nodiscard]] inline FloatLanes sub(FloatLanes a, FloatLanes b) noexcept { return _mm256_sub_ps(a, b); }
+	[[nodiscard]] inline FloatLanes mul(FloatLanes a, FloatLanes b) noexcept { return _mm256_mul_ps(a, b); }
+	[[nodiscard]] inline FloatLanes div(FloatLanes a, FloatLanes b) noexcept { return _mm256_div_ps(a, b); }
+	[[nodiscard]] inline FloatLanes sqrt(FloatLanes vec) noexcept { return _mm256_sqrt_ps(vec); }
+	[[nodiscard]] inline FloatLanes min(FloatLanes a, FloatLanes b) noexcept { return _mm256_min_ps(a, b); }
+	[[nodiscard]] inline FloatLanes max(FloatLanes a, FloatLanes b) noexcept { return _mm256_max_ps(a, b); }
+	[[nodiscard]] inline FloatLanes abs(FloatLanes vec) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), vec); }
+	[[nodiscard]] inline FloatLanes round(FloatLanes vec) noexcept { return _mm256_round_ps(vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	[[nodiscard]] inline FloatLanes floor(FloatLanes vec) noexcept { return _mm256_floor_ps(vec); }
+
+	[[nodiscard]] inline FloatLanes eq(FloatLanes a, FloatLanes b) noexcept { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	[[nodiscard]] inline FloatLanes neq(FloatLanes a, FloatLanes b) noexcept { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+	[[nodiscard]] inline FloatLanes lt(FloatLanes a, FloatLanes b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	[[nodiscard]] inline FloatLanes gt(FloatLanes a, FloatLanes b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	[[nodiscard]] inline FloatLanes ge(FloatLanes a, FloatLanes b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	[[nodiscard]] inline FloatLanes not_le(FloatLanes a, FloatLanes b) noexcept { return _mm256_cmp_ps(a, b, _CMP_NLE_UQ); }
+	[[nodiscard]] inline FloatLanes not_ge(FloatLanes a, FloatLanes b) noexcept { return _mm256_cmp_ps(a, b, _CMP_NGE_UQ); }
+
+	[[nodiscard]] inline FloatLanes mask_and(FloatLanes a, FloatLanes b) noexcept { return _mm256_and_ps(a, b); }
+	[[nodiscard]] inline FloatLanes mask_or(FloatLanes a, FloatLanes b) noexcept { return _mm256_or_ps(a, b); }
+	[[nodiscard]] inline FloatLanes mask_andnot(FloatLanes a, FloatLanes b) noexcept { return _mm256_andnot_ps(a, b); }
+	[[nodiscard]] inline bool any(FloatLanes mask) noexcept { return _mm256_movemask_ps(mask) != 0; }
+	[[nodiscard]] inline unsigned bits(FloatLanes mask) noexcept { return static_cast<unsigned>(_mm256_movemask_ps(mask)); }
+
+	[[nodiscard]] inline FloatLanes select(FloatLanes mask, FloatLanes if_true, FloatLanes if_false) noexcept { return _mm256_blendv_ps(if_false, if_true, mask); }
+	[[nodiscard]] inline FloatLanes flip_sign(FloatLanes vec, FloatLanes mask) noexcept { return _mm256_xor_ps(vec, _mm256_and_ps(mask, _mm256_set1_ps(-0.f))); }
+	[[nodiscard]] inline FloatLanes copysign(FloatLanes mag, FloatLanes sign) noexcept
+	{
+		const __m256 sign_bit{ _mm256_set1_ps(-0.f) };
+		return _mm256_or_ps(_mm256_andnot_ps(sign_bit, mag), _mm256_and_ps(sign_bit, sign));
+	}
+
+	// 2^n for integral n in [-126, 127]
+	[[nodiscard]] inline FloatLanes pow2i(FloatLanes n) noexcept
+	{
+		return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23));
+	}
+
+	// vec = mantissa * 2^exponent with the mantissa in [0.5, 1), for positive normal vec
+	[[nodiscard]] inline FloatLanes split_exponent(FloatLanes vec, FloatLanes& exponent) noexcept
+	{
+		const __m256i bits{ _mm256_castps_si256(vec) };
+		exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+		return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000)));
+	}
+
+	inline void widen(FloatLanes vec, DoubleLanes& low, DoubleLanes& high) noexcept
+	{
+		low = _mm256_cvtps_pd(_mm256_castps256_ps128(vec));
+		high = _mm256_cvtps_pd(_mm256_extractf128_ps(vec, 1));
+	}
+
+	[[nodiscard]] inline FloatLanes narrow(DoubleLanes low, DoubleLanes high) noexcept
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1);
+	}
+
+
+	[[nodiscard]] inline DoubleLanes loadu(const double* src, DoubleLanes) noexcept { return _mm256_loadu_pd(src); }
+	inline void storeu(double* dst, DoubleLanes vec) noexcept { _mm256_storeu_pd(dst, vec); }
+
+	[[nodiscard]] inline DoubleLanes splat(DoubleLanes, double value) noexcept { return _mm256_set1_pd(value); }
+
+	[[nodiscard]] inline DoubleLanes add(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_add_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes sub(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_sub_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes mul(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_mul_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes div(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_div_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes sqrt(DoubleLanes vec) noexcept { return _mm256_sqrt_pd(vec); }
+	[[nodiscard]] inline DoubleLanes min(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_min_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes max(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_max_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes abs(DoubleLanes vec) noexcept { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), vec); }
+	[[nodiscard]] inline DoubleLanes round(DoubleLanes vec) noexcept { return _mm256_round_pd(vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	[[nodiscard]] inline DoubleLanes floor(DoubleLanes vec) noexcept { return _mm256_floor_pd(vec); }
+
+	[[nodiscard]] inline DoubleLanes eq(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+	[[nodiscard]] inline DoubleLanes neq(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+	[[nodiscard]] inline DoubleLanes lt(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	[[nodiscard]] inline DoubleLanes gt(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	[[nodiscard]] inline DoubleLanes ge(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+	[[nodiscard]] inline DoubleLanes not_le(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_cmp_pd(a, b, _CMP_NLE_UQ); }
+	[[nodiscard]] inline DoubleLanes not_ge(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_cmp_pd(a, b, _CMP_NGE_UQ); }
+
+	[[nodiscard]] inline DoubleLanes mask_and(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_and_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes mask_or(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_or_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes mask_andnot(DoubleLanes a, DoubleLanes b) noexcept { return _mm256_andnot_pd(a, b); }
+	[[nodiscard]] inline bool any(DoubleLanes mask) noexcept { return _mm256_movemask_pd(mask) != 0; }
+	[[nodiscard]] inline unsigned bits(DoubleLanes mask) noexcept { return static_cast<unsigned>(_mm256_movemask_pd(mask)); }
+
+	[[nodiscard]] inline DoubleLanes select(DoubleLanes mask, DoubleLanes if_true, DoubleLanes if_false) noexcept { return _mm256_blendv_pd(if_false, if_true, mask); }
+	[[nodiscard]] inline DoubleLanes flip_sign(DoubleLanes vec, DoubleLanes mask) noexcept { return _mm256_xor_pd(vec, _mm256_and_pd(mask, _mm256_set1_pd(-0.0))); }
+	[[nodiscard]] inline DoubleLanes copysign(DoubleLanes mag, DoubleLanes sign) noexcept
+	{
+		const __m256d sign_bit{ _mm256_set1_pd(-0.0) };
+		return _mm256_or_pd(_mm256_andnot_pd(sign_bit, mag), _mm256_and_pd(sign_bit, sign));
+	}
+
+	// 2^n for integral n in [-1022, 1023], n + 1023 lands in the low mantissa bits of 2^52 + n + 1023
+	[[nodiscard]] inline DoubleLanes pow2i(DoubleLanes n) noexcept
+	{
+		const __m256i biased{ _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(4503599627370496.0 + 1023.0))) };
+		return _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+	}
+
+	[[nodiscard]] inline DoubleLanes split_exponent(DoubleLanes vec, DoubleLanes& exponent) noexcept
+	{
+		const __m256i bits{ _mm256_castpd_si256(vec) };
+		const __m256i biased{ _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x4330000000000000)) };
+		exponent = _mm256_sub_pd(_mm256_castsi256_pd(biased), _mm256_set1_pd(4503599627370496.0 + 1022.0));
+		return _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF)), _mm256_set1_epi64x(0x3FE0000000000000)));
+	}
+
+#elif defined(MPML_SIMD_SSE2)
+
+	using FloatLanes = __m128;
+	using DoubleLanes = __m128d;
+
+	float value_of(FloatLanes) noexcept;
+	double value_of(DoubleLanes) noexcept;
+
+	FloatLanes lanes_of(float) noexcept;
+	DoubleLanes lanes_of(double) noexcept;
+
+	[[nodiscard]] inline FloatLanes loadu(const float* src, FloatLanes) noexcept { return _mm_loadu_ps(src); }
+	inline void storeu(float* dst, FloatLanes vec) noexcept { _mm_storeu_ps(dst, vec); }
+
+	[[nodiscard]] inline FloatLanes splat(FloatLanes, double value) noexcept { return _mm_set1_ps(static_cast<float>(value)); }
+
+	[[nodiscard]] inline FloatLanes add(FloatLanes a, FloatLanes b) noexcept { return _mm_add_ps(a, b); }
+	[[nodiscard]] inline FloatLanes sub(FloatLanes a, FloatLanes b) noexcept { return _mm_sub_ps(a, b); }
+	[[nodiscard]] inline FloatLanes mul(FloatLanes a, FloatLanes b) noexcept { return _mm_mul_ps(a, b); }
+	[[nodiscard]] inline FloatLanes div(FloatLanes a, FloatLanes b) noexcept { return _mm_div_ps(a, b); }
+	[[nodiscard]] inline FloatLanes sqrt(FloatLanes vec) noexcept { return _mm_sqrt_ps(vec); }
+	[[nodiscard]] inline FloatLanes min(FloatLanes a, FloatLanes b) noexcept { return _mm_min_ps(a, b); }
+	[[nodiscard]] inline FloatLanes max(FloatLanes a, FloatLanes b) noexcept { return _mm_max_ps(a, b); }
+	[[nodiscard]] inline FloatLanes abs(FloatLanes vec) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.f), vec); }
+
+	[[nodiscard]] inline FloatLanes eq(FloatLanes a, FloatLanes b) noexcept { return _mm_cmpeq_ps(a, b); }
+	[[nodiscard]] inline FloatLanes neq(FloatLanes a, FloatLanes b) noexcept { return _mm_cmpneq_ps(a, b); }
+	[[nodiscard]] inline FloatLanes lt(FloatLanes a, FloatLanes b) noexcept { return _mm_cmplt_ps(a, b); }
+	[[nodiscard]] inline FloatLanes gt(FloatLanes a, FloatLanes b) noexcept { return _mm_cmpgt_ps(a, b); }
+	[[nodiscard]] inline FloatLanes ge(FloatLanes a, FloatLanes b) noexcept { return _mm_cmpge_ps(a, b); }
+	[[nodiscard]] inline FloatLanes not_le(FloatLanes a, FloatLanes b) noexcept { return _mm_cmpnle_ps(a, b); }
+	[[nodiscard]] inline FloatLanes not_ge(FloatLanes a, FloatLanes b) noexcept { return _mm_cmpnge_ps(a, b); }
+
+	[[nodiscard]] inline FloatLanes mask_and(FloatLanes a, FloatLanes b) noexcept { return _mm_and_ps(a, b); }
+	[[nodiscard]] inline FloatLanes mask_or(FloatLanes a, FloatLanes b) noexcept { return _mm_or_ps(a, b); }
+	[[nodiscard]] inline FloatLanes mask_andnot(FloatLanes a, FloatLanes b) noexcept { return _mm_andnot_ps(a, b); }
+	[[nodiscard]] inline bool any(FloatLanes mask) noexcept { return _mm_movemask_ps(mask) != 0; }
+	[[nodiscard]] inline unsigned bits(FloatLanes mask) noexcept { return static_cast<unsigned>(_mm_movemask_ps(mask)); }
+
+	[[nodiscard]] inline FloatLanes select(FloatLanes mask, FloatLanes if_true, FloatLanes if_false) noexcept
+	{
+#	if defined(MPML_SIMD_SSE41)
+		return _mm_blendv_ps(if_false, if_true, mask);
+#	else
+		return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+#	endif
+	}
+
+	// Nearest, ties to even
+	[[nodiscard]] inline FloatLanes round(FloatLanes vec) noexcept
+	{
+#	if defined(MPML_SIMD_SSE41)
+		return _mm_round_ps(vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#	else
+		// Past 2^22 every float is already integral
+		const __m128 magic{ _mm_set1_ps(12582912.f) };
+		return select(_mm_cmplt_ps(abs(vec), _mm_set1_ps(4194304.f)), _mm_sub_ps(_mm_add_ps(vec, magic), magic), vec);
+#	endif
+	}
+
+	[[nodiscard]] inline FloatLanes floor(FloatLanes vec) noexcept
+	{
+#	if defined(MPML_SIMD_SSE41)
+		return _mm_floor_ps(vec);
+#	else
+		const __m128 rounded{ round(vec) };
+		return _mm_sub_ps(rounded, _mm_and_ps(_mm_cmpgt_ps(rounded, vec), _mm_set1_ps(1.f)));
+#	endif
+	}
+
+	[[nodiscard]] inline FloatLanes flip_sign(FloatLanes vec, FloatLanes mask) noexcept { return _mm_xor_ps(vec, _mm_and_ps(mask, _mm_set1_ps(-0.f))); }
+	[[nodiscard]] inline FloatLanes copysign(FloatLanes mag, FloatLanes sign) noexcept
+	{
+		const __m128 sign_bit{ _mm_set1_ps(-0.f) };
+		return _mm_or_ps(_mm_andnot_ps(sign_bit, mag), _mm_and_ps(sign_bit, sign));
+	}
+
+	[[nodiscard]] inline FloatLanes pow2i(FloatLanes n) noexcept
+	{
+		return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23));
+	}
+
+	[[nodiscard]] inline FloatLanes split_exponent(FloatLanes vec, FloatLanes& exponent) noexcept
+	{
+		const __m128i bits{ _mm_castps_si128(vec) };
+		exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+		return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000)));
+	}
+
+	inline void widen(FloatLanes vec, DoubleLanes& low, DoubleLanes& high) noexcept
+	{
+		low = _mm_cvtps_pd(vec);
+		high = _mm_cvtps_pd(_mm_movehl_ps(vec, vec));
+	}
+
+	[[nodiscard]] inline FloatLanes narrow(DoubleLanes low, DoubleLanes high) noexcept
+	{
+		return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+	}
+
+
+	[[nodiscard]] inline DoubleLanes loadu(const double* src, DoubleLanes) noexcept { return _mm_loadu_pd(src); }
+	inline void storeu(double* dst, DoubleLanes vec) noexcept { _mm_storeu_pd(dst, vec); }
+
+	[[nodiscard]] inline DoubleLanes splat(DoubleLanes, double value) noexcept { return _mm_set1_pd(value); }
+
+	[[nodiscard]] inline DoubleLanes add(DoubleLanes a, DoubleLanes b) noexcept { return _mm_add_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes sub(DoubleLanes a, DoubleLanes b) noexcept { return _mm_sub_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes mul(DoubleLanes a, DoubleLanes b) noexcept { return _mm_mul_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes div(DoubleLanes a, DoubleLanes b) noexcept { return _mm_div_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes sqrt(DoubleLanes vec) noexcept { return _mm_sqrt_pd(vec); }
+	[[nodiscard]] inline DoubleLanes min(DoubleLanes a, DoubleLanes b) noexcept { return _mm_min_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes max(DoubleLanes a, DoubleLanes b) noexcept { return _mm_max_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes abs(DoubleLanes vec) noexcept { return _mm_andnot_pd(_mm_set1_pd(-0.0), vec); }
+
+	[[nodiscard]] inline DoubleLanes eq(DoubleLanes a, DoubleLanes b) noexcept { return _mm_cmpeq_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes neq(DoubleLanes a, DoubleLanes b) noexcept { return _mm_cmpneq_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes lt(DoubleLanes a, DoubleLanes b) noexcept { return _mm_cmplt_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes gt(DoubleLanes a, DoubleLanes b) noexcept { return _mm_cmpgt_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes ge(DoubleLanes a, DoubleLanes b) noexcept { return _mm_cmpge_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes not_le(DoubleLanes a, DoubleLanes b) noexcept { return _mm_cmpnle_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes not_ge(DoubleLanes a, DoubleLanes b) noexcept { return _mm_cmpnge_pd(a, b); }
+
+	[[nodiscard]] inline DoubleLanes mask_and(DoubleLanes a, DoubleLanes b) noexcept { return _mm_and_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes mask_or(DoubleLanes a, DoubleLanes b) noexcept { return _mm_or_pd(a, b); }
+	[[nodiscard]] inline DoubleLanes mask_andnot(DoubleLanes a, DoubleLanes b) noexcept { return _mm_andnot_pd(a, b); }
+	[[nodiscard]] inline bool any(DoubleLanes mask) noexcept { return _mm_movemask_pd(mask) != 0; }
+	[[nodiscard]] inline unsigned bits(DoubleLanes mask) noexcept { return static_cast<unsigned>(_mm_movemask_pd(mask)); }
+
+	[[nodiscard]] inline DoubleLanes select(DoubleLanes mask, DoubleLanes if_true, DoubleLanes if_false) noexcept
+	{
+#	if defined(MPML_SIMD_SSE41)
+		return _mm_blendv_pd(if_false, if_true, mask);
+#	else
+		return _mm_or_pd(_mm_and_pd(mask, if_true), _mm_andnot_pd(mask, if_false));
+#	endif
+	}
+
+	[[nodiscard]] inline DoubleLanes round(DoubleLanes vec) noexcept
+	{
+#	if defined(MPML_SIMD_SSE41)
+		return _mm_round_pd(vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#	else
+		// Past 2^51 every double is already integral
+		const __m128d magic{ _mm_set1_pd(6755399441055744.0) };
+		return select(_mm_cmplt_pd(abs(vec), _mm_set1_pd(2251799813685248.0)), _mm_sub_pd(_mm_add_pd(vec, magic), magic), vec);
+#	endif
+	}
+
+	[[nodiscard]] inline DoubleLanes floor(DoubleLanes vec) noexcept
+	{
+#	if defined(MPML_SIMD_SSE41)
+		return _mm_floor_pd(vec);
+#	else
+		const __m128d rounded{ round(vec) };
+		return _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, vec), _mm_set1_pd(1.0)));
+#	endif
+	}
+
+	[[nodiscard]] inline DoubleLanes flip_sign(DoubleLanes vec, DoubleLanes mask) noexcept { return _mm_xor_pd(vec, _mm_and_pd(mask, _mm_set1_pd(-0.0))); }
+	[[nodiscard]] inline DoubleLanes copysign(DoubleLanes mag, DoubleLanes sign) noexcept
+	{
+		const __m128d sign_bit{ _mm_set1_pd(-0.0) };
+		return _mm_or_pd(_mm_andnot_pd(sign_bit, mag), _mm_and_pd(sign_bit, sign));
+	}
+
+	[[nodiscard]] inline DoubleLanes pow2i(DoubleLanes n) noexcept
+	{
+		const __m128i biased{ _mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(4503599627370496.0 + 1023.0))) };
+		return _mm_castsi128_pd(_mm_slli_epi64(biased, 52));
+	}
+
+	[[nodiscard]] inline DoubleLanes split_exponent(DoubleLanes vec, DoubleLanes& exponent) noexcept
+	{
+		const __m128i bits{ _mm_castpd_si128(vec) };
+		const __m128i biased{ _mm_or_si128(_mm_srli_epi64(bits, 52), _mm_set1_epi64x(0x4330000000000000)) };
+		exponent = _mm_sub_pd(_mm_castsi128_pd(biased), _mm_set1_pd(4503599627370496.0 + 1022.0));
+		return _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFF)), _mm_set1_epi64x(0x3FE0000000000000)));
+	}
+
+#endif
+
+#if defined(MPML_SIMD_SSE2)
+	using simd::madd;
+#endif
+
+
+	// Single elements, for the builds without SIMD, masks are plain bools
+
+	float value_of(float) noexcept;
+	double value_of(double) noexcept;
+
+	template<std::floating_point T>
+	[[nodiscard]] inline T loadu(const T* src, T) noexcept { return *src; }
+
+	template<std::floating_point T>
+	inline void storeu(T* dst, T value) noexcept { *dst = value; }
+
+	template<std::floating_point T>
+	[[nodiscard]] inline T splat(T, double value) noexcept { return static_cast<T>(value); }
+
+	template<std::floating_point T> [[nodiscard]] inline T add(T a, T b) noexcept { return a + b; }
+	template<std::floating_point T> [[nodiscard]] inline T sub(T a, T b) noexcept { return a - b; }
+	template<std::floating_point T> [[nodiscard]] inline T mul(T a, T b) noexcept { return a * b; }
+	template<std::floating_point T> [[nodiscard]] inline T div(T a, T b) noexcept { return a / b; }
+	template<std::floating_point T> [[nodiscard]] inline T madd(T a, T b, T c) noexcept { return a * b + c; }
+	template<std::floating_point T> [[nodiscard]] inline T sqrt(T value) noexcept { return std::sqrt(value); }
+	template<std::floating_point T> [[nodiscard]] inline T abs(T value) noexcept { return std::abs(value); }
+	template<std::floating_point T> [[nodiscard]] inline T round(T value) noexcept { return std::nearbyint(value); }
+	template<std::floating_point T> [[nodiscard]] inline T floor(T value) noexcept { return std::floor(value); }
+
+	// b when either is NaN, as minps/maxps do
+	template<std::floating_point T> [[nodiscard]] inline T min(T a, T b) noexcept { return a < b ? a : b; }
+	template<std::floating_point T> [[nodiscard]] inline T max(T a, T b) noexcept { return a > b ? a : b; }
+
+	template<std::floating_point T> [[nodiscard]] inline bool eq(T a, T b) noexcept { return a == b; }
+	template<std::floating_point T> [[nodiscard]] inline bool neq(T a, T b) noexcept { return a != b; }
+	template<std::floating_point T> [[nodiscard]] inline bool lt(T a, T b) noexcept { return a < b; }
+	template<std::floating_point T> [[nodiscard]] inline bool gt(T a, T b) noexcept { return a > b; }
+	template<std::floating_point T> [[nodiscard]] inline bool ge(T a, T b) noexcept { return a >= b; }
+	template<std::floating_point T> [[nodiscard]] inline bool not_le(T a, T b) noexcept { return !(a <= b); }
+	template<std::floating_point T> [[nodiscard]] inline bool not_ge(T a, T b) noexcept { return !(a >= b); }
+
+	[[nodiscard]] inline bool mask_and(bool a, bool b) noexcept { return a && b; }
+	[[nodiscard]] inline bool mask_or(bool a, bool b) noexcept { return a || b; }
+	[[nodiscard]] inline bool mask_andnot(bool a, bool b) noexcept { return !a && b; }
+	[[nodiscard]] inline bool any(bool mask) noexcept { return mask; }
+	[[nodiscard]] inline unsigned bits(bool mask) noexcept { return mask ? 1u : 0u; }
+
+	template<std::floating_point T> [[nodiscard]] inline T select(bool mask, T if_true, T if_false) noexcept { return mask ? if_true : if_false; }
+	template<std::floating_point T> [[nodiscard]] inline T flip_sign(T value, bool mask) noexcept { return mask ? -value : value; }
+	template<std::floating_point T> [[nodiscard]] inline T copysign(T mag, T sign) noexcept { return std::copysign(mag, sign); }
+
+	[[nodiscard]] inline float pow2i(float n) noexcept
+	{
+		return std::bit_cast<float>(static_cast<std::uint32_t>(static_cast<std::int32_t>(n) + 127) << 23);
+	}
+
+	[[nodiscard]] inline double pow2i(double n) noexcept
+	{
+		return std::bit_cast<double>(static_cast<std::uint64_t>(static_cast<std::int64_t>(n) + 1023) << 52);
+	}
+
+	[[nodiscard]] inline float split_exponent(float value, float& exponent) noexcept
+	{
+		const std::uint32_t bits{ std::bit_cast<std::uint32_t>(value) };
+		exponent = static_cast<float>(static_cast<std::int32_t>(bits >> 23) - 126);
+		return std::bit_cast<float>((bits & 0x007FFFFFu) | 0x3F000000u);
+	}
+
+	[[nodiscard]] inline double split_exponent(double value, double& exponent) noexcept
+	{
+		const std::uint64_t bits{ std::bit_cast<std::uint64_t>(value) };
+		exponent = static_cast<double>(static_cast<std::int64_t>(bits >> 52) - 1022);
+		return std::bit_cast<double>((bits & 0x000FFFFFFFFFFFFFu) | 0x3FE0000000000000u);
+	}
+
+
+	// Polynomial coefficients, highest degree first
+	// *_f: float grade (cephes), *_d: double grade (cephes, Taylor for exp, atanh series for log),
+	// *_fast: minimax fits for about 2^-18 relative error
+
+	inline constexpr double sin_f[]{ -1.9515295891e-4, 8.3321608736e-3, -1.6666654611e-1 };
+	inline constexpr double sin_d[]{ 1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6, -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1 };
+	inline constexpr double sin_fast[]{ 8.163281923613357e-3, -1.6663390377426296e-1 };
+
+	inline constexpr double cos_f[]{ 2.443315711809948e-5, -1.388731625493765e-3, 4.166664568298827e-2 };
+	inline constexpr double cos_d[]{ -1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7, 2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2 };
+	inline constexpr double cos_fast[]{ -1.364871435627456e-3, 4.1661071306355886e-2 };
+
+	inline constexpr double tan_f[]{ 9.38540185543e-3, 3.11992232697e-3, 2.44301354525e-2, 5.34112807005e-2, 1.33387994085e-1, 3.33331568548e-1 };
+	inline constexpr double tan_d_p[]{ -1.30936939181383777646e4, 1.15351664838587416140e6, -1.79565251976484877988e7 };
+	inline constexpr double tan_d_q[]{ 1.0, 1.36812963470692954678e4, -1.32089234440210967447e6, 2.50083801823357915839e7, -5.38695755929454629881e7 };
+	inline constexpr double tan_fast[]{ 4.308880268186757e-2, 4.1398550836891417e-2, 1.3606506026403264e-1, 3.331543332096136e-1 };
+
+	inline constexpr double atan_f[]{ 8.05374449538e-2, -1.38776856032e-1, 1.99777106478e-1, -3.33329491539e-1 };
+	inline constexpr double atan_d_p[]{ -8.750608600031904122785e-1, -1.615753718733365076637e1, -7.500855792314704667340e1, -1.228866684490136173410e2, -6.485021904942025371773e1 };
+	inline constexpr double atan_d_q[]{ 1.0, 2.485846490142306297962e1, 1.650270098316988542046e2, 4.328810604912902668951e2, 4.853903996359136964868e2, 1.945506571482613964425e2 };
+	inline constexpr double atan_fast[]{ -1.1225162948945264e-1, 1.9714143742281423e-1, -3.332550778530288e-1 };
+
+	inline constexpr double asin_f[]{ 4.2163199048e-2, 2.4181311049e-2, 4.5470025998e-2, 7.4953002686e-2, 1.6666752422e-1 };
+
+	inline constexpr double exp_f[]{ 1.9875691500e-4, 1.3981999507e-3, 8.3334519073e-3, 4.1665795894e-2, 1.6666665459e-1, 5.0000001201e-1 };
+	inline constexpr double exp_d[]{ 1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5 };
+	inline constexpr double exp_fast[]{ 8.312524910320671e-3, 4.189011322101025e-2, 1.6667114465098246e-1, 4.9999231790925563e-1 };
+
+	inline constexpr double log_f[]{ 2.0 / 9.0, 2.0 / 7.0, 2.0 / 5.0, 2.0 / 3.0 };
+	inline constexpr double log_d[]{ 2.0 / 19.0, 2.0 / 17.0, 2.0 / 15.0, 2.0 / 13.0, 2.0 / 11.0, 2.0 / 9.0, 2.0 / 7.0, 2.0 / 5.0, 2.0 / 3.0 };
+	inline constexpr double log_fast[]{ 4.1201994688674437e-1, 6.665562201114552e-1 };
+
+	inline constexpr double pi{ 3.14159265358979311600e+00 };
+	inline constexpr double pi_lo{ 1.22464679914735317720e-16 };
+	inline constexpr double pio2{ 1.57079632679489655800e+00 };
+	inline constexpr double pio2_lo{ 6.12323399573676588613e-17 };
+	inline constexpr double pio4{ 7.85398163397448278999e-01 };
+
+	template<typename V, size_t N>
+	[[nodiscard]] inline V horner(V x, const double (&coefs)[N]) noexcept
+	{
+		V result{ splat(x, coefs[0]) };
+
+		for (size_t i{ 1 }; i < N; i++)
+			result = madd(result, x, splat(x, coefs[i]));
+
+		return result;
+	}
+
+	// Runs a scalar function on every lane
+	template<typename V, typename Func>
+	[[nodiscard]] inline V per_lane(V vec, Func&& func) noexcept
+	{
+		using T = decltype(value_of(vec));
+
+		if constexpr (sizeof(V) == sizeof(T))
+			return func(vec);
+		else
+		{
+			alignas(32) T lanes[sizeof(V) / sizeof(T)];
+			storeu(lanes, vec);
+
+			for (T& lane : lanes)
+				lane = func(lane);
+
+			return loadu(lanes, vec);
+		}
+	}
+
+
+	// Kernels, T is the element type and P the precision tier (never strict here)
+
+	// x = r + q * pi/2 with r in about [-pi/4, pi/4], q integral
+	template<typename V>
+	[[nodiscard]] inline V reduce_quadrant(V x, V& q) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		q = round(mul(x, splat(x, trigo::two_over_pi)));
+
+		// Float lanes split pi/2 in four float parts, the first three of 11 bits so that q * part stays exact for |q| below 2^13
+		if constexpr (std::is_same_v<T, float>)
+		{
+			V r{ madd(q, splat(x, -1.5703125), x) };
+			r = madd(q, splat(x, -4.837512969970703125e-4), r);
+			r = madd(q, splat(x, -7.549533620476722717e-8), r);
+			return madd(q, splat(x, -2.563344068257089611e-12), r);
+		}
+		else
+			return madd(q, splat(x, -trigo::pio2_3), madd(q, splat(x, -trigo::pio2_2), madd(q, splat(x, -trigo::pio2_1), x)));
+	}
+
+	// Past this |x| the angle goes through detail::trigo
+	template<typename T>
+	[[nodiscard]] constexpr double reduction_limit() noexcept
+	{
+		return std::is_same_v<T, float> ? 8192.0 : 1048576.0;
+	}
+
+	// Quadrant bits of an integral q: odd, 2 (sin negative) and (q + 1) & 2 (cos negative)
+	template<typename V>
+	[[nodiscard]] inline auto quadrant_odd(V q) noexcept
+	{
+		const V half{ mul(q, splat(q, 0.5)) };
+		return neq(round(half), half);
+	}
+
+	template<typename V>
+	[[nodiscard]] inline V quadrant_fraction(V q) noexcept
+	{
+		const V quarter{ mul(q, splat(q, 0.25)) };
+		return sub(quarter, floor(quarter));
+	}
+
+	template<typename V>
+	[[nodiscard]] inline auto sin_negative(V q) noexcept
+	{
+		return ge(quadrant_fraction(q), splat(q, 0.5));
+	}
+
+	template<typename V>
+	[[nodiscard]] inline auto cos_negative(V q) noexcept
+	{
+		const V fraction{ quadrant_fraction(q) };
+		return mask_and(ge(fraction, splat(q, 0.25)), lt(fraction, splat(q, 0.75)));
+	}
+
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V sin_poly(V r) noexcept
+	{
+		using T = decltype(value_of(r));
+		const V z{ mul(r, r) };
+
+		if constexpr (P == func::Precision::fast)
+			return madd(mul(r, z), horner(z, sin_fast), r);
+		else if constexpr (std::is_same_v<T, float>)
+			return madd(mul(r, z), horner(z, sin_f), r);
+		else
+			return madd(mul(r, z), horner(z, sin_d), r);
+	}
+
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V cos_poly(V r) noexcept
+	{
+		using T = decltype(value_of(r));
+		const V z{ mul(r, r) };
+		const V head{ madd(z, splat(r, -0.5), splat(r, 1.0)) };
+
+		if constexpr (P == func::Precision::fast)
+			return madd(mul(z, z), horner(z, cos_fast), head);
+		else if constexpr (std::is_same_v<T, float>)
+			return madd(mul(z, z), horner(z, cos_f), head);
+		else
+			return madd(mul(z, z), horner(z, cos_d), head);
+	}
+
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V sin(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		if constexpr (P == func::Precision::standard)
+		{
+			if (any(not_le(abs(x), splat(x, reduction_limit<T>()))))
+				return per_lane(x, [](T value) { return trigo::sin(value); });
+		}
+
+		V q;
+		const V r{ reduce_quadrant(x, q) };
+		const V value{ select(quadrant_odd(q), cos_poly<P>(r), sin_poly<P>(r)) };
+
+		return flip_sign(value, sin_negative(q));
+	}
+
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V cos(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		if constexpr (P == func::Precision::standard)
+		{
+			if (any(not_le(abs(x), splat(x, reduction_limit<T>()))))
+				return per_lane(x, [](T value) { return trigo::cos(value); });
+		}
+
+		V q;
+		const V r{ reduce_quadrant(x, q) };
+		const V value{ select(quadrant_odd(q), sin_poly<P>(r), cos_poly<P>(r)) };
+
+		return flip_sign(value, cos_negative(q));
+	}
+
+	template<func::Precision P, typename V>
+	inline void sincos(V x, V& sin_r, V& cos_r) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		if constexpr (P == func::Precision::standard)
+		{
+			if (any(not_le(abs(x), splat(x, reduction_limit<T>()))))
+			{
+				sin_r = per_lane(x, [](T value) { return trigo::sin(value); });
+				cos_r = per_lane(x, [](T value) { return trigo::cos(value); });
+				return;
+			}
+		}
+
+		V q;
+		const V r{ reduce_quadrant(x, q) };
+		const V s{ sin_poly<P>(r) };
+		const V c{ cos_poly<P>(r) };
+		const auto odd{ quadrant_odd(q) };
+
+		sin_r = flip_sign(select(odd, c, s), sin_negative(q));
+		cos_r = flip_sign(select(odd, s, c), cos_negative(q));
+	}
+
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V tan(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		if constexpr (P == func::Precision::standard)
+		{
+			if (any(not_le(abs(x), splat(x, reduction_limit<T>()))))
+				return per_lane(x, [](T value) { return trigo::tan(value); });
+		}
+
+		V q;
+		const V r{ reduce_quadrant(x, q) };
+		const V z{ mul(r, r) };
+
+		V value;
+
+		if constexpr (P == func::Precision::fast)
+			value = madd(mul(r, z), horner(z, tan_fast), r);
+		else if constexpr (std::is_same_v<T, float>)
+			value = madd(mul(r, z), horner(z, tan_f), r);
+		else
+			value = madd(mul(r, z), div(horner(z, tan_d_p), horner(z, tan_d_q)), r);
+
+		return select(quadrant_odd(q), div(splat(x, -1.0), value), value);
+	}
+
+	// Any x, |x| goes to [0, tan(pi/8)] (float grade) or [0, 0.66] (double grade) through
+	// atan(x) = pi/2 - atan(1/x) and atan(x) = pi/4 + atan((x - 1)/(x + 1))
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V atan(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+		constexpr bool rational{ std::is_same_v<T, double> && P != func::Precision::fast };
+
+		const V one{ splat(x, 1.0) };
+		const V a{ abs(x) };
+
+		const auto large{ gt(a, splat(x, 2.414213562373095048)) };
+		const auto middle{ mask_andnot(large, gt(a, splat(x, rational ? 0.66 : 0.4142135623730950488))) };
+
+		const V num{ select(large, splat(x, -1.0), select(middle, sub(a, one), a)) };
+		const V den{ select(large, a, select(middle, add(a, one), one)) };
+
+		const V t{ div(num, den) };
+		const V z{ mul(t, t) };
+
+		V result;
+
+		if constexpr (rational)
+		{
+			// pi/2 and pi/4 are short of 6.12e-17 and 3.06e-17 as doubles
+			result = madd(mul(t, z), div(horner(z, atan_d_p), horner(z, atan_d_q)), t);
+			result = add(result, select(large, splat(x, pio2_lo), select(middle, splat(x, 0.5 * pio2_lo), splat(x, 0.0))));
+		}
+		else if constexpr (P == func::Precision::fast)
+			result = madd(mul(t, z), horner(z, atan_fast), t);
+		else
+			result = madd(mul(t, z), horner(z, atan_f), t);
+
+		result = add(select(large, splat(x, pio2), select(middle, splat(x, pio4), splat(x, 0.0))), result);
+
+		return copysign(result, x);
+	}
+
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V atan2(V y, V x) noexcept
+	{
+		const V zero{ splat(x, 0.0) };
+		const V ax{ abs(x) }, ay{ abs(y) };
+
+		// atan of the ratio in [0, 1], 0/0 counts as 0 but 0/NaN stays NaN
+		const auto swap{ gt(ay, ax) };
+		const V num{ select(swap, ax, ay) };
+		const V den{ select(swap, ay, ax) };
+
+		V ratio{ select(mask_and(eq(num, zero), eq(den, den)), zero, div(num, den)) };
+
+		if constexpr (P == func::Precision::standard)
+		{
+			const V inf{ splat(x, std::numeric_limits<double>::infinity()) };
+			ratio = select(mask_and(eq(ax, inf), eq(ay, inf)), splat(x, 1.0), ratio);
+		}
+
+		V angle{ atan<P>(ratio) };
+
+		angle = select(swap, add(sub(splat(x, pio2), angle), splat(x, pio2_lo)), angle);
+		angle = select(lt(copysign(splat(x, 1.0), x), zero), add(sub(splat(x, pi), angle), splat(x, pi_lo)), angle);
+
+		return copysign(angle, y);
+	}
+
+	// asin(a) for a = |x| in [0, 1], float grade: a polynomial on [0, 0.5] and asin(a) = pi/2 - 2 asin(sqrt((1 - a) / 2)) past it,
+	// returns the polynomial part and sets large, the caller folds it back. NaN past 1
+	template<typename V>
+	[[nodiscard]] inline V asin_reduced(V a, decltype(gt(a, a))& large) noexcept
+	{
+		const V half{ splat(a, 0.5) };
+
+		large = gt(a, half);
+
+		const V z{ select(large, mul(half, sub(splat(a, 1.0), a)), mul(a, a)) };
+		const V s{ select(large, sqrt(z), a) };
+
+		return madd(mul(s, z), horner(z, asin_f), s);
+	}
+
+	// asin(x) = atan(x / sqrt(1 - x^2)) (double), asin_reduced (float and fast), NaN past [-1, 1]
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V asin(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		if constexpr (std::is_same_v<T, float> || P == func::Precision::fast)
+		{
+			decltype(gt(x, x)) large;
+			const V s{ asin_reduced(abs(x), large) };
+
+			// pi/2 as a float and its remainder, the subtraction cancels up to half of pi/2 near |x| = 0.5
+			const V folded{ add(sub(sub(splat(x, pio2), s), s), splat(x, pio2 - static_cast<float>(pio2))) };
+
+			return copysign(select(large, folded, s), x);
+		}
+		else
+		{
+			const V one{ splat(x, 1.0) };
+			return atan<P>(div(x, sqrt(mul(sub(one, x), add(one, x)))));
+		}
+	}
+
+	// acos(x) = 2 atan(sqrt((1 - x) / (1 + x))) (double), pi/2 - asin(x) or its reduced form (float and fast), NaN past [-1, 1]
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V acos(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		if constexpr (std::is_same_v<T, float> || P == func::Precision::fast)
+		{
+			// |x| <= 0.5: pi/2 - asin(x), x > 0.5: 2 s, x < -0.5: pi - 2 s
+			decltype(gt(x, x)) large;
+			const V s{ asin_reduced(abs(x), large) };
+			const V twice{ add(s, s) };
+
+			const V small_r{ sub(splat(x, pio2), copysign(s, x)) };
+			const V large_r{ select(lt(x, splat(x, 0.0)), sub(splat(x, pi), twice), twice) };
+
+			return select(large, large_r, small_r);
+		}
+		else
+		{
+			const V one{ splat(x, 1.0) };
+			const V half_angle{ atan<P>(sqrt(div(sub(one, x), add(one, x)))) };
+			return add(half_angle, half_angle);
+		}
+	}
+
+	// exp(x) = 2^n * exp(r) with r = x - n ln(2) in [-ln(2)/2, ln(2)/2],
+	// 2^n is applied in two halves so that subnormal results and overflow to inf come out right
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V exp(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+		constexpr bool single{ std::is_same_v<T, float> };
+
+		// max(low, x) returns x when x is NaN, min too
+		const V clamped{ min(splat(x, single ? 89.0 : 710.0), max(splat(x, single ? -104.0 : -746.0), x)) };
+		const V n{ round(mul(clamped, splat(x, 1.44269504088896340736))) };
+
+		// ln(2) = ln2_hi + ln2_lo, n * ln2_hi stays exact
+		V r{ madd(n, splat(x, single ? -0.693359375 : -6.93145751953125e-1), clamped) };
+		r = madd(n, splat(x, single ? 2.12194440e-4 : -1.42860682030941723212e-6), r);
+
+		const V head{ add(r, splat(x, 1.0)) };
+		V poly;
+
+		if constexpr (P == func::Precision::fast)
+			poly = madd(mul(r, r), horner(r, exp_fast), head);
+		else if constexpr (single)
+			poly = madd(mul(r, r), horner(r, exp_f), head);
+		else
+			poly = madd(mul(r, r), horner(r, exp_d), head);
+
+		const V n_low{ floor(mul(n, splat(x, 0.5))) };
+		return mul(mul(poly, pow2i(n_low)), pow2i(sub(n, n_low)));
+	}
+
+	// log(x) = e ln(2) + log(m) with m in [sqrt(1/2), sqrt(2)),
+	// log(m) = 2 atanh(s) = 2s + 2s^3/3 + 2s^5/5 + ... with s = (m - 1) / (m + 1)
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V log(V x) noexcept
+	{
+		using T = decltype(value_of(x));
+		constexpr bool single{ std::is_same_v<T, float> };
+
+		const V one{ splat(x, 1.0) };
+
+		V scaled{ x };
+		V exponent_shift{ splat(x, 0.0) };
+
+		if constexpr (P == func::Precision::standard)
+		{
+			// Subnormals are scaled back into the normal range first
+			const auto subnormal{ lt(x, splat(x, static_cast<double>(std::numeric_limits<T>::min()))) };
+			scaled = select(subnormal, mul(x, splat(x, single ? 33554432.0 : 18014398509481984.0)), x);
+			exponent_shift = select(subnormal, splat(x, single ? -25.0 : -54.0), exponent_shift);
+		}
+
+		V exponent;
+		V m{ split_exponent(scaled, exponent) };
+		exponent = add(exponent, exponent_shift);
+
+		const auto low{ lt(m, splat(x, 0.70710678118654752440)) };
+		m = select(low, add(m, m), m);
+		exponent = select(low, sub(exponent, one), exponent);
+
+		const V f{ sub(m, one) };
+		const V s{ div(f, add(f, splat(x, 2.0))) };
+		const V z{ mul(s, s) };
+
+		V log_m;
+
+		if constexpr (P == func::Precision::fast)
+			log_m = madd(mul(s, z), horner(z, log_fast), add(s, s));
+		else if constexpr (single)
+			log_m = madd(mul(s, z), horner(z, log_f), add(s, s));
+		else
+			log_m = madd(mul(s, z), horner(z, log_d), add(s, s));
+
+		// ln(2) = ln2_hi + ln2_lo, exponent * ln2_hi stays exact
+		V result{ madd(exponent, splat(x, single ? -2.12194440e-4 : 1.90821492927058770002e-10), log_m) };
+		result = madd(exponent, splat(x, single ? 0.693359375 : 6.93147180369123816490e-01), result);
+
+		if constexpr (P == func::Precision::standard)
+		{
+			const V inf{ splat(x, std::numeric_limits<double>::infinity()) };
+
+			result = select(eq(x, splat(x, 0.0)), sub(splat(x, 0.0), inf), result);
+			result = select(eq(x, inf), inf, result);
+			result = select(not_ge(x, splat(x, 0.0)), splat(x, std::numeric_limits<double>::quiet_NaN()), result);
+		}
+
+		return result;
+	}
+
+	// exp(y log|x|), float lanes go through double for standard
+	template<func::Precision P, typename V>
+	[[nodiscard]] inline V pow(V x, V y) noexcept
+	{
+		using T = decltype(value_of(x));
+
+		if constexpr (std::is_same_v<T, float> && P == func::Precision::standard)
+		{
+			if constexpr (sizeof(V) == sizeof(T))
+				return static_cast<float>(pow<P>(static_cast<double>(x), static_cast<double>(y)));
+#if defined(MPML_SIMD_SSE2)
+			else
+			{
+				DoubleLanes x_low, x_high, y_low, y_high;
+				widen(x, x_low, x_high);
+				widen(y, y_low, y_high);
+
+				return narrow(pow<P>(x_low, y_low), pow<P>(x_high, y_high));
+			}
+#endif
+		}
+		else
+		{
+			const V magnitude{ exp<P>(mul(y, log<P>(abs(x)))) };
+
+			if constexpr (P == func::Precision::fast)
+				return magnitude;
+			else
+			{
+				const V zero{ splat(x, 0.0) };
+				const V one{ splat(x, 1.0) };
+
+				// Negative bases: odd integral y keeps the sign, non integral y gives NaN (inf for -inf)
+				const V half_y{ mul(y, splat(x, 0.5)) };
+				const auto integral{ eq(round(y), y) };
+				const auto odd{ mask_and(integral, neq(round(half_y), half_y)) };
+
+				V result{ flip_sign(magnitude, mask_and(odd, lt(copysign(one, x), zero))) };
+				const auto finite_negative{ mask_and(lt(x, zero), gt(x, splat(x, -std::numeric_limits<double>::infinity()))) };
+				result = select(mask_andnot(integral, finite_negative), splat(x, std::numeric_limits<double>::quiet_NaN()), result);
+
+				// (+-1)^(+-inf) = 1, x^0 = 1 and 1^y = 1, NaN included
+				result = select(mask_and(eq(abs(x), one), eq(abs(y), splat(x, std::numeric_limits<double>::infinity()))), one, result);
+				return select(mask_or(eq(y, zero), eq(x, one)), one, result);
+			}
+		}
+	}
+
+
+	// Operations, one per function with the lane kernel and the strict reference
+
+#define MPML_BATCH_UNARY(name)																\
+	struct name##_op																		\
+	{																						\
+		template<func::Precision P, typename V>												\
+		[[nodiscard]] static V lanes(V x) noexcept { return batch::name<P>(x); }			\
+																							\
+		template<typename T>																\
+		[[nodiscard]] static T strict(T x) noexcept { return std::name(x); }				\
+	};
+
+#define MPML_BATCH_BINARY(name)																\
+	struct name##_op																		\
+	{																						\
+		template<func::Precision P, typename V>												\
+		[[nodiscard]] static V lanes(V a, V b) noexcept { return batch::name<P>(a, b); }	\
+																							\
+		template<typename T>																\
+		[[nodiscard]] static T strict(T a, T b) noexcept { return std::name(a, b); }		\
+	};
+
+	MPML_BATCH_UNARY(sin)
+	MPML_BATCH_UNARY(cos)
+	MPML_BATCH_UNARY(tan)
+	MPML_BATCH_UNARY(asin)
+	MPML_BATCH_UNARY(acos)
+	MPML_BATCH_UNARY(atan)
+	MPML_BATCH_UNARY(exp)
+	MPML_BATCH_UNARY(log)
+	MPML_BATCH_BINARY(atan2)
+	MPML_BATCH_BINARY(pow)
+
+#undef MPML_BATCH_UNARY
+#undef MPML_BATCH_BINARY
+
+
+	// Runs kernel over full registers, then over the padded tail
+	template<typename T, typename Kernel>
+	inline void map(std::span<const T> x, std::span<T> out, Kernel&& kernel) noexcept
+	{
+		const size_t count{ x.size() };
+		size_t index{};
+
+#if defined(MPML_SIMD_SSE2)
+		using V = decltype(lanes_of(T{}));
+		constexpr size_t width{ sizeof(V) / sizeof(T) };
+
+		for (; index + width <= count; index += width)
+			storeu(out.data() + index, kernel(loadu(x.data() + index, V{})));
+
+		if (index < count)
+		{
+			alignas(32) T tail[width]{};
+			std::copy(x.begin() + index, x.end(), tail);
+
+			storeu(tail, kernel(loadu(tail, V{})));
+			std::copy_n(tail, count - index, out.begin() + index);
+		}
+#else
+		for (; index < count; index++)
+			out[index] = kernel(x[index]);
+#endif
+	}
+
+	template<typename T, typename Kernel>
+	inline void map(std::span<const T> x, std::span<const T> y, std::span<T> out, Kernel&& kernel) noexcept
+	{
+		const size_t count{ x.size() };
+		size_t index{};
+
+#if defined(MPML_SIMD_SSE2)
+		using V = decltype(lanes_of(T{}));
+		constexpr size_t width{ sizeof(V) / sizeof(T) };
+
+		for (; index + width <= count; index += width)
+			storeu(out.data() + index, kernel(loadu(x.data() + index, V{}), loadu(y.data() + index, V{})));
+
+		if (index < count)
+		{
+			alignas(32) T tail_x[width]{};
+			alignas(32) T tail_y[width]{};
+			std::copy(x.begin() + index, x.end(), tail_x);
+			std::copy_n(y.begin() + index, count - index, tail_y);
+
+			storeu(tail_x, kernel(loadu(tail_x, V{}), loadu(tail_y, V{})));
+			std::copy_n(tail_x, count - index, out.begin() + index);
+		}
+#else
+		for (; index < count; index++)
+			out[index] = kernel(x[index], y[index]);
+#endif
+	}
+
+	template<typename Op, typename T>
+	inline void apply(std::span<const T> x, std::span<T> out, func::Precision precision) noexcept
+	{
+		assert(out.size() >= x.size() && "out is smaller than the input");
+
+		switch (precision)
+		{
+		case func::Precision::fast:
+			map(x, out, [](auto lanes) { return Op::template lanes<func::Precision::fast>(lanes); });
+			break;
+		case func::Precision::standard:
+			map(x, out, [](auto lanes) { return Op::template lanes<func::Precision::standard>(lanes); });
+			break;
+		default:
+			for (size_t index{}; index < x.size(); index++)
+				out[index] = Op::strict(x[index]);
+			break;
+		}
+	}
+
+	template<typename Op, typename T>
+	inline void apply(std::span<const T> x, std::span<const T> y, std::span<T> out, func::Precision precision) noexcept
+	{
+		assert(y.size() >= x.size() && "y is smaller than x");
+		assert(out.size() >= x.size() && "out is smaller than the input");
+
+		switch (precision)
+		{
+		case func::Precision::fast:
+			map(x, y, out, [](auto a, auto b) { return Op::template lanes<func::Precision::fast>(a, b); });
+			break;
+		case func::Precision::standard:
+			map(x, y, out, [](auto a, auto b) { return Op::template lanes<func::Precision::standard>(a, b); });
+			break;
+		default:
+			for (size_t index{}; index < x.size(); index++)
+				out[index] = Op::strict(x[index], y[index]);
+			break;
+		}
+	}
+
+	template<func::Precision P, typename T>
+	inline void sincos_lanes(std::span<const T> x, std::span<T> sin_out, std::span<T> cos_out) noexcept
+	{
+		const size_t count{ x.size() };
+		size_t index{};
+
+#if defined(MPML_SIMD_SSE2)
+		using V = decltype(lanes_of(T{}));
+		constexpr size_t width{ sizeof(V) / sizeof(T) };
+
+		for (; index + width <= count; index += width)
+		{
+			V sin_r, cos_r;
+			sincos<P>(loadu(x.data() + index, V{}), sin_r, cos_r);
+
+			storeu(sin_out.data() + index, sin_r);
+			storeu(cos_out.data() + index, cos_r);
+		}
+
+		if (index < count)
+		{
+			alignas(32) T tail[width]{};
+			alignas(32) T tail_cos[width];
+			std::copy(x.begin() + index, x.end(), tail);
+
+			V sin_r, cos_r;
+			sincos<P>(loadu(tail, V{}), sin_r, cos_r);
+
+			storeu(tail, sin_r);
+			storeu(tail_cos, cos_r);
+			std::copy_n(tail, count - index, sin_out.begin() + index);
+			std::copy_n(tail_cos, count - index, cos_out.begin() + index);
+		}
+#else
+		for (; index < count; index++)
+			sincos<P>(x[index], sin_out[index], cos_out[index]);
+#endif
+	}
+
+	template<typename T>
+	inline void sincos(std::span<const T> x, std::span<T> sin_out, std::span<T> cos_out, func::Precision precision) noexcept
+	{
+		assert(sin_out.size() >= x.size() && cos_out.size() >= x.size() && "out is smaller than the input");
+
+		switch (precision)
+		{
+		case func::Precision::fast:
+			sincos_lanes<func::Precision::fast>(x, sin_out, cos_out);
+			break;
+		case func::Precision::standard:
+			sincos_lanes<func::Precision::standard>(x, sin_out, cos_out);
+			break;
+		default:
+			for (size_t index{}; index < x.size(); index++)
+			{
+				sin_out[index] = std::sin(x[index]);
+				cos_out[index] = std::cos(x[index]);
+			}
+			break;
+		}
+	}
+
+	// Angle<T> only holds its value in radians
+	template<typename T>
+	[[nodiscard]] inline std::span<const T> radians(std::span<const Angle<T>> angles) noexcept
+	{
+		static_assert(sizeof(Angle<T>) == sizeof(T) && std::is_standard_layout_v<Angle<T>>, "Angle<T> must stay a plain T in radians");
+		return { reinterpret_cast<const T*>(angles.data()), angles.size() };
+	}
+
+	// atan2(|a x b|, a . b), by blocks so that the two arguments stay in the cache
+	template<typename T>
+	inline void angle_between(std::span<const Vector3<T>> a, std::span<const Vector3<T>> b, std::span<T> out, func::Precision precision) noexcept
+	{
+		assert(b.size() >= a.size() && "b is smaller than a");
+		assert(out.size() >= a.size() && "out is smaller than the input");
+
+		constexpr size_t block{ 256 };
+
+		alignas(32) T sines[block];
+		alignas(32) T cosines[block];
+
+		for (size_t first{}; first < a.size(); first += block)
+		{
+			const size_t count{ std::min(block, a.size() - first) };
+
+			for (size_t i{}; i < count; i++)
+			{
+				const Vector3<T>& u{ a[first + i] };
+				const Vector3<T>& v{ b[first + i] };
+
+				const T cross_x{ u.y * v.z - u.z * v.y };
+				const T cross_y{ u.z * v.x - u.x * v.z };
+				const T cross_z{ u.x * v.y - u.y * v.x };
+
+				sines[i] = std::sqrt(cross_x * cross_x + cross_y * cross_y + cross_z * cross_z);
+				cosines[i] = u.x * v.x + u.y * v.y + u.z * v.z;
+			}
+
+			apply<atan2_op, T>(std::span<const T>{ sines, count }, std::span<const T>{ cosines, count }, out.subspan(first, count), precision);
+		}
+	}
+
+} // mpml::detail::batch
+
+namespace mpml::func
+{
+
+	// Trigonometry, in radians
+
+	inline void sin(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::sin_op>(x, out, precision); }
+	inline void sin(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::sin_op>(x, out, precision); }
+	inline void sin(std::span<const Angle<float>> x, std::span<float> out, Precision precision = Precision::standard) noexcept { sin(detail::batch::radians(x), out, precision); }
+	inline void sin(std::span<const Angle<double>> x, std::span<double> out, Precision precision = Precision::standard) noexcept { sin(detail::batch::radians(x), out, precision); }
+
+	inline void cos(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::cos_op>(x, out, precision); }
+	inline void cos(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::cos_op>(x, out, precision); }
+	inline void cos(std::span<const Angle<float>> x, std::span<float> out, Precision precision = Precision::standard) noexcept { cos(detail::batch::radians(x), out, precision); }
+	inline void cos(std::span<const Angle<double>> x, std::span<double> out, Precision precision = Precision::standard) noexcept { cos(detail::batch::radians(x), out, precision); }
+
+	inline void tan(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::tan_op>(x, out, precision); }
+	inline void tan(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::tan_op>(x, out, precision); }
+	inline void tan(std::span<const Angle<float>> x, std::span<float> out, Precision precision = Precision::standard) noexcept { tan(detail::batch::radians(x), out, precision); }
+	inline void tan(std::span<const Angle<double>> x, std::span<double> out, Precision precision = Precision::standard) noexcept { tan(detail::batch::radians(x), out, precision); }
+
+	// Both from a single reduction
+	inline void sincos(std::span<const float> x, std::span<float> sin_out, std::span<float> cos_out, Precision precision = Precision::standard) noexcept { detail::batch::sincos(x, sin_out, cos_out, precision); }
+	inline void sincos(std::span<const double> x, std::span<double> sin_out, std::span<double> cos_out, Precision precision = Precision::standard) noexcept { detail::batch::sincos(x, sin_out, cos_out, precision); }
+	inline void sincos(std::span<const Angle<float>> x, std::span<float> sin_out, std::span<float> cos_out, Precision precision = Precision::standard) noexcept { sincos(detail::batch::radians(x), sin_out, cos_out, precision); }
+	inline void sincos(std::span<const Angle<double>> x, std::span<double> sin_out, std::span<double> cos_out, Precision precision = Precision::standard) noexcept { sincos(detail::batch::radians(x), sin_out, cos_out, precision); }
+
+
+	// Inverse trigonometry, in radians
+
+	inline void asin(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::asin_op>(x, out, precision); }
+	inline void asin(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::asin_op>(x, out, precision); }
+
+	inline void acos(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::acos_op>(x, out, precision); }
+	inline void acos(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::acos_op>(x, out, precision); }
+
+	inline void atan(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::atan_op>(x, out, precision); }
+	inline void atan(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::atan_op>(x, out, precision); }
+
+	inline void atan2(std::span<const float> y, std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::atan2_op>(y, x, out, precision); }
+	inline void atan2(std::span<const double> y, std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::atan2_op>(y, x, out, precision); }
+
+
+	// Exponentials
+
+	inline void exp(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::exp_op>(x, out, precision); }
+	inline void exp(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::exp_op>(x, out, precision); }
+
+	inline void log(std::span<const float> x, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::log_op>(x, out, precision); }
+	inline void log(std::span<const double> x, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::log_op>(x, out, precision); }
+
+	inline void pow(std::span<const float> x, std::span<const float> y, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::pow_op>(x, y, out, precision); }
+	inline void pow(std::span<const double> x, std::span<const double> y, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::apply<detail::batch::pow_op>(x, y, out, precision); }
+
+
+	// Angle in radians between a[i] and b[i], 0 when either is null
+	inline void angle_between(std::span<const Vector3<float>> a, std::span<const Vector3<float>> b, std::span<float> out, Precision precision = Precision::standard) noexcept { detail::batch::angle_between(a, b, out, precision); }
+	inline void angle_between(std::span<const Vector3<double>> a, std::span<const Vector3<double>> b, std::span<double> out, Precision precision = Precision::standard) noexcept { detail::batch::angle_between(a, b, out, precision); }
+
+}
@@ -0,0 +1,445 @@
+#pragma once // fast.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Approximate square roots and reciprocals for the paths that can trade precision for speed
+//
+// Note:
+//	mpml::fast mirrors length() and normal() of the vectors and the quaternion, and normalizes whole arrays and VecSoA in place.
+//	For float, rsqrt and rcp refine the 12-bit hardware estimates (rsqrtss/rsqrtps, rcpss/rcpps) with one Newton step.
+//	double has no such estimate: rsqrt takes three Newton steps from the bit trick estimate and rcp divides.
+//	The same three steps serve float during constant evaluation and without SIMD.
+//	A single float length is the exact length(): sqrtss beats rsqrtss, its Newton step and the multiply on one value,
+//	float packs and double keep the estimate.
+//	Measured against long double: float lengths and normals stay within 3.5e-7 relative error (rcp 2e-7),
+//	double ones within 3.2e-11.
+//	There is no branch on the length: the squared length is clamped to the smallest normal value of the type before rsqrt,
+//	null vectors come out null and vectors shorter than 1e-19 (float) or 1.5e-154 (double) get scaled up without reaching unit length.
+// ===================================================
+
+
+// Dependencies
+#include <bit>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <concepts>
+#include <type_traits>
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/pack.hpp"
+#include "mpml/vectors/vectors.hpp"
+#include "mpml/vectors/soa.hpp"
+#include "mpml/quaternions/quaternion.hpp"
+
+
+namespace mpml::detail::fast
+{
+
+	// Smallest normal value of T, the floor of the squared lengths
+	template<std::floating_point T>
+	inline constexpr T min_length_squared{ std::numeric_limits<T>::min() };
+
+	// y * (1.5 - 0.5 x y^2), the Newton step of 1/sqrt(x) from the estimate y, squares the relative error
+	template<std::floating_point T>
+	[[nodiscard]] constexpr T newton_rsqrt(T x, T y) noexcept
+	{
+		return y * (static_cast<T>(1.5) - static_cast<T>(0.5) * x * y * y);
+	}
+
+	// Bit trick estimates, within 3.5% before refinement
+	[[nodiscard]] constexpr float rsqrt_estimate(float x) noexcept
+	{
+		return std::bit_cast<float>(0x5F375A86u - (std::bit_cast<std::uint32_t>(x) >> 1));
+	}
+
+	[[nodiscard]] constexpr double rsqrt_estimate(double x) noexcept
+	{
+		return std::bit_cast<double>(0x5FE6EB50C7B537A9ull - (std::bit_cast<std::uint64_t>(x) >> 1));
+	}
+
+	// Three steps from the bit trick, 1e-10 in double, rounding bound in float
+	template<std::floating_point T>
+	[[nodiscard]] constexpr T refined_rsqrt_estimate(T x) noexcept
+	{
+		T y{ rsqrt_estimate(x) };
+
+		for (int step{}; step < 3; step++)
+			y = newton_rsqrt(x, y);
+
+		return y;
+	}
+
+#if defined(MPML_SIMD_SSE2)
+
+	[[nodiscard]] inline __m128 rsqrt(__m128 x) noexcept
+	{
+		const __m128 y{ _mm_rsqrt_ps(x) };
+		return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_mul_ps(y, y))));
+	}
+
+	// y * (2 - x y), the Newton step of 1/x from the estimate y
+	[[nodiscard]] inline __m128 rcp(__m128 x) noexcept
+	{
+		const __m128 y{ _mm_rcp_ps(x) };
+		return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(2.f), _mm_mul_ps(x, y)));
+	}
+
+#endif
+
+#if defined(MPML_SIMD_AVX)
+
+	[[nodiscard]] inline __m256 rsqrt(__m256 x) noexcept
+	{
+		const __m256 y{ _mm256_rsqrt_ps(x) };
+		return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), _mm256_mul_ps(y, y))));
+	}
+
+	[[nodiscard]] inline __m256 rcp(__m256 x) noexcept
+	{
+		const __m256 y{ _mm256_rcp_ps(x) };
+		return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(2.f), _mm256_mul_ps(x, y)));
+	}
+
+#endif
+
+#if !defined(MPML_SIMD_SSE2)
+
+	// Without SIMD the SoA lanes are single floats and never used, this keeps the lane code well-formed
+	[[nodiscard]] inline float rsqrt(float x) noexcept
+	{
+		return refined_rsqrt_estimate(x);
+	}
+
+#endif
+
+	// max(len_sqd, min_length_squared) without a branch, lane-wise for packs
+	template<typename T>
+	[[nodiscard]] constexpr T clamp_length_squared(const T& len_sqd) noexcept
+	{
+		if constexpr (is_pack_v<T>)
+			return max(len_sqd, T{ min_length_squared<typename T::value_type> });
+		else
+			return len_sqd > min_length_squared<T> ? len_sqd : min_length_squared<T>;
+	}
+
+} // mpml::detail::fast
+
+namespace mpml::fast
+{
+
+	// Scalars and packs
+
+	// 1 / sqrt(x), for positive normal x
+	template<std::floating_point T>
+	[[nodiscard]] constexpr T rsqrt(T x) noexcept
+	{
+		if constexpr (std::is_same_v<T, float>)
+		{
+#if defined(MPML_SIMD_SSE2)
+			if (!std::is_constant_evaluated())
+				return detail::fast::newton_rsqrt(x, _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x))));
+#endif
+
+			return detail::fast::refined_rsqrt_estimate(x);
+		}
+		else // SSE and AVX have no double estimate
+			return static_cast<T>(detail::fast::refined_rsqrt_estimate(static_cast<double>(x)));
+	}
+
+	// 1 / x, the estimate is only used for float
+	template<std::floating_point T>
+	[[nodiscard]] constexpr T rcp(T x) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const float y{ _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x))) };
+				return y * (2.f - x * y);
+			}
+		}
+#endif
+
+		return static_cast<T>(1) / x;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] constexpr Pack<T, N> rsqrt(const Pack<T, N>& x) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		if (!std::is_constant_evaluated())
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (detail::pack::is_sse<T, N>)
+			{
+				_mm_store_ps(pack_r.lanes.data(), detail::fast::rsqrt(_mm_load_ps(x.lanes.data())));
+				return pack_r;
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (detail::pack::is_avx<T, N>)
+			{
+				_mm256_store_ps(pack_r.lanes.data(), detail::fast::rsqrt(_mm256_load_ps(x.lanes.data())));
+				return pack_r;
+			}
+#endif
+		}
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = rsqrt(x.lanes[i]);
+
+		return pack_r;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] constexpr Pack<T, N> rcp(const Pack<T, N>& x) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		if (!std::is_constant_evaluated())
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (detail::pack::is_sse<T, N>)
+			{
+				_mm_store_ps(pack_r.lanes.data(), detail::fast::rcp(_mm_load_ps(x.lanes.data())));
+				return pack_r;
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (detail::pack::is_avx<T, N>)
+			{
+				_mm256_store_ps(pack_r.lanes.data(), detail::fast::rcp(_mm256_load_ps(x.lanes.data())));
+				return pack_r;
+			}
+#endif
+		}
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = rcp(x.lanes[i]);
+
+		return pack_r;
+	}
+
+
+	// Lengths, 0 for null vectors, a single float takes the exact length()
+
+	template<typename T>
+	[[nodiscard]] constexpr T length(const Vector2<T>& vec) noexcept
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return vec.length();
+		else
+		{
+			const T len_sqd{ vec.length_squared() };
+			return len_sqd * rsqrt(detail::fast::clamp_length_squared(len_sqd));
+		}
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr T length(const Vector3<T>& vec) noexcept
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return vec.length();
+		else
+		{
+			const T len_sqd{ vec.length_squared() };
+			return len_sqd * rsqrt(detail::fast::clamp_length_squared(len_sqd));
+		}
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr T length(const Vector3A<T>& vec) noexcept
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return vec.length();
+		else
+		{
+			const T len_sqd{ vec.length_squared() };
+			return len_sqd * rsqrt(detail::fast::clamp_length_squared(len_sqd));
+		}
+	}
+
+	// x, y and z only, as Vector4::length()
+	template<typename T>
+	[[nodiscard]] constexpr T length(const Vector4<T>& vec) noexcept
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return vec.length();
+		else
+		{
+			const T len_sqd{ vec.length_squared() };
+			return len_sqd * rsqrt(detail::fast::clamp_length_squared(len_sqd));
+		}
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr T length(const Quaternion<T>& q) noexcept
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return q.length();
+		else
+		{
+			const T len_sqd{ q.length_squared() };
+			return len_sqd * rsqrt(detail::fast::clamp_length_squared(len_sqd));
+		}
+	}
+
+
+	// Normals, null for null vectors
+
+	template<typename T>
+	[[nodiscard]] constexpr Vector2<T> normal(const Vector2<T>& vec) noexcept
+	{
+		const T inv_len{ rsqrt(detail::fast::clamp_length_squared(vec.length_squared())) };
+		return Vector2<T>{ vec.x * inv_len, vec.y * inv_len };
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Vector3<T> normal(const Vector3<T>& vec) noexcept
+	{
+		const T inv_len{ rsqrt(detail::fast::clamp_length_squared(vec.length_squared())) };
+		return Vector3<T>{ vec.x * inv_len, vec.y * inv_len, vec.z * inv_len };
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Vector3A<T> normal(const Vector3A<T>& vec) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const __m128 vec_r{ detail::simd::load(vec) };
+				const __m128 len_sqd{ _mm_max_ps(detail::simd::sum(_mm_mul_ps(vec_r, vec_r)), _mm_set1_ps(detail::fast::min_length_squared<float>)) };
+				return detail::simd::to_vector3a(_mm_mul_ps(vec_r, detail::fast::rsqrt(len_sqd)));
+			}
+		}
+#endif
+
+		const T inv_len{ rsqrt(detail::fast::clamp_length_squared(vec.length_squared())) };
+		return Vector3A<T>{ vec.x * inv_len, vec.y * inv_len, vec.z * inv_len };
+	}
+
+	// x, y and z only, w ends up as 1 as with Vector4::normal()
+	template<typename T>
+	[[nodiscard]] constexpr Vector4<T> normal(const Vector4<T>& vec) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const __m128 vec_r{ detail::simd::load(vec) };
+				const __m128 len_sqd{ _mm_max_ps(detail::simd::dot3(vec_r, vec_r), _mm_set1_ps(detail::fast::min_length_squared<float>)) };
+				return detail::simd::to_vector4(_mm_mul_ps(vec_r, detail::fast::rsqrt(len_sqd)));
+			}
+		}
+#endif
+
+		const T inv_len{ rsqrt(detail::fast::clamp_length_squared(vec.length_squared())) };
+		return Vector4<T>{ vec.x * inv_len, vec.y * inv_len, vec.z * inv_len };
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Quaternion<T> normal(const Quaternion<T>& q) noexcept
+	{
+		return Quaternion<T>{ q * rsqrt(detail::fast::clamp_length_squared(q.length_squared())) };
+	}
+
+
+	// Arrays, in place
+
+	inline void normalize(std::span<Vector3<float>> vecs) noexcept
+	{
+		size_t index{};
+
+#if defined(MPML_SIMD_AVX)
+		for (; index + 8 <= vecs.size(); index += 8)
+		{
+			__m256 x, y, z;
+			detail::simd::deinterleave3(&vecs[index].x, x, y, z);
+
+			const __m256 len_sqd{ detail::simd::madd(x, x, detail::simd::madd(y, y, _mm256_mul_ps(z, z))) };
+			const __m256 inv_len{ detail::fast::rsqrt(_mm256_max_ps(len_sqd, _mm256_set1_ps(detail::fast::min_length_squared<float>))) };
+
+			detail::simd::interleave3(&vecs[index].x, _mm256_mul_ps(x, inv_len), _mm256_mul_ps(y, inv_len), _mm256_mul_ps(z, inv_len));
+		}
+#endif
+#if defined(MPML_SIMD_SSE2)
+		for (; index + 4 <= vecs.size(); index += 4)
+		{
+			__m128 x, y, z;
+			detail::simd::deinterleave3(&vecs[index].x, x, y, z);
+
+			const __m128 len_sqd{ detail::simd::madd(x, x, detail::simd::madd(y, y, _mm_mul_ps(z, z))) };
+			const __m128 inv_len{ detail::fast::rsqrt(_mm_max_ps(len_sqd, _mm_set1_ps(detail::fast::min_length_squared<float>))) };
+
+			detail::simd::interleave3(&vecs[index].x, _mm_mul_ps(x, inv_len), _mm_mul_ps(y, inv_len), _mm_mul_ps(z, inv_len));
+		}
+#endif
+
+		for (; index < vecs.size(); index++)
+			vecs[index] = normal(vecs[index]);
+	}
+
+	inline void normalize(std::span<Vector3<double>> vecs) noexcept
+	{
+		for (Vector3<double>& vec : vecs)
+			vec = normal(vec);
+	}
+
+	inline void normalize(std::span<Quaternion<float>> quats) noexcept
+	{
+		for (Quaternion<float>& q : quats)
+			q = normal(q);
+	}
+
+	inline void normalize(std::span<Quaternion<double>> quats) noexcept
+	{
+		for (Quaternion<double>& q : quats)
+			q = normal(q);
+	}
+
+	// As VecSoA::normalize(), x, y and z only for 4D vectors
+	template<typename T, size_t N>
+	inline void normalize(VecSoA<T, N>& vecs) noexcept
+	{
+		constexpr size_t metric_size{ N == 4 ? 3 : N };
+
+		T* components[metric_size];
+
+		for (size_t c{}; c < metric_size; c++)
+			components[c] = vecs.component(c).data();
+
+		detail::soa::for_each<T>(vecs.padded_size(),
+			[&](auto i) {
+				using namespace detail::soa;
+
+				auto len_sqd{ mul(load(components[0] + i), load(components[0] + i)) };
+
+				for (size_t c{ 1 }; c < metric_size; c++)
+					len_sqd = add(len_sqd, mul(load(components[c] + i), load(components[c] + i)));
+
+				const auto inv_len{ detail::fast::rsqrt(max(len_sqd, set1(detail::fast::min_length_squared<T>))) };
+
+				for (size_t c{}; c < metric_size; c++)
+					store(components[c] + i, mul(load(components[c] + i), inv_len));
+			},
+			[&](auto i) {
+				T len_sqd{};
+
+				for (size_t c{}; c < metric_size; c++)
+					len_sqd += components[c][i] * components[c][i];
+
+				const T inv_len{ rsqrt(detail::fast::clamp_length_squared(len_sqd)) };
+
+				for (size_t c{}; c < metric_size; c++)
+					components[c][i] *= inv_len;
+			});
+	}
+
+}
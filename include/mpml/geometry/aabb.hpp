@@ -0,0 +1,297 @@
+#pragma once // aabb.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines axis-aligned bounding boxes, single and in packets of 8
+//
+// Note:
+//	A box spans [min, max] on every axis, bounds included. The default box is Empty (min = +inf, max = -inf):
+//	it contains nothing, expanding it by a point gives that point and uniting it with a box gives that box.
+//	AABBPacket stores 8 boxes one array per bound component, the layout the 1-ray-vs-8-boxes test of ray.hpp loads.
+//	Its unused lanes hold Empty boxes, which no ray hits.
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <stdexcept> // for: std::out_of_range()
+
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/vectors/transforms.hpp"
+
+
+namespace mpml
+{
+
+	template<typename T>
+	class AABB
+	{
+	public:
+
+		// Initialization
+
+		constexpr AABB() noexcept = default;
+
+		constexpr AABB(const Vector3<T>& min_, const Vector3<T>& max_) noexcept;
+
+		// The box holding only point
+		explicit constexpr AABB(const Vector3<T>& point) noexcept;
+
+
+		// Operations
+
+		// True when min > max on some axis, as for Empty
+		[[nodiscard]] constexpr bool empty() const noexcept;
+
+		[[nodiscard]] constexpr Vector3<T> center() const noexcept;
+		[[nodiscard]] constexpr Vector3<T> size() const noexcept;
+
+		// 0 for an empty box
+		[[nodiscard]] constexpr T surface_area() const noexcept;
+		[[nodiscard]] constexpr T volume() const noexcept;
+
+		// Index of the longest axis: 0 (x), 1 (y) or 2 (z)
+		[[nodiscard]] constexpr size_t longest_axis() const noexcept;
+
+		[[nodiscard]] constexpr bool contains(const Vector3<T>& point) const noexcept;
+		[[nodiscard]] constexpr bool contains(const AABB<T>& box) const noexcept;
+		[[nodiscard]] constexpr bool overlaps(const AABB<T>& box) const noexcept;
+
+		// Grows the box until it holds point / box
+		constexpr void expand(const Vector3<T>& point) noexcept;
+		constexpr void expand(const AABB<T>& box) noexcept;
+
+
+		// Class Members
+
+		Vector3<T> min{ std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
+		Vector3<T> max{ -std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity() };
+
+
+		static const AABB Empty;
+
+	};
+
+
+
+	// Common Types
+
+	template<typename T>
+	inline constexpr AABB<T> AABB<T>::Empty{};
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename T>
+	inline constexpr AABB<T>::AABB(const Vector3<T>& min_, const Vector3<T>& max_) noexcept
+		: min{ min_ }, max{ max_ }
+	{
+	}
+
+	template<typename T>
+	inline constexpr AABB<T>::AABB(const Vector3<T>& point) noexcept
+		: min{ point }, max{ point }
+	{
+	}
+
+
+	// Operations
+	template<typename T>
+	inline constexpr bool AABB<T>::empty() const noexcept
+	{
+		return min.x > max.x || min.y > max.y || min.z > max.z;
+	}
+
+	template<typename T>
+	inline constexpr Vector3<T> AABB<T>::center() const noexcept
+	{
+		return Vector3<T>{ (min.x + max.x) / T{ 2 }, (min.y + max.y) / T{ 2 }, (min.z + max.z) / T{ 2 } };
+	}
+
+	template<typename T>
+	inline constexpr Vector3<T> AABB<T>::size() const noexcept
+	{
+		return Vector3<T>{ max.x - min.x, max.y - min.y, max.z - min.z };
+	}
+
+	template<typename T>
+	inline constexpr T AABB<T>::surface_area() const noexcept
+	{
+		if (empty())
+			return T{};
+
+		const Vector3<T> size_r{ size() };
+		return T{ 2 } * (size_r.x * size_r.y + size_r.y * size_r.z + size_r.z * size_r.x);
+	}
+
+	template<typename T>
+	inline constexpr T AABB<T>::volume() const noexcept
+	{
+		if (empty())
+			return T{};
+
+		const Vector3<T> size_r{ size() };
+		return size_r.x * size_r.y * size_r.z;
+	}
+
+	template<typename T>
+	inline constexpr size_t AABB<T>::longest_axis() const noexcept
+	{
+		const Vector3<T> size_r{ size() };
+
+		if (size_r.x >= size_r.y && size_r.x >= size_r.z)
+			return 0;
+
+		return size_r.y >= size_r.z ? 1 : 2;
+	}
+
+	template<typename T>
+	inline constexpr bool AABB<T>::contains(const Vector3<T>& point) const noexcept
+	{
+		return point.x >= min.x && point.x <= max.x
+			&& point.y >= min.y && point.y <= max.y
+			&& point.z >= min.z && point.z <= max.z;
+	}
+
+	template<typename T>
+	inline constexpr bool AABB<T>::contains(const AABB<T>& box) const noexcept
+	{
+		return box.min.x >= min.x && box.max.x <= max.x
+			&& box.min.y >= min.y && box.max.y <= max.y
+			&& box.min.z >= min.z && box.max.z <= max.z;
+	}
+
+	template<typename T>
+	inline constexpr bool AABB<T>::overlaps(const AABB<T>& box) const noexcept
+	{
+		return box.min.x <= max.x && box.max.x >= min.x
+			&& box.min.y <= max.y && box.max.y >= min.y
+			&& box.min.z <= max.z && box.max.z >= min.z;
+	}
+
+	template<typename T>
+	inline constexpr void AABB<T>::expand(const Vector3<T>& point) noexcept
+	{
+		min = mpml::min(min, point);
+		max = mpml::max(max, point);
+	}
+
+	template<typename T>
+	inline constexpr void AABB<T>::expand(const AABB<T>& box) noexcept
+	{
+		min = mpml::min(min, box.min);
+		max = mpml::max(max, box.max);
+	}
+
+
+
+	// Functions
+
+	// Smallest box holding both
+	template<typename T>
+	[[nodiscard]] inline constexpr AABB<T> unite(const AABB<T>& a, const AABB<T>& b) noexcept
+	{
+		return AABB<T>{ mpml::min(a.min, b.min), mpml::max(a.max, b.max) };
+	}
+
+	template<typename T>
+	[[nodiscard]] inline constexpr AABB<T> unite(const AABB<T>& box, const Vector3<T>& point) noexcept
+	{
+		return AABB<T>{ mpml::min(box.min, point), mpml::max(box.max, point) };
+	}
+
+
+
+	// 8 boxes, one array per bound component
+	template<typename T>
+	class AABBPacket
+	{
+	public:
+
+		static constexpr size_t packet_size{ 8 };
+
+
+		// Initialization
+
+		// 8 Empty boxes
+		constexpr AABBPacket() noexcept = default;
+
+		// Up to 8 boxes, the remaining lanes stay Empty
+		explicit constexpr AABBPacket(std::span<const AABB<T>> boxes);
+
+
+		// Data related
+
+		[[nodiscard]] constexpr AABB<T> get(size_t index) const;
+		constexpr void set(size_t index, const AABB<T>& box);
+
+
+		// Class Members
+
+		alignas(32) std::array<T, packet_size> min_x{ filled(std::numeric_limits<T>::infinity()) };
+		alignas(32) std::array<T, packet_size> min_y{ filled(std::numeric_limits<T>::infinity()) };
+		alignas(32) std::array<T, packet_size> min_z{ filled(std::numeric_limits<T>::infinity()) };
+		alignas(32) std::array<T, packet_size> max_x{ filled(-std::numeric_limits<T>::infinity()) };
+		alignas(32) std::array<T, packet_size> max_y{ filled(-std::numeric_limits<T>::infinity()) };
+		alignas(32) std::array<T, packet_size> max_z{ filled(-std::numeric_limits<T>::infinity()) };
+
+	private:
+
+		[[nodiscard]] static constexpr std::array<T, packet_size> filled(T value) noexcept
+		{
+			std::array<T, packet_size> array_r{};
+			array_r.fill(value);
+			return array_r;
+		}
+	};
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename T>
+	inline constexpr AABBPacket<T>::AABBPacket(std::span<const AABB<T>> boxes)
+	{
+		if (boxes.size() > packet_size)
+			throw std::out_of_range("A packet holds 8 boxes");
+
+		for (size_t i{}; i < boxes.size(); i++)
+			set(i, boxes[i]);
+	}
+
+
+	// Data related
+	template<typename T>
+	inline constexpr AABB<T> AABBPacket<T>::get(size_t index) const
+	{
+		if (index >= packet_size)
+			throw std::out_of_range("Index out of range");
+
+		return AABB<T>{ Vector3<T>{ min_x[index], min_y[index], min_z[index] }, Vector3<T>{ max_x[index], max_y[index], max_z[index] } };
+	}
+
+	template<typename T>
+	inline constexpr void AABBPacket<T>::set(size_t index, const AABB<T>& box)
+	{
+		if (index >= packet_size)
+			throw std::out_of_range("Index out of range");
+
+		min_x[index] = box.min.x;
+		min_y[index] = box.min.y;
+		min_z[index] = box.min.z;
+		max_x[index] = box.max.x;
+		max_y[index] = box.max.y;
+		max_z[index] = box.max.z;
+	}
+
+
+
+} // mpml
@@ -0,0 +1,637 @@
+#pragma once // bvh.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines a bounding volume hierarchy over AABBs, built with a binned surface area heuristic
+//
+// Note:
+//	Nodes are flattened depth-first: the first child of an interior node is the next node, its offset is the second child.
+//	For float a node is 32 bytes (box, offset, primitive count, split axis), two per cache line.
+//	Leaves hold up to max_leaf_size primitives, stored contiguously in leaf order with their boxes next to each other.
+//	Every node picks among bin_count centroid bins per axis the split of lowest SAH cost, and becomes a leaf when that is cheaper.
+//	Subtrees of at least parallel_threshold primitives are built on their own std::jthread, link with Threads::Threads.
+//	The queries call visit(primitive) with the index of the primitive in the boxes given at build, in no particular order,
+//	raycast() visits the nearest nodes first so that the hits it is told about prune the rest.
+//	refit() moves the boxes without changing the tree: fast, but the tree quality degrades as the boxes move away from the build.
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <array>
+#include <vector>
+#include <thread>
+#include <limits>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/geometry/aabb.hpp"
+#include "mpml/geometry/ray.hpp"
+#include "mpml/geometry/frustum.hpp"
+
+
+namespace mpml
+{
+
+	template<typename T>
+	struct BVHHit
+	{
+		std::uint32_t primitive{};
+		T distance{};
+	};
+
+
+	template<typename T>
+	class BVH
+	{
+	public:
+
+		struct alignas(32) Node
+		{
+			AABB<T> bounds;
+			std::uint32_t offset{};		// interior: second child, leaf: first primitive in leaf order
+			std::uint16_t count{};		// primitives, 0 for an interior node
+			std::uint16_t axis{};		// split axis of an interior node
+
+			[[nodiscard]] constexpr bool leaf() const noexcept { return count != 0; }
+		};
+
+		static constexpr size_t max_leaf_size{ 4 };
+		static constexpr size_t bin_count{ 16 };
+		static constexpr size_t parallel_threshold{ 8192 };
+
+
+		// Initialization
+
+		BVH() noexcept = default;
+
+		// boxes must not be Empty, primitive i is boxes[i]
+		explicit BVH(std::span<const AABB<T>> boxes, size_t thread_count = std::thread::hardware_concurrency());
+
+
+		// Tree
+
+		[[nodiscard]] size_t size() const noexcept;
+		[[nodiscard]] bool empty() const noexcept;
+		[[nodiscard]] size_t depth() const noexcept;
+
+		[[nodiscard]] std::span<const Node> nodes() const noexcept;
+
+		// Leaf order to primitive index
+		[[nodiscard]] std::span<const std::uint32_t> primitives() const noexcept;
+
+		// Bounds of all the primitives, Empty for an empty tree
+		[[nodiscard]] AABB<T> bounds() const noexcept;
+
+
+		// Queries
+
+		// visit(primitive, entry distance) for every primitive box the ray enters within [t_min, t_max], nearest subtrees first
+		// visit returns the distance of a hit on the primitive, or std::nullopt, a hit closer than t_max becomes the new t_max
+		template<typename F>
+		void raycast(const Ray<T>& ray, T t_min, T t_max, F&& visit) const;
+
+		// Nearest primitive box along the ray
+		[[nodiscard]] std::optional<BVHHit<T>> closest_hit(const Ray<T>& ray, T t_min = T{}, T t_max = std::numeric_limits<T>::infinity()) const;
+
+		// visit(primitive) for every primitive box overlapping box
+		template<typename F>
+		void query_overlap(const AABB<T>& box, F&& visit) const;
+
+		// visit(primitive) for every primitive box intersecting the frustum, subtrees fully inside are not tested further
+		template<typename F>
+		void query_frustum(const Frustum<T>& frustum, F&& visit) const;
+
+
+		// Animation
+
+		// boxes holds the new box of every primitive, in build order
+		void refit(std::span<const AABB<T>> boxes);
+
+
+	private:
+
+		// Pending nodes of a traversal, depth past max_sah_depth switches to median splits so the stack never overflows
+		static constexpr size_t max_sah_depth{ 64 };
+		static constexpr size_t stack_size{ 128 };
+
+		// Primitives are sorted in place into leaf order during the build, bounds and centroids travel with them
+		struct BuildPrimitive
+		{
+			AABB<T> box;
+			Vector3<T> centroid;
+			std::uint32_t index{};
+		};
+
+		// Builds prims, which starts at first in leaf order, into nodes_r and returns the depth of the subtree
+		// bounds and centroid_bounds are those of prims, the parent has them from its split
+		size_t build(std::span<BuildPrimitive> prims, size_t first, const AABB<T>& bounds, const AABB<T>& centroid_bounds, size_t level, size_t threads, std::vector<Node>& nodes_r);
+
+		std::vector<Node> node_list;
+		std::vector<std::uint32_t> leaf_order;
+		std::vector<AABB<T>> leaf_boxes;
+		size_t depth_value{};
+	};
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename T>
+	inline BVH<T>::BVH(std::span<const AABB<T>> boxes, size_t thread_count)
+	{
+		if (boxes.size() >= std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error("Too many primitives");
+
+		if (boxes.empty())
+			return;
+
+		std::vector<BuildPrimitive> prims(boxes.size());
+
+		AABB<T> bounds_r{};
+		AABB<T> centroid_bounds{};
+
+		for (size_t i{}; i < boxes.size(); i++)
+		{
+			assert(!boxes[i].empty() && "BVH: primitive boxes must not be empty");
+
+			prims[i] = BuildPrimitive{ boxes[i], boxes[i].center(), static_cast<std::uint32_t>(i) };
+
+			bounds_r.expand(prims[i].box);
+			centroid_bounds.expand(prims[i].centroid);
+		}
+
+		node_list.reserve(2 * boxes.size() / max_leaf_size + 1);
+		depth_value = build(prims, 0, bounds_r, centroid_bounds, 0, std::max<size_t>(thread_count, 1), node_list);
+
+		leaf_order.resize(prims.size());
+		leaf_boxes.resize(prims.size());
+
+		for (size_t i{}; i < prims.size(); i++)
+		{
+			leaf_order[i] = prims[i].index;
+			leaf_boxes[i] = prims[i].box;
+		}
+	}
+
+	template<typename T>
+	inline size_t BVH<T>::build(std::span<BuildPrimitive> prims, size_t first, const AABB<T>& bounds, const AABB<T>& centroid_bounds, size_t level, size_t threads, std::vector<Node>& nodes_r)
+	{
+		const size_t index{ nodes_r.size() };
+		const size_t count{ prims.size() };
+
+		nodes_r.push_back(Node{ bounds });
+
+		if (count == 1)
+		{
+			nodes_r[index].offset = static_cast<std::uint32_t>(first);
+			nodes_r[index].count = 1;
+			return 1;
+		}
+
+		const Vector3<T> extent{ centroid_bounds.size() };
+
+		size_t split_axis{ centroid_bounds.longest_axis() };
+		size_t mid{ count / 2 };
+
+		AABB<T> left_bounds{}, right_bounds{};
+		AABB<T> left_centroids{}, right_centroids{};
+
+		if (extent[split_axis] <= T{} || level >= max_sah_depth)
+		{
+			// All the centroids on one point, or a degenerate distribution that SAH keeps splitting off one side:
+			// object median splits, which bound the remaining depth by log2(count)
+			if (extent[split_axis] <= T{} && count <= max_leaf_size)
+			{
+				nodes_r[index].offset = static_cast<std::uint32_t>(first);
+				nodes_r[index].count = static_cast<std::uint16_t>(count);
+				return 1;
+			}
+
+			std::nth_element(prims.begin(), prims.begin() + mid, prims.end(), [&](const BuildPrimitive& a, const BuildPrimitive& b) {
+				return a.centroid[split_axis] < b.centroid[split_axis];
+			});
+
+			for (size_t i{}; i < count; i++)
+			{
+				(i < mid ? left_bounds : right_bounds).expand(prims[i].box);
+				(i < mid ? left_centroids : right_centroids).expand(prims[i].centroid);
+			}
+		}
+		else
+		{
+			struct Bin
+			{
+				AABB<T> bounds;
+				size_t count{};
+			};
+
+			// Small nodes do not need more bins than primitives, sweeping the empty ones would cost more than binning
+			const size_t bins_used{ std::min(bin_count, count) };
+
+			std::array<T, 3> scales{};
+			for (size_t axis{}; axis < 3; axis++)
+				scales[axis] = extent[axis] > T{} ? static_cast<T>(bins_used) / extent[axis] : T{};
+
+			const auto bin_of{ [&](const Vector3<T>& centroid, size_t axis) {
+				const T position{ (centroid[axis] - centroid_bounds.min[axis]) * scales[axis] };
+				return std::min(static_cast<size_t>(std::max(position, T{})), bins_used - 1);
+			} };
+
+			std::array<std::array<Bin, bin_count>, 3> bins{};
+
+			for (const BuildPrimitive& prim : prims)
+			{
+				for (size_t axis{}; axis < 3; axis++)
+				{
+					Bin& bin{ bins[axis][bin_of(prim.centroid, axis)] };
+					bin.bounds.expand(prim.box);
+					bin.count++;
+				}
+			}
+
+			// Cost of a split relative to the parent: 1 traversal + area-weighted primitive tests
+			T best_cost{ std::numeric_limits<T>::infinity() };
+			size_t best_bin{};
+
+			for (size_t axis{}; axis < 3; axis++)
+			{
+				if (extent[axis] <= T{})
+					continue;
+
+				// Bounds and count of the bins right of each split, swept backwards
+				std::array<AABB<T>, bin_count> right_sweep{};
+				std::array<size_t, bin_count> right_counts{};
+
+				AABB<T> right{};
+				size_t right_count{};
+
+				for (size_t b{ bins_used - 1 }; b > 0; b--)
+				{
+					right.expand(bins[axis][b].bounds);
+					right_count += bins[axis][b].count;
+
+					right_sweep[b] = right;
+					right_counts[b] = right_count;
+				}
+
+				AABB<T> left{};
+				size_t left_count{};
+
+				for (size_t b{ 1 }; b < bins_used; b++)
+				{
+					left.expand(bins[axis][b - 1].bounds);
+					left_count += bins[axis][b - 1].count;
+
+					if (left_count == 0 || right_counts[b] == 0)
+						continue;
+
+					const T cost{ left.surface_area() * static_cast<T>(left_count) + right_sweep[b].surface_area() * static_cast<T>(right_counts[b]) };
+
+					if (cost < best_cost)
+					{
+						best_cost = cost;
+						best_bin = b;
+						split_axis = axis;
+						left_bounds = left;
+						right_bounds = right_sweep[b];
+					}
+				}
+			}
+
+			const T parent_area{ bounds.surface_area() };
+			const T split_cost{ parent_area > T{} ? T{ 1 } + best_cost / parent_area : T{ 1 } };
+
+			if (count <= max_leaf_size && static_cast<T>(count) <= split_cost)
+			{
+				nodes_r[index].offset = static_cast<std::uint32_t>(first);
+				nodes_r[index].count = static_cast<std::uint16_t>(count);
+				return 1;
+			}
+
+			// Partition around the best bin, gathering the centroid bounds of both sides on the way
+			size_t left_end{}, right_begin{ count };
+
+			while (left_end < right_begin)
+			{
+				if (bin_of(prims[left_end].centroid, split_axis) < best_bin)
+				{
+					left_centroids.expand(prims[left_end].centroid);
+					left_end++;
+				}
+				else
+				{
+					std::swap(prims[left_end], prims[--right_begin]);
+					right_centroids.expand(prims[right_begin].centroid);
+				}
+			}
+
+			mid = left_end;
+		}
+
+		nodes_r[index].axis = static_cast<std::uint16_t>(split_axis);
+
+		const std::span<BuildPrimitive> left_prims{ prims.first(mid) };
+		const std::span<BuildPrimitive> right_prims{ prims.subspan(mid) };
+
+		// Large subtrees hand their second child to another thread with half of the remaining ones, it is spliced in after the first
+		if (threads > 1 && count >= parallel_threshold)
+		{
+			std::vector<Node> right_nodes;
+			std::exception_ptr right_error;
+			size_t right_depth{};
+
+			std::optional<std::jthread> worker;
+
+			try
+			{
+				worker.emplace([&] {
+					try
+					{
+						right_depth = build(right_prims, first + mid, right_bounds, right_centroids, level + 1, threads / 2, right_nodes);
+					}
+					catch (...)
+					{
+						right_error = std::current_exception();
+					}
+				});
+			}
+			catch (const std::system_error&)
+			{
+				// No thread available, both children are built here
+			}
+
+			if (worker)
+			{
+				const size_t left_depth{ build(left_prims, first, left_bounds, left_centroids, level + 1, threads - threads / 2, nodes_r) };
+				worker.reset();
+
+				if (right_error)
+					std::rethrow_exception(right_error);
+
+				const std::uint32_t base{ static_cast<std::uint32_t>(nodes_r.size()) };
+				nodes_r[index].offset = base;
+
+				for (Node node : right_nodes)
+				{
+					if (!node.leaf())
+						node.offset += base;
+
+					nodes_r.push_back(node);
+				}
+
+				return 1 + std::max(left_depth, right_depth);
+			}
+		}
+
+		const size_t left_depth{ build(left_prims, first, left_bounds, left_centroids, level + 1, threads, nodes_r) };
+		nodes_r[index].offset = static_cast<std::uint32_t>(nodes_r.size());
+		const size_t right_depth{ build(right_prims, first + mid, right_bounds, right_centroids, level + 1, threads, nodes_r) };
+
+		return 1 + std::max(left_depth, right_depth);
+	}
+
+
+	// Tree
+	template<typename T>
+	inline size_t BVH<T>::size() const noexcept
+	{
+		return leaf_order.size();
+	}
+
+	template<typename T>
+	inline bool BVH<T>::empty() const noexcept
+	{
+		return leaf_order.empty();
+	}
+
+	template<typename T>
+	inline size_t BVH<T>::depth() const noexcept
+	{
+		return depth_value;
+	}
+
+	template<typename T>
+	inline std::span<const typename BVH<T>::Node> BVH<T>::nodes() const noexcept
+	{
+		return node_list;
+	}
+
+	template<typename T>
+	inline std::span<const std::uint32_t> BVH<T>::primitives() const noexcept
+	{
+		return leaf_order;
+	}
+
+	template<typename T>
+	inline AABB<T> BVH<T>::bounds() const noexcept
+	{
+		return node_list.empty() ? AABB<T>::Empty : node_list.front().bounds;
+	}
+
+
+	// Queries
+	template<typename T>
+	template<typename F>
+	inline void BVH<T>::raycast(const Ray<T>& ray, T t_min, T t_max, F&& visit) const
+	{
+		if (node_list.empty())
+			return;
+
+		// Going backwards along the split axis, the second child is the nearest
+		const std::array<bool, 3> backwards{ ray.direction().x < T{}, ray.direction().y < T{}, ray.direction().z < T{} };
+
+		std::array<std::uint32_t, stack_size> stack;
+		size_t stack_top{};
+		std::uint32_t current{};
+
+		while (true)
+		{
+			const Node& node{ node_list[current] };
+
+			if (ray.intersect(node.bounds, t_min, t_max))
+			{
+				if (node.leaf())
+				{
+					for (size_t i{ node.offset }; i < node.offset + node.count; i++)
+					{
+						const std::optional<T> entry{ ray.intersect(leaf_boxes[i], t_min, t_max) };
+
+						if (!entry)
+							continue;
+
+						const std::optional<T> hit{ visit(leaf_order[i], *entry) };
+
+						if (hit && *hit < t_max)
+							t_max = *hit;
+					}
+				}
+				else if (backwards[node.axis])
+				{
+					stack[stack_top++] = current + 1;
+					current = node.offset;
+					continue;
+				}
+				else
+				{
+					stack[stack_top++] = node.offset;
+					current++;
+					continue;
+				}
+			}
+
+			if (stack_top == 0)
+				return;
+
+			current = stack[--stack_top];
+		}
+	}
+
+	template<typename T>
+	inline std::optional<BVHHit<T>> BVH<T>::closest_hit(const Ray<T>& ray, T t_min, T t_max) const
+	{
+		std::optional<BVHHit<T>> hit_r;
+
+		raycast(ray, t_min, t_max, [&](std::uint32_t primitive, T entry) -> std::optional<T> {
+			if (!hit_r || entry < hit_r->distance)
+				hit_r = BVHHit<T>{ primitive, entry };
+
+			return entry;
+		});
+
+		return hit_r;
+	}
+
+	template<typename T>
+	template<typename F>
+	inline void BVH<T>::query_overlap(const AABB<T>& box, F&& visit) const
+	{
+		if (node_list.empty())
+			return;
+
+		std::array<std::uint32_t, stack_size> stack;
+		size_t stack_top{};
+		std::uint32_t current{};
+
+		while (true)
+		{
+			const Node& node{ node_list[current] };
+
+			if (node.bounds.overlaps(box))
+			{
+				if (node.leaf())
+				{
+					for (size_t i{ node.offset }; i < node.offset + node.count; i++)
+					{
+						if (leaf_boxes[i].overlaps(box))
+							visit(leaf_order[i]);
+					}
+				}
+				else
+				{
+					stack[stack_top++] = node.offset;
+					current++;
+					continue;
+				}
+			}
+
+			if (stack_top == 0)
+				return;
+
+			current = stack[--stack_top];
+		}
+	}
+
+	template<typename T>
+	template<typename F>
+	inline void BVH<T>::query_frustum(const Frustum<T>& frustum, F&& visit) const
+	{
+		if (node_list.empty())
+			return;
+
+		// The high bit of a stack entry marks a subtree already known to be inside
+		constexpr std::uint32_t inside_bit{ std::uint32_t{ 1 } << 31 };
+
+		std::array<std::uint32_t, stack_size> stack;
+		size_t stack_top{};
+		std::uint32_t current{};
+
+		while (true)
+		{
+			const Node& node{ node_list[current & ~inside_bit] };
+
+			bool inside{ (current & inside_bit) != 0 };
+
+			if (inside || frustum.intersects_aabb(node.bounds.min, node.bounds.max))
+			{
+				inside = inside || frustum.contains_aabb(node.bounds.min, node.bounds.max);
+
+				if (node.leaf())
+				{
+					for (size_t i{ node.offset }; i < node.offset + node.count; i++)
+					{
+						if (inside || frustum.intersects_aabb(leaf_boxes[i].min, leaf_boxes[i].max))
+							visit(leaf_order[i]);
+					}
+				}
+				else
+				{
+					const std::uint32_t flag{ inside ? inside_bit : 0 };
+
+					stack[stack_top++] = node.offset | flag;
+					current = ((current & ~inside_bit) + 1) | flag;
+					continue;
+				}
+			}
+
+			if (stack_top == 0)
+				return;
+
+			current = stack[--stack_top];
+		}
+	}
+
+
+	// Animation
+	template<typename T>
+	inline void BVH<T>::refit(std::span<const AABB<T>> boxes)
+	{
+		if (boxes.size() != leaf_order.size())
+			throw std::invalid_argument("refit needs one box per primitive");
+
+		for (size_t i{}; i < leaf_order.size(); i++)
+			leaf_boxes[i] = boxes[leaf_order[i]];
+
+		// Children come after their parent, so a backward pass sees both children before the parent
+		for (size_t i{ node_list.size() }; i-- > 0;)
+		{
+			Node& node{ node_list[i] };
+
+			if (node.leaf())
+			{
+				AABB<T> bounds_r{};
+
+				for (size_t p{ node.offset }; p < node.offset + node.count; p++)
+					bounds_r.expand(leaf_boxes[p]);
+
+				node.bounds = bounds_r;
+			}
+			else
+			{
+				node.bounds = unite(node_list[i + 1].bounds, node_list[node.offset].bounds);
+			}
+		}
+	}
+
+
+
+} // mpml
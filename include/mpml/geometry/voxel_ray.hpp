@@ -0,0 +1,667 @@
+#pragma once // voxel_ray.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines voxel grid traversal along a ray (Amanatides & Woo DDA), cell by cell, chunk by chunk and 8 rays at a time
+//
+// Note:
+//	Cell c spans [c * cell_size, (c + 1) * cell_size) on every axis, the traversal starts in the cell holding the origin
+//	and visits every cell the ray passes through, in order, up to max_distance (a ray distance t, as for Ray::at()).
+//	When the ray crosses several boundaries at the same distance it steps x first, then y, then z.
+//	Nothing is allocated: every traversal holds the cell, the distance of the next boundary per axis and the step per cell.
+//	ChunkedVoxelRay also follows the chunk holding the cell and the flat index of the cell in it (func::index_map),
+//	updated by one addition per step, and next_chunk() jumps straight to the first cell of the next chunk.
+//	Boundaries crossed at exactly the same distance are ordered x, y, z there too, so it lands on the cell next() reaches.
+//	The jump computes the exit distance instead of summing the steps though: where two boundaries are only equal up to
+//	the rounding of that sum, it can enter the next chunk through the neighbour of the cell next() would have reached.
+//	VoxelRayPacket steps 8 rays at once, 8 floats (AVX2) or 4 (SSE2) per instruction, 4 or 2 doubles,
+//	its cells are kept in T, exact up to 2^24 cells from the grid origin for float.
+//	A ray with an infinite max_distance never ends: stop it yourself, when a cell is solid for example.
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <array>
+#include <cmath>
+#include <cassert>
+#include <limits>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept> // for: std::out_of_range()
+
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/functions/basic.hpp"
+#include "mpml/functions/batch.hpp"
+#include "mpml/geometry/ray.hpp"
+
+
+namespace mpml
+{
+
+	template<typename T>
+	class ChunkedVoxelRay;
+
+	template<typename T>
+	class VoxelRayPacket;
+
+
+	template<typename T>
+	class VoxelRay
+	{
+		static_assert(std::is_floating_point_v<T>, "VoxelRay: T must be a floating point type");
+
+	public:
+
+		// Range-for over the cells, *it is the traversal itself
+		class Iterator
+		{
+		public:
+
+			using value_type = VoxelRay<T>;
+			using difference_type = std::ptrdiff_t;
+
+			constexpr Iterator() noexcept = default;
+			explicit constexpr Iterator(VoxelRay<T>* ray_) noexcept : ray{ ray_ } {}
+
+			[[nodiscard]] constexpr const VoxelRay<T>& operator*() const noexcept { return *ray; }
+			constexpr Iterator& operator++() noexcept { ray->next(); return *this; }
+			constexpr void operator++(int) noexcept { ray->next(); }
+
+			[[nodiscard]] friend constexpr bool operator==(const Iterator& it, std::default_sentinel_t) noexcept { return it.ray->done(); }
+
+		private:
+
+			VoxelRay<T>* ray{};
+		};
+
+
+		// Initialization
+
+		// Traversal finished from the start
+		constexpr VoxelRay() noexcept = default;
+
+		explicit constexpr VoxelRay(const Ray<T>& ray, T max_distance = std::numeric_limits<T>::infinity(), T cell_size = T{ 1 }) noexcept;
+
+		constexpr VoxelRay(const Vector3<T>& origin, const Vector3<T>& direction, T max_distance = std::numeric_limits<T>::infinity(), T cell_size = T{ 1 }) noexcept;
+
+
+		// Traversal
+
+		// Steps to the next cell, false (and done) when it starts past max_distance
+		constexpr bool next() noexcept;
+
+		[[nodiscard]] constexpr bool done() const noexcept;
+
+		[[nodiscard]] constexpr Iterator begin() noexcept;
+		[[nodiscard]] constexpr std::default_sentinel_t end() const noexcept;
+
+
+		// Current cell
+
+		[[nodiscard]] constexpr Vector3<int> cell() const noexcept;
+
+		// Distance at which the ray entered the cell, 0 for the first one
+		[[nodiscard]] constexpr T distance() const noexcept;
+
+		// Normal of the face the ray entered through, zero for the first cell
+		[[nodiscard]] constexpr Vector3<int> normal() const noexcept;
+
+
+	private:
+
+		friend class ChunkedVoxelRay<T>;
+		friend class VoxelRayPacket<T>;
+
+		std::array<int, 3> cell_value{};
+		std::array<int, 3> steps{};
+
+		// Distance of the next boundary per axis, and between two boundaries
+		std::array<T, 3> next_boundary{ std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
+		std::array<T, 3> deltas{ std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
+
+		T distance_value{};
+		T max_distance_value{ -std::numeric_limits<T>::infinity() };
+
+		// 3 for the first cell
+		size_t entered_axis{ 3 };
+		bool finished{ true };
+	};
+
+
+
+	// A VoxelRay that also follows the chunk of the cell, chunks being chunk_size^3 cells
+	template<typename T>
+	class ChunkedVoxelRay
+	{
+	public:
+
+		// Initialization
+
+		constexpr ChunkedVoxelRay() noexcept = default;
+
+		// Starts in the current cell of ray
+		constexpr ChunkedVoxelRay(const VoxelRay<T>& ray, int chunk_size) noexcept;
+
+
+		// Traversal
+
+		constexpr bool next() noexcept;
+
+		// Steps to the first cell of the next chunk without visiting the rest of this one, false (and done) past max_distance
+		constexpr bool next_chunk() noexcept;
+
+		[[nodiscard]] constexpr bool done() const noexcept;
+
+
+		// Current cell
+
+		[[nodiscard]] constexpr Vector3<int> cell() const noexcept;
+		[[nodiscard]] constexpr T distance() const noexcept;
+		[[nodiscard]] constexpr Vector3<int> normal() const noexcept;
+
+		[[nodiscard]] constexpr Vector3<int> chunk() const noexcept;
+
+		// Coordinates of the cell in its chunk, in [0, chunk_size)
+		[[nodiscard]] constexpr Vector3<int> local() const noexcept;
+
+		// func::index_map(local(), chunk_size)
+		[[nodiscard]] constexpr int index() const noexcept;
+
+
+	private:
+
+		VoxelRay<T> ray;
+
+		int size{ 1 };
+		std::array<int, 3> strides{ 1, 1, 1 };
+
+		std::array<int, 3> chunk_value{};
+		std::array<int, 3> local_value{};
+		int index_value{};
+	};
+
+
+
+	// 8 traversals stepped together, one array per component
+	template<typename T>
+	class VoxelRayPacket
+	{
+	public:
+
+		static constexpr size_t packet_size{ 8 };
+
+
+		// Initialization
+
+		// Every lane finished until set
+		constexpr VoxelRayPacket() noexcept = default;
+
+		// Up to 8 traversals, the remaining lanes stay finished
+		explicit constexpr VoxelRayPacket(std::span<const VoxelRay<T>> rays);
+
+
+		// Data related
+
+		// Lane index continues from the current state of ray
+		constexpr void set(size_t index, const VoxelRay<T>& ray);
+
+		// Bit k set while lane k has not finished
+		[[nodiscard]] constexpr unsigned lanes() const noexcept;
+
+
+		// Traversal
+
+		// Steps every lane still going to its next cell, returns lanes()
+		unsigned next() noexcept;
+
+
+		// Current cells
+
+		[[nodiscard]] constexpr Vector3<int> cell(size_t index) const;
+		[[nodiscard]] constexpr T distance(size_t index) const;
+		[[nodiscard]] constexpr Vector3<int> normal(size_t index) const;
+
+
+	private:
+
+		template<typename A>
+		using Lanes = std::array<A, packet_size>;
+
+		alignas(32) Lanes<T> cell_x{}, cell_y{}, cell_z{};
+		alignas(32) Lanes<T> step_x{}, step_y{}, step_z{};
+		alignas(32) Lanes<T> next_x{}, next_y{}, next_z{};
+		alignas(32) Lanes<T> delta_x{}, delta_y{}, delta_z{};
+		alignas(32) Lanes<T> distances{};
+
+		// -inf once a lane finished, which no boundary distance passes
+		alignas(32) Lanes<T> max_distances{ filled(-std::numeric_limits<T>::infinity()) };
+
+		// Entered axis as T, 3 for the first cell
+		alignas(32) Lanes<T> axes{ filled(T{ 3 }) };
+
+		unsigned active{};
+
+		[[nodiscard]] static constexpr Lanes<T> filled(T value) noexcept
+		{
+			Lanes<T> array_r{};
+			array_r.fill(value);
+			return array_r;
+		}
+	};
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename T>
+	inline constexpr VoxelRay<T>::VoxelRay(const Ray<T>& ray, T max_distance, T cell_size) noexcept
+		: max_distance_value{ max_distance }, finished{ !(max_distance >= T{}) }
+	{
+		const Vector3<T>& origin{ ray.origin() };
+		const Vector3<T>& inverse{ ray.inv_direction() };
+
+		const std::array<T, 3> origins{ origin.x, origin.y, origin.z };
+		const std::array<T, 3> inverses{ inverse.x, inverse.y, inverse.z };
+
+		for (size_t axis{}; axis < 3; axis++)
+		{
+			using std::floor;
+			cell_value[axis] = static_cast<int>(floor(origins[axis] / cell_size));
+
+			// A zero direction component has an infinite inverse: no step, the boundary is never reached
+			if (inverses[axis] == std::numeric_limits<T>::infinity())
+				continue;
+
+			steps[axis] = inverses[axis] > T{} ? 1 : -1;
+
+			const T boundary{ static_cast<T>(cell_value[axis] + (steps[axis] > 0 ? 1 : 0)) * cell_size };
+
+			next_boundary[axis] = (boundary - origins[axis]) * inverses[axis];
+			deltas[axis] = cell_size * (inverses[axis] > T{} ? inverses[axis] : -inverses[axis]);
+		}
+	}
+
+	template<typename T>
+	inline constexpr VoxelRay<T>::VoxelRay(const Vector3<T>& origin, const Vector3<T>& direction, T max_distance, T cell_size) noexcept
+		: VoxelRay{ Ray<T>{ origin, direction }, max_distance, cell_size }
+	{
+	}
+
+
+	// Traversal
+	template<typename T>
+	inline constexpr bool VoxelRay<T>::next() noexcept
+	{
+		if (finished)
+			return false;
+
+		// Selects rather than an indexed update: the axis changes from one step to the next as often as not
+		const bool x_first{ next_boundary[0] <= next_boundary[1] && next_boundary[0] <= next_boundary[2] };
+		const bool y_first{ !x_first && next_boundary[1] <= next_boundary[2] };
+		const bool z_first{ !x_first && !y_first };
+
+		const T boundary{ x_first ? next_boundary[0] : (y_first ? next_boundary[1] : next_boundary[2]) };
+
+		if (!(boundary <= max_distance_value))
+		{
+			finished = true;
+			return false;
+		}
+
+		cell_value[0] += x_first ? steps[0] : 0;
+		cell_value[1] += y_first ? steps[1] : 0;
+		cell_value[2] += z_first ? steps[2] : 0;
+
+		next_boundary[0] += x_first ? deltas[0] : T{};
+		next_boundary[1] += y_first ? deltas[1] : T{};
+		next_boundary[2] += z_first ? deltas[2] : T{};
+
+		const size_t axis{ x_first ? size_t{ 0 } : (y_first ? size_t{ 1 } : size_t{ 2 }) };
+
+		distance_value = boundary;
+		entered_axis = axis;
+
+		return true;
+	}
+
+	template<typename T>
+	inline constexpr bool VoxelRay<T>::done() const noexcept
+	{
+		return finished;
+	}
+
+	template<typename T>
+	inline constexpr typename VoxelRay<T>::Iterator VoxelRay<T>::begin() noexcept
+	{
+		return Iterator{ this };
+	}
+
+	template<typename T>
+	inline constexpr std::default_sentinel_t VoxelRay<T>::end() const noexcept
+	{
+		return std::default_sentinel;
+	}
+
+
+	// Current cell
+	template<typename T>
+	inline constexpr Vector3<int> VoxelRay<T>::cell() const noexcept
+	{
+		return Vector3<int>{ cell_value[0], cell_value[1], cell_value[2] };
+	}
+
+	template<typename T>
+	inline constexpr T VoxelRay<T>::distance() const noexcept
+	{
+		return distance_value;
+	}
+
+	template<typename T>
+	inline constexpr Vector3<int> VoxelRay<T>::normal() const noexcept
+	{
+		std::array<int, 3> normal_r{};
+
+		if (entered_axis < 3)
+			normal_r[entered_axis] = -steps[entered_axis];
+
+		return Vector3<int>{ normal_r[0], normal_r[1], normal_r[2] };
+	}
+
+
+
+	// Initialization
+	template<typename T>
+	inline constexpr ChunkedVoxelRay<T>::ChunkedVoxelRay(const VoxelRay<T>& ray_, int chunk_size) noexcept
+		: ray{ ray_ }, size{ chunk_size }, strides{ 1, chunk_size, chunk_size * chunk_size }
+	{
+		assert(chunk_size > 0 && "ChunkedVoxelRay: chunk_size must be positive");
+
+		for (size_t axis{}; axis < 3; axis++)
+		{
+			// Rounded down, cell -1 is in chunk -1
+			const int cell{ ray.cell_value[axis] };
+
+			chunk_value[axis] = (cell >= 0 ? cell : cell - (size - 1)) / size;
+			local_value[axis] = cell - chunk_value[axis] * size;
+		}
+
+		index_value = func::index_map(local_value[0], local_value[1], local_value[2], size);
+	}
+
+
+	// Traversal
+	template<typename T>
+	inline constexpr bool ChunkedVoxelRay<T>::next() noexcept
+	{
+		if (!ray.next())
+			return false;
+
+		// Every axis updated with selects, as in VoxelRay::next(), the one stepped moves by its step
+		for (size_t axis{}; axis < 3; axis++)
+		{
+			const int step{ axis == ray.entered_axis ? ray.steps[axis] : 0 };
+
+			local_value[axis] += step;
+
+			// The step again when it left the chunk, which wraps the local coordinate around
+			const int crossed{ static_cast<unsigned>(local_value[axis]) >= static_cast<unsigned>(size) ? step : 0 };
+
+			local_value[axis] -= crossed * size;
+			chunk_value[axis] += crossed;
+			index_value += (step - crossed * size) * strides[axis];
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	inline constexpr bool ChunkedVoxelRay<T>::next_chunk() noexcept
+	{
+		if (ray.finished)
+			return false;
+
+		// Cells left before the boundary of the chunk, and the distance at which the ray crosses it, per axis
+		std::array<int, 3> remaining{};
+		std::array<T, 3> exits{ std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
+
+		for (size_t axis{}; axis < 3; axis++)
+		{
+			if (ray.steps[axis] == 0)
+				continue;
+
+			remaining[axis] = ray.steps[axis] > 0 ? size - 1 - local_value[axis] : local_value[axis];
+			exits[axis] = ray.next_boundary[axis] + static_cast<T>(remaining[axis]) * ray.deltas[axis];
+		}
+
+		const size_t exit_axis{ exits[0] <= exits[1] ? (exits[0] <= exits[2] ? size_t{ 0 } : size_t{ 2 }) : (exits[1] <= exits[2] ? size_t{ 1 } : size_t{ 2 }) };
+		const T exit{ exits[exit_axis] };
+
+		if (!(exit <= ray.max_distance_value))
+		{
+			ray.finished = true;
+			return false;
+		}
+
+		for (size_t axis{}; axis < 3; axis++)
+		{
+			if (ray.steps[axis] == 0)
+				continue;
+
+			// Boundaries crossed before the exit, the ones on the exit axis take the ray out of the chunk.
+			// On a tie next() steps the lowest axis first: a boundary at exactly the exit is crossed on the axes before exit_axis only
+			int crossed{ remaining[axis] + 1 };
+
+			if (axis != exit_axis)
+			{
+				using std::ceil;
+				using std::floor;
+
+				const T boundaries{ (exit - ray.next_boundary[axis]) / ray.deltas[axis] };
+				const T before{ axis < exit_axis ? floor(boundaries) + 1 : ceil(boundaries) };
+
+				crossed = before > T{} ? std::min(static_cast<int>(before), remaining[axis]) : 0;
+			}
+
+			const int step{ ray.steps[axis] };
+
+			ray.cell_value[axis] += step * crossed;
+			ray.next_boundary[axis] += static_cast<T>(crossed) * ray.deltas[axis];
+
+			local_value[axis] += step * crossed;
+			index_value += step * crossed * strides[axis];
+		}
+
+		local_value[exit_axis] -= ray.steps[exit_axis] * size;
+		index_value -= ray.steps[exit_axis] * size * strides[exit_axis];
+		chunk_value[exit_axis] += ray.steps[exit_axis];
+
+		ray.distance_value = exit;
+		ray.entered_axis = exit_axis;
+
+		return true;
+	}
+
+	template<typename T>
+	inline constexpr bool ChunkedVoxelRay<T>::done() const noexcept
+	{
+		return ray.done();
+	}
+
+
+	// Current cell
+	template<typename T>
+	inline constexpr Vector3<int> ChunkedVoxelRay<T>::cell() const noexcept
+	{
+		return ray.cell();
+	}
+
+	template<typename T>
+	inline constexpr T ChunkedVoxelRay<T>::distance() const noexcept
+	{
+		return ray.distance();
+	}
+
+	template<typename T>
+	inline constexpr Vector3<int> ChunkedVoxelRay<T>::normal() const noexcept
+	{
+		return ray.normal();
+	}
+
+	template<typename T>
+	inline constexpr Vector3<int> ChunkedVoxelRay<T>::chunk() const noexcept
+	{
+		return Vector3<int>{ chunk_value[0], chunk_value[1], chunk_value[2] };
+	}
+
+	template<typename T>
+	inline constexpr Vector3<int> ChunkedVoxelRay<T>::local() const noexcept
+	{
+		return Vector3<int>{ local_value[0], local_value[1], local_value[2] };
+	}
+
+	template<typename T>
+	inline constexpr int ChunkedVoxelRay<T>::index() const noexcept
+	{
+		return index_value;
+	}
+
+
+
+	// Initialization
+	template<typename T>
+	inline constexpr VoxelRayPacket<T>::VoxelRayPacket(std::span<const VoxelRay<T>> rays)
+	{
+		if (rays.size() > packet_size)
+			throw std::out_of_range("A packet holds 8 traversals");
+
+		for (size_t i{}; i < rays.size(); i++)
+			set(i, rays[i]);
+	}
+
+
+	// Data related
+	template<typename T>
+	inline constexpr void VoxelRayPacket<T>::set(size_t index, const VoxelRay<T>& ray)
+	{
+		if (index >= packet_size)
+			throw std::out_of_range("Index out of range");
+
+		cell_x[index] = static_cast<T>(ray.cell_value[0]);
+		cell_y[index] = static_cast<T>(ray.cell_value[1]);
+		cell_z[index] = static_cast<T>(ray.cell_value[2]);
+		step_x[index] = static_cast<T>(ray.steps[0]);
+		step_y[index] = static_cast<T>(ray.steps[1]);
+		step_z[index] = static_cast<T>(ray.steps[2]);
+		next_x[index] = ray.next_boundary[0];
+		next_y[index] = ray.next_boundary[1];
+		next_z[index] = ray.next_boundary[2];
+		delta_x[index] = ray.deltas[0];
+		delta_y[index] = ray.deltas[1];
+		delta_z[index] = ray.deltas[2];
+
+		distances[index] = ray.distance_value;
+		max_distances[index] = ray.finished ? -std::numeric_limits<T>::infinity() : ray.max_distance_value;
+		axes[index] = static_cast<T>(ray.entered_axis);
+
+		active = (active & ~(1u << index)) | (static_cast<unsigned>(!ray.finished) << index);
+	}
+
+	template<typename T>
+	inline constexpr unsigned VoxelRayPacket<T>::lanes() const noexcept
+	{
+		return active;
+	}
+
+
+	// Traversal
+	template<typename T>
+	inline unsigned VoxelRayPacket<T>::next() noexcept
+	{
+		using namespace detail::batch;
+		using V = detail::SlabLanes<T>;
+
+		constexpr size_t width{ sizeof(V) / sizeof(T) };
+
+		const V zero{}, one{ splat(V{}, 1.0) }, two{ splat(V{}, 2.0) }, finished_lane{ splat(V{}, -std::numeric_limits<T>::infinity()) };
+
+		unsigned active_r{};
+
+		for (size_t i{}; i < packet_size; i += width)
+		{
+			const V nx{ loadu(next_x.data() + i, V{}) }, ny{ loadu(next_y.data() + i, V{}) }, nz{ loadu(next_z.data() + i, V{}) };
+			const V end{ loadu(max_distances.data() + i, V{}) };
+
+			// Same choice as VoxelRay::next(), x before y before z on ties
+			const auto x_first{ mask_and(ge(ny, nx), ge(nz, nx)) };
+			const auto y_first{ mask_andnot(x_first, ge(nz, ny)) };
+
+			const V boundary{ detail::batch::select(x_first, nx, detail::batch::select(y_first, ny, nz)) };
+			const auto going{ ge(end, boundary) };
+
+			const auto step_on_x{ mask_and(going, x_first) }, step_on_y{ mask_and(going, y_first) }, step_on_z{ mask_andnot(mask_or(x_first, y_first), going) };
+
+			storeu(cell_x.data() + i, add(loadu(cell_x.data() + i, V{}), detail::batch::select(step_on_x, loadu(step_x.data() + i, V{}), zero)));
+			storeu(cell_y.data() + i, add(loadu(cell_y.data() + i, V{}), detail::batch::select(step_on_y, loadu(step_y.data() + i, V{}), zero)));
+			storeu(cell_z.data() + i, add(loadu(cell_z.data() + i, V{}), detail::batch::select(step_on_z, loadu(step_z.data() + i, V{}), zero)));
+
+			storeu(next_x.data() + i, add(nx, detail::batch::select(step_on_x, loadu(delta_x.data() + i, V{}), zero)));
+			storeu(next_y.data() + i, add(ny, detail::batch::select(step_on_y, loadu(delta_y.data() + i, V{}), zero)));
+			storeu(next_z.data() + i, add(nz, detail::batch::select(step_on_z, loadu(delta_z.data() + i, V{}), zero)));
+
+			storeu(distances.data() + i, detail::batch::select(going, boundary, loadu(distances.data() + i, V{})));
+			storeu(axes.data() + i, detail::batch::select(going, detail::batch::select(x_first, zero, detail::batch::select(y_first, one, two)), loadu(axes.data() + i, V{})));
+			storeu(max_distances.data() + i, detail::batch::select(going, end, finished_lane));
+
+			active_r |= bits(going) << i;
+		}
+
+		active = active_r;
+
+		return active_r;
+	}
+
+
+	// Current cells
+	template<typename T>
+	inline constexpr Vector3<int> VoxelRayPacket<T>::cell(size_t index) const
+	{
+		if (index >= packet_size)
+			throw std::out_of_range("Index out of range");
+
+		return Vector3<int>{ static_cast<int>(cell_x[index]), static_cast<int>(cell_y[index]), static_cast<int>(cell_z[index]) };
+	}
+
+	template<typename T>
+	inline constexpr T VoxelRayPacket<T>::distance(size_t index) const
+	{
+		if (index >= packet_size)
+			throw std::out_of_range("Index out of range");
+
+		return distances[index];
+	}
+
+	template<typename T>
+	inline constexpr Vector3<int> VoxelRayPacket<T>::normal(size_t index) const
+	{
+		if (index >= packet_size)
+			throw std::out_of_range("Index out of range");
+
+		const std::array<T, 3> steps{ step_x[index], step_y[index], step_z[index] };
+		const size_t axis{ static_cast<size_t>(axes[index]) };
+
+		std::array<int, 3> normal_r{};
+
+		if (axis < 3)
+			normal_r[axis] = -static_cast<int>(steps[axis]);
+
+		return Vector3<int>{ normal_r[0], normal_r[1], normal_r[2] };
+	}
+
+
+
+} // mpml
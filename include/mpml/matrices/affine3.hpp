@@ -0,0 +1,508 @@
+#pragma once // affine3.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines a compact 3x4 affine matrix, a Matrix4 without its constant (0, 0, 0, 1) part
+//
+// Note:
+//	The three rows are stored as Vector4 (linear part | translation), so a point transforms as
+//	x' = a * x + b * y + c * z + d, and the same for the two other rows.
+//	This is the row-major 3x4 layout GPUs take for bone palettes and instance buffers (48 bytes for float).
+//	Compared to Matrix4 the storage is transposed: Affine3<T>{ mat4 } reads the translation from mat4.m, n, o,
+//	and products compose the same way, Affine3{ mat1 * mat2 } == Affine3{ mat1 } * Affine3{ mat2 }.
+// ===================================================
+
+
+#include <array>
+#include <algorithm>
+#include <optional>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/pack.hpp"
+
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/vectors/vector4.hpp"
+#include "mpml/matrices/matrix3.hpp"
+#include "mpml/matrices/matrix4.hpp"
+
+
+namespace mpml
+{
+
+
+	template<typename T>
+	class Affine3
+	{
+	public:
+
+		// Initialization
+
+		constexpr Affine3(const Affine3<T>&) noexcept = default;
+		constexpr Affine3<T>& operator=(const Affine3<T>&) noexcept = default;
+
+		constexpr Affine3(Affine3<T>&&) noexcept = default;
+		constexpr Affine3<T>& operator=(Affine3<T>&&) noexcept = default;
+
+
+		// Linear part only, no translation
+		constexpr Affine3(const Matrix3<T>& linear) noexcept;
+		constexpr Affine3(const Matrix3<T>& linear, const Vector3<T>& translation) noexcept;
+
+		// Drops the projective part of mat, exact for affine matrices
+		explicit constexpr Affine3(const Matrix4<T>& mat) noexcept;
+
+		constexpr Affine3(
+			const T& a = {}, const T& b = {}, const T& c = {}, const T& d = {},
+			const T& e = {}, const T& f = {}, const T& g = {}, const T& h = {},
+			const T& i = {}, const T& j = {}, const T& k = {}, const T& l = {}
+		) noexcept;
+
+		template<typename U>
+		constexpr Affine3(const Affine3<U>& mat) noexcept;
+
+		~Affine3() = default;
+
+
+		// Conversions
+
+		[[nodiscard]] constexpr operator Matrix4<T>() const noexcept;
+
+		[[nodiscard]] constexpr Matrix3<T> linear() const noexcept;
+		[[nodiscard]] constexpr Vector3<T> translation() const noexcept;
+
+
+		// Operations
+
+		// Determinant of the linear part
+		[[nodiscard]] constexpr T det() const noexcept;
+
+		[[nodiscard]] constexpr std::optional<Affine3<T>> inverse() const;
+		// Only valid for an orthonormal linear part, transposes it and inverts the translation
+		[[nodiscard]] constexpr Affine3<T> inverse_rigid() const noexcept;
+
+		// w = 1, the translation applies
+		[[nodiscard]] constexpr Vector3<T> transform_point(const Vector3<T>& vec) const noexcept;
+		// w = 0, only the linear part applies
+		[[nodiscard]] constexpr Vector3<T> transform_direction(const Vector3<T>& vec) const noexcept;
+
+
+		// Data related
+
+		[[nodiscard]] constexpr T* data_ptr() noexcept;
+		[[nodiscard]] constexpr const T* data_ptr() const noexcept;
+
+		[[nodiscard]] constexpr Vector4<T>& operator[](const size_t& index);
+		[[nodiscard]] constexpr const Vector4<T>& operator[](const size_t& index) const;
+
+
+		// Overloads
+
+		constexpr Affine3<T>& operator*=(const Affine3<T>& mat) noexcept;
+
+
+		// Class Members
+
+		union
+		{
+			struct
+			{
+				T a, b, c, d;
+				T e, f, g, h;
+				T i, j, k, l;
+			};
+
+			struct
+			{
+				Vector4<T> row0;
+				Vector4<T> row1;
+				Vector4<T> row2;
+			};
+
+			std::array<T, 12> data{};
+		};
+
+
+		static const Affine3 Identity;
+
+	};
+
+
+
+	// Common Types
+
+	template<typename T>
+	inline constexpr Affine3<T> Affine3<T>::Identity
+	{
+		T{1}, T{}, T{}, T{},
+		T{}, T{1}, T{}, T{},
+		T{}, T{}, T{1}, T{}
+	};
+
+
+	namespace detail
+	{
+		// Kernels behind operator*(Affine3, Affine3)
+		// Row r of the result is mat2's row r applied to the rows of mat1, plus mat2's translation.
+
+#if defined(MPML_SIMD_SSE2)
+
+		[[nodiscard]] inline __m128 multiply_row(const float* rhs, __m128 row0, __m128 row1, __m128 row2, __m128 w_mask) noexcept
+		{
+			const __m128 row{ _mm_loadu_ps(rhs) };
+
+			__m128 res{ _mm_and_ps(row, w_mask) };
+			res = simd::madd(simd::swizzle<0, 0, 0, 0>(row), row0, res);
+			res = simd::madd(simd::swizzle<1, 1, 1, 1>(row), row1, res);
+			return simd::madd(simd::swizzle<2, 2, 2, 2>(row), row2, res);
+		}
+
+		[[nodiscard]] inline Affine3<float> multiply(const Affine3<float>& mat1, const Affine3<float>& mat2) noexcept
+		{
+#if defined(MPML_SIMD_AVX)
+			// Rows 0 and 1 of the result at once, both halves of row0..row2 hold the same row of mat1
+			const __m256 rows0{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat1.row0.data_ptr())) };
+			const __m256 rows1{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat1.row1.data_ptr())) };
+			const __m256 rows2{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat1.row2.data_ptr())) };
+			const __m256 rhs{ _mm256_loadu_ps(mat2.row0.data_ptr()) };
+
+			__m256 res{ _mm256_and_ps(rhs, _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1))) };
+			res = simd::madd(_mm256_permute_ps(rhs, _MM_SHUFFLE(0, 0, 0, 0)), rows0, res);
+			res = simd::madd(_mm256_permute_ps(rhs, _MM_SHUFFLE(1, 1, 1, 1)), rows1, res);
+			res = simd::madd(_mm256_permute_ps(rhs, _MM_SHUFFLE(2, 2, 2, 2)), rows2, res);
+
+			Affine3<float> mat_r;
+
+			_mm256_storeu_ps(mat_r.row0.data_ptr(), res);
+			_mm_storeu_ps(mat_r.row2.data_ptr(), multiply_row(mat2.row2.data_ptr(), _mm256_castps256_ps128(rows0), _mm256_castps256_ps128(rows1),
+				_mm256_castps256_ps128(rows2), _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1))));
+
+			return mat_r;
+#else
+			const __m128 row0{ _mm_loadu_ps(mat1.row0.data_ptr()) };
+			const __m128 row1{ _mm_loadu_ps(mat1.row1.data_ptr()) };
+			const __m128 row2{ _mm_loadu_ps(mat1.row2.data_ptr()) };
+			const __m128 w_mask{ _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1)) };
+
+			Affine3<float> mat_r;
+
+			_mm_storeu_ps(mat_r.row0.data_ptr(), multiply_row(mat2.row0.data_ptr(), row0, row1, row2, w_mask));
+			_mm_storeu_ps(mat_r.row1.data_ptr(), multiply_row(mat2.row1.data_ptr(), row0, row1, row2, w_mask));
+			_mm_storeu_ps(mat_r.row2.data_ptr(), multiply_row(mat2.row2.data_ptr(), row0, row1, row2, w_mask));
+
+			return mat_r;
+#endif
+		}
+
+#endif
+
+#if defined(MPML_SIMD_AVX)
+
+		[[nodiscard]] inline __m256d multiply_row(const double* rhs, __m256d row0, __m256d row1, __m256d row2, __m256d w_mask) noexcept
+		{
+			__m256d res{ _mm256_and_pd(_mm256_loadu_pd(rhs), w_mask) };
+			res = simd::madd(_mm256_broadcast_sd(rhs), row0, res);
+			res = simd::madd(_mm256_broadcast_sd(rhs + 1), row1, res);
+			return simd::madd(_mm256_broadcast_sd(rhs + 2), row2, res);
+		}
+
+		[[nodiscard]] inline Affine3<double> multiply(const Affine3<double>& mat1, const Affine3<double>& mat2) noexcept
+		{
+			const __m256d row0{ _mm256_loadu_pd(mat1.row0.data_ptr()) };
+			const __m256d row1{ _mm256_loadu_pd(mat1.row1.data_ptr()) };
+			const __m256d row2{ _mm256_loadu_pd(mat1.row2.data_ptr()) };
+			const __m256d w_mask{ _mm256_castsi256_pd(_mm256_setr_epi64x(0, 0, 0, -1)) };
+
+			Affine3<double> mat_r;
+
+			_mm256_storeu_pd(mat_r.row0.data_ptr(), multiply_row(mat2.row0.data_ptr(), row0, row1, row2, w_mask));
+			_mm256_storeu_pd(mat_r.row1.data_ptr(), multiply_row(mat2.row1.data_ptr(), row0, row1, row2, w_mask));
+			_mm256_storeu_pd(mat_r.row2.data_ptr(), multiply_row(mat2.row2.data_ptr(), row0, row1, row2, w_mask));
+
+			return mat_r;
+		}
+
+#endif
+
+	} // detail
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename T>
+	inline constexpr Affine3<T>::Affine3(const Matrix3<T>& linear) noexcept
+		: Affine3{ linear, Vector3<T>{} }
+	{
+	}
+
+	template<typename T>
+	inline constexpr Affine3<T>::Affine3(const Matrix3<T>& linear, const Vector3<T>& translation) noexcept
+		: data
+		{
+			linear.data[0], linear.data[3], linear.data[6], translation.x,
+			linear.data[1], linear.data[4], linear.data[7], translation.y,
+			linear.data[2], linear.data[5], linear.data[8], translation.z
+		}
+	{
+	}
+
+	template<typename T>
+	inline constexpr Affine3<T>::Affine3(const Matrix4<T>& mat) noexcept
+		: data
+		{
+			mat.data[0], mat.data[4], mat.data[8], mat.data[12],
+			mat.data[1], mat.data[5], mat.data[9], mat.data[13],
+			mat.data[2], mat.data[6], mat.data[10], mat.data[14]
+		}
+	{
+	}
+
+	template<typename T>
+	inline constexpr Affine3<T>::Affine3(
+		const T& a, const T& b, const T& c, const T& d,
+		const T& e, const T& f, const T& g, const T& h,
+		const T& i, const T& j, const T& k, const T& l
+	) noexcept
+	{
+		data = { a, b, c, d,
+				 e, f, g, h,
+				 i, j, k, l
+		};
+	}
+
+	template<typename T>
+	template<typename U>
+	inline constexpr Affine3<T>::Affine3(const Affine3<U>& mat) noexcept
+	{
+		std::transform(mat.data.begin(), mat.data.end(), data.begin(), [](const U& x) { return static_cast<T>(x); });
+	}
+
+
+	// Conversions
+	template<typename T>
+	inline constexpr Affine3<T>::operator Matrix4<T>() const noexcept
+	{
+		return Matrix4<T>
+		{
+			data[0], data[4], data[8], T{},
+			data[1], data[5], data[9], T{},
+			data[2], data[6], data[10], T{},
+			data[3], data[7], data[11], T{ 1 }
+		};
+	}
+
+	template<typename T>
+	inline constexpr Matrix3<T> Affine3<T>::linear() const noexcept
+	{
+		return Matrix3<T>
+		{
+			data[0], data[4], data[8],
+			data[1], data[5], data[9],
+			data[2], data[6], data[10]
+		};
+	}
+
+	template<typename T>
+	inline constexpr Vector3<T> Affine3<T>::translation() const noexcept
+	{
+		return Vector3<T>{ data[3], data[7], data[11] };
+	}
+
+
+	// Operations
+	template<typename T>
+	inline constexpr T Affine3<T>::det() const noexcept
+	{
+		return data[0] * (data[5] * data[10] - data[6] * data[9])
+			- data[1] * (data[4] * data[10] - data[6] * data[8])
+			+ data[2] * (data[4] * data[9] - data[5] * data[8]);
+	}
+
+	template<typename T>
+	inline constexpr std::optional<Affine3<T>> Affine3<T>::inverse() const
+	{
+		const T co_a{ data[5] * data[10] - data[6] * data[9] };
+		const T co_e{ data[6] * data[8] - data[4] * data[10] };
+		const T co_i{ data[4] * data[9] - data[5] * data[8] };
+
+		const T determinant{ data[0] * co_a + data[1] * co_e + data[2] * co_i };
+
+		if constexpr (!is_pack_v<T>)
+		{
+			if (determinant == T{})
+				return std::nullopt;
+		}
+
+		const T inv_det{ T{ 1 } / determinant };
+
+		const T inv_a{ co_a * inv_det };
+		const T inv_b{ (data[2] * data[9] - data[1] * data[10]) * inv_det };
+		const T inv_c{ (data[1] * data[6] - data[2] * data[5]) * inv_det };
+		const T inv_e{ co_e * inv_det };
+		const T inv_f{ (data[0] * data[10] - data[2] * data[8]) * inv_det };
+		const T inv_g{ (data[2] * data[4] - data[0] * data[6]) * inv_det };
+		const T inv_i{ co_i * inv_det };
+		const T inv_j{ (data[1] * data[8] - data[0] * data[9]) * inv_det };
+		const T inv_k{ (data[0] * data[5] - data[1] * data[4]) * inv_det };
+
+		return std::optional<Affine3<T>>{ Affine3<T>
+		{
+			inv_a, inv_b, inv_c, -(inv_a * data[3] + inv_b * data[7] + inv_c * data[11]),
+			inv_e, inv_f, inv_g, -(inv_e * data[3] + inv_f * data[7] + inv_g * data[11]),
+			inv_i, inv_j, inv_k, -(inv_i * data[3] + inv_j * data[7] + inv_k * data[11])
+		} };
+	}
+
+	template<typename T>
+	inline constexpr Affine3<T> Affine3<T>::inverse_rigid() const noexcept
+	{
+		return Affine3<T>
+		{
+			data[0], data[4], data[8], -(data[0] * data[3] + data[4] * data[7] + data[8] * data[11]),
+			data[1], data[5], data[9], -(data[1] * data[3] + data[5] * data[7] + data[9] * data[11]),
+			data[2], data[6], data[10], -(data[2] * data[3] + data[6] * data[7] + data[10] * data[11])
+		};
+	}
+
+	template<typename T>
+	inline constexpr Vector3<T> Affine3<T>::transform_point(const Vector3<T>& vec) const noexcept
+	{
+		return Vector3<T>
+		{
+			data[0] * vec.x + data[1] * vec.y + data[2] * vec.z + data[3],
+			data[4] * vec.x + data[5] * vec.y + data[6] * vec.z + data[7],
+			data[8] * vec.x + data[9] * vec.y + data[10] * vec.z + data[11]
+		};
+	}
+
+	template<typename T>
+	inline constexpr Vector3<T> Affine3<T>::transform_direction(const Vector3<T>& vec) const noexcept
+	{
+		return Vector3<T>
+		{
+			data[0] * vec.x + data[1] * vec.y + data[2] * vec.z,
+			data[4] * vec.x + data[5] * vec.y + data[6] * vec.z,
+			data[8] * vec.x + data[9] * vec.y + data[10] * vec.z
+		};
+	}
+
+
+	// Data Related
+	template<typename T>
+	inline constexpr T* Affine3<T>::data_ptr() noexcept
+	{
+		return data.data();
+	}
+
+	template<typename T>
+	inline constexpr const T* Affine3<T>::data_ptr() const noexcept
+	{
+		return data.data();
+	}
+
+	template<typename T>
+	inline constexpr Vector4<T>& Affine3<T>::operator[](const size_t& index)
+	{
+		switch (index)
+		{
+		case 0:
+			return row0;
+			break;
+
+		case 1:
+			return row1;
+			break;
+
+		case 2:
+			return row2;
+			break;
+
+		default:
+			throw std::out_of_range("Index out of range");
+			break;
+		}
+	}
+
+	template<typename T>
+	inline constexpr const Vector4<T>& Affine3<T>::operator[](const size_t& index) const
+	{
+		switch (index)
+		{
+		case 0:
+			return row0;
+			break;
+
+		case 1:
+			return row1;
+			break;
+
+		case 2:
+			return row2;
+			break;
+
+		default:
+			throw std::out_of_range("Index out of range");
+			break;
+		}
+	}
+
+
+	// Member Overloads
+	template<typename T>
+	inline constexpr Affine3<T>& Affine3<T>::operator*=(const Affine3<T>& mat) noexcept
+	{
+		*this = *this * mat;
+		return *this;
+	}
+
+
+	// Non-member Overloads
+
+	// Same composition order as Matrix4: the result applies mat1 first, then mat2
+	template<typename T>
+	inline constexpr Affine3<T> operator*(const Affine3<T>& mat1, const Affine3<T>& mat2) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::multiply(mat1, mat2);
+		}
+#endif
+#if defined(MPML_SIMD_AVX)
+		if constexpr (std::is_same_v<T, double>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::multiply(mat1, mat2);
+		}
+#endif
+
+		return Affine3<T>
+		{
+			mat2.data[0] * mat1.data[0] + mat2.data[1] * mat1.data[4] + mat2.data[2] * mat1.data[8],
+			mat2.data[0] * mat1.data[1] + mat2.data[1] * mat1.data[5] + mat2.data[2] * mat1.data[9],
+			mat2.data[0] * mat1.data[2] + mat2.data[1] * mat1.data[6] + mat2.data[2] * mat1.data[10],
+			mat2.data[0] * mat1.data[3] + mat2.data[1] * mat1.data[7] + mat2.data[2] * mat1.data[11] + mat2.data[3],
+
+			mat2.data[4] * mat1.data[0] + mat2.data[5] * mat1.data[4] + mat2.data[6] * mat1.data[8],
+			mat2.data[4] * mat1.data[1] + mat2.data[5] * mat1.data[5] + mat2.data[6] * mat1.data[9],
+			mat2.data[4] * mat1.data[2] + mat2.data[5] * mat1.data[6] + mat2.data[6] * mat1.data[10],
+			mat2.data[4] * mat1.data[3] + mat2.data[5] * mat1.data[7] + mat2.data[6] * mat1.data[11] + mat2.data[7],
+
+			mat2.data[8] * mat1.data[0] + mat2.data[9] * mat1.data[4] + mat2.data[10] * mat1.data[8],
+			mat2.data[8] * mat1.data[1] + mat2.data[9] * mat1.data[5] + mat2.data[10] * mat1.data[9],
+			mat2.data[8] * mat1.data[2] + mat2.data[9] * mat1.data[6] + mat2.data[10] * mat1.data[10],
+			mat2.data[8] * mat1.data[3] + mat2.data[9] * mat1.data[7] + mat2.data[10] * mat1.data[11] + mat2.data[11]
+		};
+	}
+
+
+
+} // mpml
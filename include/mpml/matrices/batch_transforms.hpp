@@ -0,0 +1,208 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Transforms whole arrays of 3D points and directions by a Matrix4
+//
+// Note:
+//	The matrix is applied column-major, the way translate(), lookAt() and perspective() build it:
+//	p' = col0 * x + col1 * y + col2 * z + col3 * w, with w = 1 for points and w = 0 for directions.
+//	out may be the same span as the input, but must not partially overlap it.
+//	Vector3<float> arrays are processed 4 (SSE) or 8 (AVX) at a time after a transpose to one register per component,
+//	Vector3<double> arrays 4 at a time with AVX. Double without AVX runs the scalar loop.
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <cassert>
+#include <type_traits>
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/matrices/matrix4.hpp"
+#include "mpml/vectors/vector3.hpp"
+
+
+namespace mpml
+{
+
+	namespace detail
+	{
+
+		enum class BatchTransform
+		{
+			points,
+			directions,
+			project
+		};
+
+		template<BatchTransform Mode, typename T>
+		[[nodiscard]] inline constexpr Vector3<T> transform_one(const Matrix4<T>& mat, const Vector3<T>& vec) noexcept
+		{
+			Vector3<T> vec_r
+			{
+				mat.a * vec.x + mat.e * vec.y + mat.i * vec.z,
+				mat.b * vec.x + mat.f * vec.y + mat.j * vec.z,
+				mat.c * vec.x + mat.g * vec.y + mat.k * vec.z
+			};
+
+			if constexpr (Mode == BatchTransform::directions)
+				return vec_r;
+
+			vec_r = Vector3<T>{ vec_r.x + mat.m, vec_r.y + mat.n, vec_r.z + mat.o };
+
+			if constexpr (Mode == BatchTransform::project)
+			{
+				const T w{ mat.d * vec.x + mat.h * vec.y + mat.l * vec.z + mat.p };
+				vec_r = Vector3<T>{ vec_r.x / w, vec_r.y / w, vec_r.z / w };
+			}
+
+			return vec_r;
+		}
+
+#if defined(MPML_SIMD_SSE2)
+
+		// Transforms 8 floats (Wide, __m256), 4 floats (__m128) or 4 doubles (Wide, __m256d) per iteration from index on
+		// Returns the index of the first vector left untouched
+		template<BatchTransform Mode, bool Wide, typename T>
+		[[nodiscard]] inline size_t transform_lanes(const Matrix4<T>& mat, const Vector3<T>* src, Vector3<T>* dst, size_t index, size_t count) noexcept
+		{
+			constexpr bool wide{ Wide };
+			constexpr bool is_double{ std::is_same_v<T, double> };
+			constexpr size_t width{ is_double ? 4 : wide ? 8 : 4 };
+
+			static_assert(!is_double || wide, "doubles only go through __m256d");
+
+			const auto broadcast{ [](T value) {
+				if constexpr (is_double)
+					return _mm256_set1_pd(value);
+				else if constexpr (wide)
+					return _mm256_set1_ps(value);
+				else
+					return _mm_set1_ps(value);
+			} };
+
+			using Reg = decltype(broadcast(T{}));
+
+			const auto mul{ [](Reg lhs, Reg rhs) {
+				if constexpr (is_double)
+					return _mm256_mul_pd(lhs, rhs);
+				else if constexpr (wide)
+					return _mm256_mul_ps(lhs, rhs);
+				else
+					return _mm_mul_ps(lhs, rhs);
+			} };
+
+			const auto div{ [](Reg lhs, Reg rhs) {
+				if constexpr (is_double)
+					return _mm256_div_pd(lhs, rhs);
+				else if constexpr (wide)
+					return _mm256_div_ps(lhs, rhs);
+				else
+					return _mm_div_ps(lhs, rhs);
+			} };
+
+			const Reg a{ broadcast(mat.a) }, b{ broadcast(mat.b) }, c{ broadcast(mat.c) }, d{ broadcast(mat.d) };
+			const Reg e{ broadcast(mat.e) }, f{ broadcast(mat.f) }, g{ broadcast(mat.g) }, h{ broadcast(mat.h) };
+			const Reg i{ broadcast(mat.i) }, j{ broadcast(mat.j) }, k{ broadcast(mat.k) }, l{ broadcast(mat.l) };
+			const Reg m{ broadcast(mat.m) }, n{ broadcast(mat.n) }, o{ broadcast(mat.o) }, p{ broadcast(mat.p) };
+
+			for (; index + width <= count; index += width)
+			{
+				Reg x, y, z;
+				simd::deinterleave3(&src[index].x, x, y, z);
+
+				Reg x_r, y_r, z_r;
+
+				if constexpr (Mode == BatchTransform::directions)
+				{
+					x_r = mul(i, z);
+					y_r = mul(j, z);
+					z_r = mul(k, z);
+				}
+				else
+				{
+					x_r = simd::madd(i, z, m);
+					y_r = simd::madd(j, z, n);
+					z_r = simd::madd(k, z, o);
+				}
+
+				x_r = simd::madd(a, x, simd::madd(e, y, x_r));
+				y_r = simd::madd(b, x, simd::madd(f, y, y_r));
+				z_r = simd::madd(c, x, simd::madd(g, y, z_r));
+
+				if constexpr (Mode == BatchTransform::project)
+				{
+					const Reg w_r{ simd::madd(d, x, simd::madd(h, y, simd::madd(l, z, p))) };
+
+					x_r = div(x_r, w_r);
+					y_r = div(y_r, w_r);
+					z_r = div(z_r, w_r);
+				}
+
+				simd::interleave3(&dst[index].x, x_r, y_r, z_r);
+			}
+
+			return index;
+		}
+
+#endif
+
+		template<BatchTransform Mode, typename T>
+		inline constexpr void transform_batch(const Matrix4<T>& mat, std::span<const Vector3<T>> vecs, std::span<Vector3<T>> out) noexcept
+		{
+			assert(out.size() >= vecs.size() && "out is smaller than the input");
+
+			size_t index{};
+
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+#	if defined(MPML_SIMD_AVX)
+					index = transform_lanes<Mode, true>(mat, vecs.data(), out.data(), index, vecs.size());
+#	endif
+					index = transform_lanes<Mode, false>(mat, vecs.data(), out.data(), index, vecs.size());
+				}
+			}
+
+#	if defined(MPML_SIMD_AVX)
+			if constexpr (std::is_same_v<T, double>)
+			{
+				if (!std::is_constant_evaluated())
+					index = transform_lanes<Mode, true>(mat, vecs.data(), out.data(), index, vecs.size());
+			}
+#	endif
+#endif
+
+			for (; index < vecs.size(); index++)
+				out[index] = transform_one<Mode>(mat, vecs[index]);
+		}
+
+	} // detail
+
+
+	// The spans take their type from the matrix, so std::vector and arrays of Vector3<T> convert directly
+
+	template<typename T>
+	inline constexpr void transform_points(const Matrix4<T>& mat, std::type_identity_t<std::span<const Vector3<T>>> points, std::type_identity_t<std::span<Vector3<T>>> out) noexcept
+	{
+		detail::transform_batch<detail::BatchTransform::points>(mat, points, out);
+	}
+
+	// Ignores the translation
+	template<typename T>
+	inline constexpr void transform_directions(const Matrix4<T>& mat, std::type_identity_t<std::span<const Vector3<T>>> directions, std::type_identity_t<std::span<Vector3<T>>> out) noexcept
+	{
+		detail::transform_batch<detail::BatchTransform::directions>(mat, directions, out);
+	}
+
+	// Divides by the resulting w, e.g. for a projection or a view-projection matrix
+	template<typename T>
+	inline constexpr void transform_points_project(const Matrix4<T>& mat, std::type_identity_t<std::span<const Vector3<T>>> points, std::type_identity_t<std::span<Vector3<T>>> out) noexcept
+	{
+		detail::transform_batch<detail::BatchTransform::project>(mat, points, out);
+	}
+
+} // mpml
@@ -12,6 +12,8 @@
 #include "mpml/matrices/matrix2.hpp"
 #include "mpml/matrices/matrix3.hpp"
 #include "mpml/matrices/matrix4.hpp"
+#include "mpml/matrices/affine3.hpp"
 
 // -- Utilities
 #include "mpml/matrices/transforms.hpp"
+#include "mpml/matrices/batch_transforms.hpp"
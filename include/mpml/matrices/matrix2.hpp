@@ -12,6 +12,7 @@
 #include <optional>
 #include <stdexcept>
 
+#include "mpml/utilities/pack.hpp"
 #include "mpml/vectors/vector2.hpp"
 
 
@@ -200,8 +201,11 @@ namespace mpml
 	{
 		T determinant{ det() };
 
-		if (determinant == T{})
-			return std::nullopt;
+		if constexpr (!is_pack_v<T>)
+		{
+			if (determinant == T{})
+				return std::nullopt;
+		}
 
 		return std::optional<Matrix2<T>>{ adj() / determinant };
 	}
@@ -257,7 +261,7 @@ namespace mpml
 			break;
 
 		default:
-			std::out_of_range("Index out of range");
+			throw std::out_of_range("Index out of range");
 			break;
 		}
 	}
@@ -276,7 +280,7 @@ namespace mpml
 			break;
 
 		default:
-			std::out_of_range("Index out of range");
+			throw std::out_of_range("Index out of range");
 			break;
 		}
 	}
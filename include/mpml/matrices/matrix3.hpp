@@ -10,7 +10,9 @@
 #include <utility>
 #include <algorithm>
 #include <optional>
+#include <stdexcept>
 
+#include "mpml/utilities/pack.hpp"
 #include "mpml/vectors/vector3.hpp"
 #include "mpml/matrices/matrix2.hpp"
 
@@ -289,8 +291,11 @@ namespace mpml
 	{
 		T determinant{ det() };
 
-		if (determinant == T{})
-			return std::nullopt;
+		if constexpr (!is_pack_v<T>)
+		{
+			if (determinant == T{})
+				return std::nullopt;
+		}
 
 		return std::optional<Matrix3<T>>{ adj() / determinant };
 	}
@@ -352,7 +357,7 @@ namespace mpml
 			break;
 
 		default:
-			std::out_of_range("Index out of range");
+			throw std::out_of_range("Index out of range");
 			break;
 		}
 	}
@@ -375,7 +380,7 @@ namespace mpml
 			break;
 
 		default:
-			std::out_of_range("Index out of range");
+			throw std::out_of_range("Index out of range");
 			break;
 		}
 	}
@@ -572,8 +577,8 @@ namespace mpml
 		return Vector3<T>
 		{
 			mat.a * vec.x + mat.b * vec.y + mat.c * vec.z,
-			mat.e * vec.x + mat.f * vec.y + mat.g * vec.z,
-			mat.h * vec.x + mat.i * vec.y + mat.j * vec.z
+			mat.d * vec.x + mat.e * vec.y + mat.f * vec.z,
+			mat.g * vec.x + mat.h * vec.y + mat.i * vec.z
 		};
 	}
 
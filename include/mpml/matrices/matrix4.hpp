@@ -10,6 +10,13 @@
 #include <utility>
 #include <algorithm>
 #include <optional>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <type_traits>
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/pack.hpp"
 
 #include "mpml/vectors/vector3.hpp"
 #include "mpml/vectors/vector4.hpp"
@@ -67,6 +74,10 @@ namespace mpml
 		[[nodiscard]] constexpr Matrix4<T> adj() const noexcept;
 
 		[[nodiscard]] constexpr std::optional<Matrix4<T>> inverse() const;
+		// Only valid for affine matrices (last row of (0, 0, 0, 1)), inverts the upper 3x3 and the translation
+		[[nodiscard]] constexpr std::optional<Matrix4<T>> inverse_affine() const;
+		// Only valid for rigid-body matrices (affine with an orthonormal upper 3x3), transposes the upper 3x3 and inverts the translation
+		[[nodiscard]] constexpr Matrix4<T> inverse_rigid() const noexcept;
 		[[nodiscard]] constexpr Matrix4<T> transpose() const noexcept;
 
 		[[nodiscard]] constexpr Matrix4<T> pow(size_t pm = 2) const noexcept;
@@ -148,6 +159,249 @@ namespace mpml
 	};
 
 
+	namespace detail
+	{
+		// The 2x2 sub-determinants of the first two rows (s) and of the last two rows (c).
+		// det(), adj() and inverse() are all expressed from these twelve values, which are computed once.
+		template<typename T>
+		struct Matrix4SubDeterminants
+		{
+			[[nodiscard]] constexpr T det() const noexcept
+			{
+				return T{ s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0 };
+			}
+
+			T s0, s1, s2, s3, s4, s5;
+			T c0, c1, c2, c3, c4, c5;
+		};
+
+		template<typename T>
+		[[nodiscard]] constexpr Matrix4SubDeterminants<T> sub_determinants(const Matrix4<T>& mat) noexcept
+		{
+			return Matrix4SubDeterminants<T>
+			{
+				mat.a * mat.f - mat.e * mat.b,
+				mat.a * mat.g - mat.e * mat.c,
+				mat.a * mat.h - mat.e * mat.d,
+				mat.b * mat.g - mat.f * mat.c,
+				mat.b * mat.h - mat.f * mat.d,
+				mat.c * mat.h - mat.g * mat.d,
+
+				mat.i * mat.n - mat.m * mat.j,
+				mat.i * mat.o - mat.m * mat.k,
+				mat.i * mat.p - mat.m * mat.l,
+				mat.j * mat.o - mat.n * mat.k,
+				mat.j * mat.p - mat.n * mat.l,
+				mat.k * mat.p - mat.o * mat.l
+			};
+		}
+
+		template<typename T>
+		[[nodiscard]] constexpr Matrix4<T> adjugate(const Matrix4<T>& mat, const Matrix4SubDeterminants<T>& sub) noexcept
+		{
+			return Matrix4<T>
+			{
+				 mat.f * sub.c5 - mat.g * sub.c4 + mat.h * sub.c3,
+				-mat.b * sub.c5 + mat.c * sub.c4 - mat.d * sub.c3,
+				 mat.n * sub.s5 - mat.o * sub.s4 + mat.p * sub.s3,
+				-mat.j * sub.s5 + mat.k * sub.s4 - mat.l * sub.s3,
+
+				-mat.e * sub.c5 + mat.g * sub.c2 - mat.h * sub.c1,
+				 mat.a * sub.c5 - mat.c * sub.c2 + mat.d * sub.c1,
+				-mat.m * sub.s5 + mat.o * sub.s2 - mat.p * sub.s1,
+				 mat.i * sub.s5 - mat.k * sub.s2 + mat.l * sub.s1,
+
+				 mat.e * sub.c4 - mat.f * sub.c2 + mat.h * sub.c0,
+				-mat.a * sub.c4 + mat.b * sub.c2 - mat.d * sub.c0,
+				 mat.m * sub.s4 - mat.n * sub.s2 + mat.p * sub.s0,
+				-mat.i * sub.s4 + mat.j * sub.s2 - mat.l * sub.s0,
+
+				-mat.e * sub.c3 + mat.f * sub.c1 - mat.g * sub.c0,
+				 mat.a * sub.c3 - mat.b * sub.c1 + mat.c * sub.c0,
+				-mat.m * sub.s3 + mat.n * sub.s1 - mat.o * sub.s0,
+				 mat.i * sub.s3 - mat.j * sub.s1 + mat.k * sub.s0
+			};
+		}
+
+		// Debug checks for the fast inversion paths
+		template<typename T>
+		[[nodiscard]] constexpr bool is_affine(const Matrix4<T>& mat) noexcept
+		{
+			const auto affine{ mat.d == T{} && mat.h == T{} && mat.l == T{} && mat.p == T{ 1 } };
+
+			if constexpr (is_pack_v<T>)
+				return all(affine);
+			else
+				return affine;
+		}
+
+		template<typename T>
+		[[nodiscard]] bool is_rigid(const Matrix4<T>& mat) noexcept
+		{
+			const Vector3<T> x{ mat.a, mat.b, mat.c };
+			const Vector3<T> y{ mat.e, mat.f, mat.g };
+			const Vector3<T> z{ mat.i, mat.j, mat.k };
+
+			const T tolerance{ std::sqrt(std::numeric_limits<T>::epsilon()) };
+
+			return is_affine(mat)
+				&& std::abs(x.length_squared() - T{ 1 }) <= tolerance
+				&& std::abs(y.length_squared() - T{ 1 }) <= tolerance
+				&& std::abs(z.length_squared() - T{ 1 }) <= tolerance
+				&& std::abs(x.dot(y)) <= tolerance
+				&& std::abs(x.dot(z)) <= tolerance
+				&& std::abs(y.dot(z)) <= tolerance;
+		}
+
+		// Builds the inverse of an affine matrix from the inverse of its upper 3x3 (given in the same storage order)
+		template<typename T>
+		[[nodiscard]] constexpr Matrix4<T> affine_from_inverse_3x3(const Matrix4<T>& mat,
+			const T& a, const T& b, const T& c,
+			const T& e, const T& f, const T& g,
+			const T& i, const T& j, const T& k) noexcept
+		{
+			return Matrix4<T>
+			{
+				a, b, c, T{},
+				e, f, g, T{},
+				i, j, k, T{},
+				-(a * mat.m + e * mat.n + i * mat.o),
+				-(b * mat.m + f * mat.n + j * mat.o),
+				-(c * mat.m + g * mat.n + k * mat.o),
+				T{ 1 }
+			};
+		}
+
+#if defined(MPML_SIMD_SSE2)
+
+		// Block-wise inverse: the matrix is split into four 2x2 blocks A B / C D, each held in one register,
+		// and the inverse is built from their adjugates and determinants.
+		// Inverting the transpose gives the transposed inverse, so the storage order does not matter here.
+
+		// A * B for 2x2 matrices stored as (m00, m01, m10, m11)
+		[[nodiscard]] inline __m128 mat2_mul(__m128 vec1, __m128 vec2) noexcept
+		{
+			return _mm_add_ps(_mm_mul_ps(vec1, simd::swizzle<0, 3, 0, 3>(vec2)), _mm_mul_ps(simd::swizzle<1, 0, 3, 2>(vec1), simd::swizzle<2, 1, 2, 1>(vec2)));
+		}
+
+		// adj(A) * B
+		[[nodiscard]] inline __m128 mat2_adj_mul(__m128 vec1, __m128 vec2) noexcept
+		{
+			return _mm_sub_ps(_mm_mul_ps(simd::swizzle<3, 3, 0, 0>(vec1), vec2), _mm_mul_ps(simd::swizzle<1, 1, 2, 2>(vec1), simd::swizzle<2, 3, 0, 1>(vec2)));
+		}
+
+		// A * adj(B)
+		[[nodiscard]] inline __m128 mat2_mul_adj(__m128 vec1, __m128 vec2) noexcept
+		{
+			return _mm_sub_ps(_mm_mul_ps(vec1, simd::swizzle<3, 0, 3, 0>(vec2)), _mm_mul_ps(simd::swizzle<1, 0, 3, 2>(vec1), simd::swizzle<2, 1, 2, 1>(vec2)));
+		}
+
+		[[nodiscard]] inline std::optional<Matrix4<float>> inverse(const Matrix4<float>& mat) noexcept
+		{
+			const __m128 col0{ _mm_loadu_ps(mat.col0.data_ptr()) };
+			const __m128 col1{ _mm_loadu_ps(mat.col1.data_ptr()) };
+			const __m128 col2{ _mm_loadu_ps(mat.col2.data_ptr()) };
+			const __m128 col3{ _mm_loadu_ps(mat.col3.data_ptr()) };
+
+			const __m128 A{ _mm_movelh_ps(col0, col1) };
+			const __m128 B{ _mm_movehl_ps(col1, col0) };
+			const __m128 C{ _mm_movelh_ps(col2, col3) };
+			const __m128 D{ _mm_movehl_ps(col3, col2) };
+
+			// (|A|, |B|, |C|, |D|)
+			const __m128 det_sub{ _mm_sub_ps(
+				_mm_mul_ps(simd::shuffle<0, 2, 0, 2>(col0, col2), simd::shuffle<1, 3, 1, 3>(col1, col3)),
+				_mm_mul_ps(simd::shuffle<1, 3, 1, 3>(col0, col2), simd::shuffle<0, 2, 0, 2>(col1, col3))
+			) };
+
+			const __m128 det_A{ simd::swizzle<0, 0, 0, 0>(det_sub) };
+			const __m128 det_B{ simd::swizzle<1, 1, 1, 1>(det_sub) };
+			const __m128 det_C{ simd::swizzle<2, 2, 2, 2>(det_sub) };
+			const __m128 det_D{ simd::swizzle<3, 3, 3, 3>(det_sub) };
+
+			const __m128 D_C{ mat2_adj_mul(D, C) };
+			const __m128 A_B{ mat2_adj_mul(A, B) };
+
+			__m128 X{ _mm_sub_ps(_mm_mul_ps(det_D, A), mat2_mul(B, D_C)) };
+			__m128 W{ _mm_sub_ps(_mm_mul_ps(det_A, D), mat2_mul(C, A_B)) };
+			__m128 Y{ _mm_sub_ps(_mm_mul_ps(det_B, C), mat2_mul_adj(D, A_B)) };
+			__m128 Z{ _mm_sub_ps(_mm_mul_ps(det_C, B), mat2_mul_adj(A, D_C)) };
+
+			// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+			__m128 trace{ _mm_mul_ps(A_B, simd::swizzle<0, 2, 1, 3>(D_C)) };
+			trace = _mm_add_ps(trace, simd::swizzle<1, 0, 3, 2>(trace));
+			trace = _mm_add_ps(trace, simd::swizzle<2, 3, 0, 1>(trace));
+
+			const __m128 det_M{ _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_A, det_D), _mm_mul_ps(det_B, det_C)), trace) };
+
+			if (_mm_cvtss_f32(det_M) == 0.f)
+				return std::nullopt;
+
+			const __m128 r_det_M{ _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det_M) };
+
+			X = _mm_mul_ps(X, r_det_M);
+			Y = _mm_mul_ps(Y, r_det_M);
+			Z = _mm_mul_ps(Z, r_det_M);
+			W = _mm_mul_ps(W, r_det_M);
+
+			Matrix4<float> mat_r;
+
+			_mm_storeu_ps(mat_r.col0.data_ptr(), simd::shuffle<3, 1, 3, 1>(X, Y));
+			_mm_storeu_ps(mat_r.col1.data_ptr(), simd::shuffle<2, 0, 2, 0>(X, Y));
+			_mm_storeu_ps(mat_r.col2.data_ptr(), simd::shuffle<3, 1, 3, 1>(Z, W));
+			_mm_storeu_ps(mat_r.col3.data_ptr(), simd::shuffle<2, 0, 2, 0>(Z, W));
+
+			return std::optional<Matrix4<float>>{ mat_r };
+		}
+
+		// The rows of the inverse 3x3 are the cross products of the columns over the determinant,
+		// a transpose with a zero fourth row turns them back into columns with w = 0
+		[[nodiscard]] inline std::optional<Matrix4<float>> inverse_affine(const Matrix4<float>& mat) noexcept
+		{
+			const __m128 col0{ _mm_loadu_ps(mat.col0.data_ptr()) };
+			const __m128 col1{ _mm_loadu_ps(mat.col1.data_ptr()) };
+			const __m128 col2{ _mm_loadu_ps(mat.col2.data_ptr()) };
+			const __m128 col3{ _mm_loadu_ps(mat.col3.data_ptr()) };
+
+			__m128 row0{ simd::cross3(col1, col2) };
+			__m128 row1{ simd::cross3(col2, col0) };
+			__m128 row2{ simd::cross3(col0, col1) };
+			__m128 row3{ _mm_setzero_ps() };
+
+			const __m128 det{ simd::dot3(col0, row0) };
+
+			if (_mm_cvtss_f32(det) == 0.f)
+				return std::nullopt;
+
+			const __m128 r_det{ _mm_div_ps(_mm_set1_ps(1.f), det) };
+
+			row0 = _mm_mul_ps(row0, r_det);
+			row1 = _mm_mul_ps(row1, r_det);
+			row2 = _mm_mul_ps(row2, r_det);
+
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+			// -(inverse 3x3 * translation), w = 1 - 0
+			__m128 translation{ _mm_mul_ps(row0, simd::swizzle<0, 0, 0, 0>(col3)) };
+			translation = simd::madd(row1, simd::swizzle<1, 1, 1, 1>(col3), translation);
+			translation = simd::madd(row2, simd::swizzle<2, 2, 2, 2>(col3), translation);
+
+			Matrix4<float> mat_r;
+
+			_mm_storeu_ps(mat_r.col0.data_ptr(), row0);
+			_mm_storeu_ps(mat_r.col1.data_ptr(), row1);
+			_mm_storeu_ps(mat_r.col2.data_ptr(), row2);
+			_mm_storeu_ps(mat_r.col3.data_ptr(), _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), translation));
+
+			return std::optional<Matrix4<float>>{ mat_r };
+		}
+
+#endif
+
+	} // detail
+
+
+
 	// Class definition
 
 
@@ -201,11 +455,7 @@ namespace mpml
 	template<typename T>
 	inline constexpr T Matrix4<T>::det() const noexcept
 	{
-		return T{ a * minor(0).det() 
-			    - b * minor(1).det()
-				+ c * minor(2).det()
-			    - d * minor(3).det()
-		};
+		return detail::sub_determinants(*this).det();
 	}
 
 	template<typename T>
@@ -373,29 +623,87 @@ namespace mpml
 	template<typename T>
 	inline constexpr Matrix4<T> Matrix4<T>::cofactor_matrix() const noexcept
 	{
-		return Matrix4<T>{
-			cofactor(0), cofactor(1), cofactor(2), cofactor(3), 
-			cofactor(4), cofactor(5), cofactor(6), cofactor(7), 
-			cofactor(8), cofactor(9), cofactor(10), cofactor(11),
-			cofactor(12), cofactor(13), cofactor(14), cofactor(15)
-		};
+		return Matrix4<T>{ adj().transpose() };
 	}
 
 	template<typename T>
 	inline constexpr Matrix4<T> Matrix4<T>::adj() const noexcept
 	{
-		return Matrix4<T>{ cofactor_matrix().transpose() };
+		return detail::adjugate(*this, detail::sub_determinants(*this));
 	}
 
 	template<typename T>
 	inline constexpr std::optional<Matrix4<T>> Matrix4<T>::inverse() const
 	{
-		T determinant{ det() };
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::inverse(*this);
+		}
+#endif
 
-		if (determinant == T{})
-			return std::nullopt;
+		const detail::Matrix4SubDeterminants<T> sub{ detail::sub_determinants(*this) };
+		const T determinant{ sub.det() };
 
-		return std::optional<Matrix4<T>>{ adj() / determinant };
+		// Packs always hold a value, the lanes of a singular matrix come out non-finite
+		if constexpr (!is_pack_v<T>)
+		{
+			if (determinant == T{})
+				return std::nullopt;
+		}
+
+		return std::optional<Matrix4<T>>{ detail::adjugate(*this, sub) / determinant };
+	}
+
+	template<typename T>
+	inline constexpr std::optional<Matrix4<T>> Matrix4<T>::inverse_affine() const
+	{
+		assert(detail::is_affine(*this) && "Matrix4::inverse_affine() requires a last row of (0, 0, 0, 1)");
+
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::inverse_affine(*this);
+		}
+#endif
+
+		const T co_a{ f * k - g * j };
+		const T co_e{ g * i - e * k };
+		const T co_i{ e * j - f * i };
+
+		const T determinant{ a * co_a + b * co_e + c * co_i };
+
+		if constexpr (!is_pack_v<T>)
+		{
+			if (determinant == T{})
+				return std::nullopt;
+		}
+
+		const T inv_det{ T{ 1 } / determinant };
+
+		return std::optional<Matrix4<T>>{ detail::affine_from_inverse_3x3(*this,
+			co_a * inv_det, (c * j - b * k) * inv_det, (b * g - c * f) * inv_det,
+			co_e * inv_det, (a * k - c * i) * inv_det, (c * e - a * g) * inv_det,
+			co_i * inv_det, (b * i - a * j) * inv_det, (a * f - b * e) * inv_det
+		) };
+	}
+
+	template<typename T>
+	inline constexpr Matrix4<T> Matrix4<T>::inverse_rigid() const noexcept
+	{
+		if constexpr (!is_pack_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+				assert(detail::is_rigid(*this) && "Matrix4::inverse_rigid() requires an affine matrix with an orthonormal upper 3x3");
+		}
+
+		return detail::affine_from_inverse_3x3(*this,
+			a, e, i,
+			b, f, j,
+			c, g, k
+		);
 	}
 
 	template<typename T>
@@ -461,7 +769,7 @@ namespace mpml
 			break;
 
 		default:
-			std::out_of_range("Index out of range");
+			throw std::out_of_range("Index out of range");
 			break;
 		}
 	}
@@ -488,7 +796,7 @@ namespace mpml
 			break;
 
 		default:
-			std::out_of_range("Index out of range");
+			throw std::out_of_range("Index out of range");
 			break;
 		}
 	}
@@ -651,9 +959,209 @@ namespace mpml
 		};
 	}
 
+	namespace detail
+	{
+		// SIMD kernels behind operator*(Matrix4, Matrix4)
+		// Each column of the result is built by broadcasting the entries of mat1's matching column and accumulating mat2's columns.
+
+#if defined(MPML_SIMD_AVX)
+
+		// Computes two columns of the result at once: both halves of c0..c3 hold the same column of mat2
+		[[nodiscard]] inline __m256 multiply_columns(const float* lhs, __m256 c0, __m256 c1, __m256 c2, __m256 c3) noexcept
+		{
+			const __m256 cols{ _mm256_loadu_ps(lhs) };
+
+			__m256 res{ _mm256_mul_ps(_mm256_permute_ps(cols, _MM_SHUFFLE(0, 0, 0, 0)), c0) };
+			res = simd::madd(_mm256_permute_ps(cols, _MM_SHUFFLE(1, 1, 1, 1)), c1, res);
+			res = simd::madd(_mm256_permute_ps(cols, _MM_SHUFFLE(2, 2, 2, 2)), c2, res);
+			return simd::madd(_mm256_permute_ps(cols, _MM_SHUFFLE(3, 3, 3, 3)), c3, res);
+		}
+
+		[[nodiscard]] inline Matrix4<float> multiply(const Matrix4<float>& mat1, const Matrix4<float>& mat2) noexcept
+		{
+			const __m256 c0{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat2.col0.data_ptr())) };
+			const __m256 c1{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat2.col1.data_ptr())) };
+			const __m256 c2{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat2.col2.data_ptr())) };
+			const __m256 c3{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat2.col3.data_ptr())) };
+
+			Matrix4<float> mat_r;
+
+			_mm256_storeu_ps(mat_r.col0.data_ptr(), multiply_columns(mat1.col0.data_ptr(), c0, c1, c2, c3));
+			_mm256_storeu_ps(mat_r.col2.data_ptr(), multiply_columns(mat1.col2.data_ptr(), c0, c1, c2, c3));
+
+			return mat_r;
+		}
+
+		[[nodiscard]] inline __m256d multiply_column(const double* lhs, __m256d c0, __m256d c1, __m256d c2, __m256d c3) noexcept
+		{
+			__m256d res{ _mm256_mul_pd(_mm256_broadcast_sd(lhs), c0) };
+			res = simd::madd(_mm256_broadcast_sd(lhs + 1), c1, res);
+			res = simd::madd(_mm256_broadcast_sd(lhs + 2), c2, res);
+			return simd::madd(_mm256_broadcast_sd(lhs + 3), c3, res);
+		}
+
+		[[nodiscard]] inline Matrix4<double> multiply(const Matrix4<double>& mat1, const Matrix4<double>& mat2) noexcept
+		{
+			const __m256d c0{ _mm256_loadu_pd(mat2.col0.data_ptr()) };
+			const __m256d c1{ _mm256_loadu_pd(mat2.col1.data_ptr()) };
+			const __m256d c2{ _mm256_loadu_pd(mat2.col2.data_ptr()) };
+			const __m256d c3{ _mm256_loadu_pd(mat2.col3.data_ptr()) };
+
+			Matrix4<double> mat_r;
+
+			_mm256_storeu_pd(mat_r.col0.data_ptr(), multiply_column(mat1.col0.data_ptr(), c0, c1, c2, c3));
+			_mm256_storeu_pd(mat_r.col1.data_ptr(), multiply_column(mat1.col1.data_ptr(), c0, c1, c2, c3));
+			_mm256_storeu_pd(mat_r.col2.data_ptr(), multiply_column(mat1.col2.data_ptr(), c0, c1, c2, c3));
+			_mm256_storeu_pd(mat_r.col3.data_ptr(), multiply_column(mat1.col3.data_ptr(), c0, c1, c2, c3));
+
+			return mat_r;
+		}
+
+#elif defined(MPML_SIMD_SSE2)
+
+		[[nodiscard]] inline __m128 multiply_column(const float* lhs, __m128 c0, __m128 c1, __m128 c2, __m128 c3) noexcept
+		{
+			const __m128 col{ _mm_loadu_ps(lhs) };
+
+			__m128 res{ _mm_mul_ps(_mm_shuffle_ps(col, col, _MM_SHUFFLE(0, 0, 0, 0)), c0) };
+			res = simd::madd(_mm_shuffle_ps(col, col, _MM_SHUFFLE(1, 1, 1, 1)), c1, res);
+			res = simd::madd(_mm_shuffle_ps(col, col, _MM_SHUFFLE(2, 2, 2, 2)), c2, res);
+			return simd::madd(_mm_shuffle_ps(col, col, _MM_SHUFFLE(3, 3, 3, 3)), c3, res);
+		}
+
+		[[nodiscard]] inline Matrix4<float> multiply(const Matrix4<float>& mat1, const Matrix4<float>& mat2) noexcept
+		{
+			const __m128 c0{ _mm_loadu_ps(mat2.col0.data_ptr()) };
+			const __m128 c1{ _mm_loadu_ps(mat2.col1.data_ptr()) };
+			const __m128 c2{ _mm_loadu_ps(mat2.col2.data_ptr()) };
+			const __m128 c3{ _mm_loadu_ps(mat2.col3.data_ptr()) };
+
+			Matrix4<float> mat_r;
+
+			_mm_storeu_ps(mat_r.col0.data_ptr(), multiply_column(mat1.col0.data_ptr(), c0, c1, c2, c3));
+			_mm_storeu_ps(mat_r.col1.data_ptr(), multiply_column(mat1.col1.data_ptr(), c0, c1, c2, c3));
+			_mm_storeu_ps(mat_r.col2.data_ptr(), multiply_column(mat1.col2.data_ptr(), c0, c1, c2, c3));
+			_mm_storeu_ps(mat_r.col3.data_ptr(), multiply_column(mat1.col3.data_ptr(), c0, c1, c2, c3));
+
+			return mat_r;
+		}
+
+		// A column of doubles spans two registers: [x, y] and [z, w]
+		inline void multiply_column(const double* lhs, const double* rhs, double* out) noexcept
+		{
+			const __m128d x{ _mm_set1_pd(lhs[0]) };
+			const __m128d y{ _mm_set1_pd(lhs[1]) };
+			const __m128d z{ _mm_set1_pd(lhs[2]) };
+			const __m128d w{ _mm_set1_pd(lhs[3]) };
+
+			__m128d low{ _mm_mul_pd(x, _mm_loadu_pd(rhs)) };
+			low = simd::madd(y, _mm_loadu_pd(rhs + 4), low);
+			low = simd::madd(z, _mm_loadu_pd(rhs + 8), low);
+			low = simd::madd(w, _mm_loadu_pd(rhs + 12), low);
+
+			__m128d high{ _mm_mul_pd(x, _mm_loadu_pd(rhs + 2)) };
+			high = simd::madd(y, _mm_loadu_pd(rhs + 6), high);
+			high = simd::madd(z, _mm_loadu_pd(rhs + 10), high);
+			high = simd::madd(w, _mm_loadu_pd(rhs + 14), high);
+
+			_mm_storeu_pd(out, low);
+			_mm_storeu_pd(out + 2, high);
+		}
+
+		[[nodiscard]] inline Matrix4<double> multiply(const Matrix4<double>& mat1, const Matrix4<double>& mat2) noexcept
+		{
+			Matrix4<double> mat_r;
+
+			multiply_column(mat1.col0.data_ptr(), mat2.col0.data_ptr(), mat_r.col0.data_ptr());
+			multiply_column(mat1.col1.data_ptr(), mat2.col0.data_ptr(), mat_r.col1.data_ptr());
+			multiply_column(mat1.col2.data_ptr(), mat2.col0.data_ptr(), mat_r.col2.data_ptr());
+			multiply_column(mat1.col3.data_ptr(), mat2.col0.data_ptr(), mat_r.col3.data_ptr());
+
+			return mat_r;
+		}
+
+#endif
+
+#if defined(MPML_SIMD_SSE2)
+
+		// A single matrix-vector product: each column times vec, then the four dot products are reduced together,
+		// by two levels of hadd (SSE3, taken with SSE4.1) or a transpose and adds
+		// operator*(Matrix4, Vector4) keeps the scalar code, in a loop over many vectors the compiler hoists its transpose out
+		[[nodiscard]] inline Vector4<float> transform(const Matrix4<float>& mat, const Vector4<float>& vec) noexcept
+		{
+			const __m128 lanes{ simd::load(vec) };
+
+			__m128 r0{ _mm_mul_ps(simd::load(mat.col0), lanes) };
+			__m128 r1{ _mm_mul_ps(simd::load(mat.col1), lanes) };
+			__m128 r2{ _mm_mul_ps(simd::load(mat.col2), lanes) };
+			__m128 r3{ _mm_mul_ps(simd::load(mat.col3), lanes) };
+
+			Vector4<float> vec_r;
+
+#	if defined(MPML_SIMD_SSE41)
+			_mm_store_ps(vec_r.data_ptr(), _mm_hadd_ps(_mm_hadd_ps(r0, r1), _mm_hadd_ps(r2, r3)));
+#	else
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_store_ps(vec_r.data_ptr(), _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3)));
+#	endif
+
+			return vec_r;
+		}
+
+#	if defined(MPML_SIMD_AVX)
+
+		// Each row times vec, hadd sums the halves of rows 0 and 1 (and 2 and 3) side by side, the two 128-bit halves then add up
+		[[nodiscard]] inline Vector4<double> transform(const Matrix4<double>& mat, const Vector4<double>& vec) noexcept
+		{
+			const __m256d lanes{ _mm256_loadu_pd(vec.data_ptr()) };
+
+			const __m256d r01{ _mm256_hadd_pd(_mm256_mul_pd(_mm256_loadu_pd(mat.col0.data_ptr()), lanes), _mm256_mul_pd(_mm256_loadu_pd(mat.col1.data_ptr()), lanes)) };
+			const __m256d r23{ _mm256_hadd_pd(_mm256_mul_pd(_mm256_loadu_pd(mat.col2.data_ptr()), lanes), _mm256_mul_pd(_mm256_loadu_pd(mat.col3.data_ptr()), lanes)) };
+
+			Vector4<double> vec_r;
+			_mm256_storeu_pd(vec_r.data_ptr(), _mm256_add_pd(_mm256_permute2f128_pd(r01, r23, 0x20), _mm256_permute2f128_pd(r01, r23, 0x31)));
+
+			return vec_r;
+		}
+
+#	else
+
+		// A row of doubles spans two registers, its halves are added before the rows are reduced two by two
+		[[nodiscard]] inline Vector4<double> transform(const Matrix4<double>& mat, const Vector4<double>& vec) noexcept
+		{
+			const __m128d low{ _mm_loadu_pd(vec.data_ptr()) };
+			const __m128d high{ _mm_loadu_pd(vec.data_ptr() + 2) };
+
+			const auto row{ [&](const Vector4<double>& col) {
+				return simd::madd(_mm_loadu_pd(col.data_ptr() + 2), high, _mm_mul_pd(_mm_loadu_pd(col.data_ptr()), low));
+			} };
+
+			const __m128d r0{ row(mat.col0) }, r1{ row(mat.col1) }, r2{ row(mat.col2) }, r3{ row(mat.col3) };
+
+			Vector4<double> vec_r;
+			_mm_storeu_pd(vec_r.data_ptr(), _mm_add_pd(_mm_unpacklo_pd(r0, r1), _mm_unpackhi_pd(r0, r1)));
+			_mm_storeu_pd(vec_r.data_ptr() + 2, _mm_add_pd(_mm_unpacklo_pd(r2, r3), _mm_unpackhi_pd(r2, r3)));
+
+			return vec_r;
+		}
+
+#	endif
+
+#endif
+
+	} // detail
+
 	template<typename T>
 	inline constexpr Matrix4<T> operator*(const Matrix4<T>& mat1, const Matrix4<T>& mat2) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::multiply(mat1, mat2);
+		}
+#endif
+
 		return Matrix4<T>
 		{
 			mat1.a * mat2.a + mat1.b * mat2.e + mat1.c * mat2.i + mat1.d * mat2.m,
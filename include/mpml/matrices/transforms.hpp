@@ -6,9 +6,12 @@
 // ===================================================
 
 #include "mpml/matrices/matrix4.hpp"
+#include "mpml/matrices/affine3.hpp"
 
 #include "mpml/utilities/angle.hpp"
 
+#include "mpml/functions/trigo.hpp"
+
 #include "mpml/quaternions/quaternions.hpp"
 
 #include "mpml/vectors/vectors.hpp"
@@ -18,27 +21,66 @@ namespace mpml
 {
 
 	// 2D transforms
+	// Each one equals mat * (the transform matrix) and only computes the entries that matrix changes,
+	// the *_inplace versions write them into mat
 
 	template<typename T>
-	[[nodiscard]] constexpr Matrix3<T> translate(const Matrix3<T>& mat, const Vector2<T>& vec) noexcept
+	constexpr void translate_inplace(Matrix3<T>& mat, const Vector2<T>& vec) noexcept
 	{
-		Matrix3<T> trans_mat{ Matrix3<T>::Identity };
+		for (size_t row{}; row < 9; row += 3)
+			mat.data[row + 2] = mat.data[row] * vec.x + mat.data[row + 1] * vec.y + mat.data[row + 2];
+	}
 
-		trans_mat[0][2] = vec.x;
-		trans_mat[1][2] = vec.y;
+	template<typename T>
+	constexpr void scale_inplace(Matrix3<T>& mat, const Vector2<T>& vec) noexcept
+	{
+		for (size_t row{}; row < 9; row += 3)
+		{
+			mat.data[row] = mat.data[row] * vec.x;
+			mat.data[row + 1] = mat.data[row + 1] * vec.y;
+		}
+	}
 
-		return mat * trans_mat;
+	template<typename T>
+	constexpr void scale_inplace(Matrix3<T>& mat, const T& scalar) noexcept
+	{
+		scale_inplace(mat, Vector2<T>{ scalar, scalar });
 	}
 
 	template<typename T>
-	[[nodiscard]] constexpr Matrix3<T> scale(const Matrix3<T>& mat, const Vector2<T>& vec) noexcept
+	constexpr void rotate_inplace(Matrix3<T>& mat, Angle<> theta) noexcept
 	{
-		Matrix3<T> trans_mat{ Matrix3<T>::Identity };
+		const auto [sin_theta, cos_theta]{ func::sincos(theta) };
+		const T cos{ static_cast<T>(cos_theta) };
+		const T sin{ static_cast<T>(sin_theta) };
 
-		trans_mat[0][0] = vec.x;
-		trans_mat[1][1] = vec.y;
+		for (size_t row{}; row < 9; row += 3)
+		{
+			const T x{ mat.data[row] };
+			const T y{ mat.data[row + 1] };
 
-		return mat * trans_mat;
+			mat.data[row] = x * cos + y * sin;
+			mat.data[row + 1] = y * cos - x * sin;
+		}
+	}
+
+
+	template<typename T>
+	[[nodiscard]] constexpr Matrix3<T> translate(const Matrix3<T>& mat, const Vector2<T>& vec) noexcept
+	{
+		Matrix3<T> mat_r{ mat };
+		translate_inplace(mat_r, vec);
+
+		return mat_r;
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Matrix3<T> scale(const Matrix3<T>& mat, const Vector2<T>& vec) noexcept
+	{
+		Matrix3<T> mat_r{ mat };
+		scale_inplace(mat_r, vec);
+
+		return mat_r;
 	}
 
 	template<typename T>
@@ -51,17 +93,10 @@ namespace mpml
 	template<typename T>
 	[[nodiscard]] constexpr Matrix3<T> rotate(const Matrix3<T>& mat, Angle<> theta) noexcept
 	{
-		Matrix3<T> rot_mat{ Matrix3<T>::Identity };
-
-		T cos{ std::cos(theta.as_radians()) };
-		T sin{ std::sin(theta.as_radians()) };
-
-		rot_mat[0][0] = cos;
-		rot_mat[0][1] = -sin;
-		rot_mat[1][0] = sin;
-		rot_mat[1][1] = cos;
+		Matrix3<T> mat_r{ mat };
+		rotate_inplace(mat_r, theta);
 
-		return mat * rot_mat;
+		return mat_r;
 	}
 
 
@@ -70,8 +105,9 @@ namespace mpml
 	{
 		Matrix3<T> view_mat{ Matrix3<T>::Identity };
 
-		T cos{ std::cos(theta.as_radians()) };
-		T sin{ std::sin(theta.as_radians()) };
+		const auto [sin_theta, cos_theta]{ func::sincos(theta) };
+		const T cos{ static_cast<T>(cos_theta) };
+		const T sin{ static_cast<T>(sin_theta) };
 
 		view_mat[0][0] = cos;
 		view_mat[0][1] = sin;
@@ -106,29 +142,136 @@ namespace mpml
 
 
 	// 3D tranforms
+	// As in 2D, mat * (the transform matrix) restricted to the entries it changes, rotations are in quaternions/transforms.hpp
+
+	namespace detail
+	{
+		// Kernels shared by the copying and in-place versions, every row of mat is read before the same row of mat_r is written so both may alias
+
+		template<typename T>
+		constexpr void translate_to(const Matrix4<T>& mat, const Vector3<T>& vec, Matrix4<T>& mat_r) noexcept
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const __m128 trans{ _mm_setr_ps(vec.x, vec.y, vec.z, 0.f) };
+
+					for (size_t row{}; row < 16; row += 4)
+					{
+						const __m128 row_r{ _mm_loadu_ps(mat.data_ptr() + row) };
+						_mm_storeu_ps(mat_r.data_ptr() + row, simd::madd(simd::swizzle<3, 3, 3, 3>(row_r), trans, row_r));
+					}
+
+					return;
+				}
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (std::is_same_v<T, double>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const __m256d trans{ _mm256_setr_pd(vec.x, vec.y, vec.z, 0.) };
+
+					for (size_t row{}; row < 16; row += 4)
+						_mm256_storeu_pd(mat_r.data_ptr() + row, simd::madd(_mm256_broadcast_sd(mat.data_ptr() + row + 3), trans, _mm256_loadu_pd(mat.data_ptr() + row)));
+
+					return;
+				}
+			}
+#endif
+
+			for (size_t row{}; row < 16; row += 4)
+			{
+				const T w{ mat.data[row + 3] };
+
+				mat_r.data[row] = mat.data[row] + w * vec.x;
+				mat_r.data[row + 1] = mat.data[row + 1] + w * vec.y;
+				mat_r.data[row + 2] = mat.data[row + 2] + w * vec.z;
+				mat_r.data[row + 3] = w;
+			}
+		}
+
+		template<typename T>
+		constexpr void scale_to(const Matrix4<T>& mat, const Vector3<T>& vec, Matrix4<T>& mat_r) noexcept
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const __m128 factors{ _mm_setr_ps(vec.x, vec.y, vec.z, 1.f) };
+
+					for (size_t row{}; row < 16; row += 4)
+						_mm_storeu_ps(mat_r.data_ptr() + row, _mm_mul_ps(_mm_loadu_ps(mat.data_ptr() + row), factors));
+
+					return;
+				}
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (std::is_same_v<T, double>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const __m256d factors{ _mm256_setr_pd(vec.x, vec.y, vec.z, 1.) };
+
+					for (size_t row{}; row < 16; row += 4)
+						_mm256_storeu_pd(mat_r.data_ptr() + row, _mm256_mul_pd(_mm256_loadu_pd(mat.data_ptr() + row), factors));
+
+					return;
+				}
+			}
+#endif
+
+			for (size_t row{}; row < 16; row += 4)
+			{
+				mat_r.data[row] = mat.data[row] * vec.x;
+				mat_r.data[row + 1] = mat.data[row + 1] * vec.y;
+				mat_r.data[row + 2] = mat.data[row + 2] * vec.z;
+				mat_r.data[row + 3] = mat.data[row + 3];
+			}
+		}
+	}
+
 
 	template<typename T>
-	[[nodiscard]] constexpr Matrix4<T> translate(const Matrix4<T>& mat, const Vector3<T>& vec) noexcept
+	constexpr void translate_inplace(Matrix4<T>& mat, const Vector3<T>& vec) noexcept
 	{
-		Matrix4<T> new_mat{ Matrix4<T>::Identity };
+		detail::translate_to(mat, vec, mat);
+	}
 
-		new_mat.m = vec.x;
-		new_mat.n = vec.y;
-		new_mat.o = vec.z;
+	template<typename T>
+	constexpr void scale_inplace(Matrix4<T>& mat, const Vector3<T>& vec) noexcept
+	{
+		detail::scale_to(mat, vec, mat);
+	}
 
-		return mat * new_mat;
+	template<typename T>
+	constexpr void scale_inplace(Matrix4<T>& mat, const T& scalar) noexcept
+	{
+		scale_inplace(mat, Vector3<T>{ scalar, scalar, scalar });
 	}
 
+
 	template<typename T>
-	[[nodiscard]] constexpr Matrix4<T> scale(const Matrix4<T>& mat, const Vector3<T>& vec) noexcept
+	[[nodiscard]] constexpr Matrix4<T> translate(const Matrix4<T>& mat, const Vector3<T>& vec) noexcept
 	{
-		Matrix4<T> new_mat{ Matrix4<T>::Identity };
+		Matrix4<T> mat_r;
+		detail::translate_to(mat, vec, mat_r);
 
-		new_mat.a = vec.x;
-		new_mat.f = vec.y;
-		new_mat.k = vec.z;
+		return mat_r;
+	}
 
-		return mat * new_mat;
+	template<typename T>
+	[[nodiscard]] constexpr Matrix4<T> scale(const Matrix4<T>& mat, const Vector3<T>& vec) noexcept
+	{
+		Matrix4<T> mat_r;
+		detail::scale_to(mat, vec, mat_r);
+
+		return mat_r;
 	}
 
 	template<typename T>
@@ -137,11 +280,65 @@ namespace mpml
 		return scale(mat, Vector3<T>{ scalar, scalar, scalar });
 	}
 
+
+	// Affine3 versions, same results as the Matrix4 ones on the matching affine matrix
+	// The translation is the last element of each row and scaling an axis scales its whole row
+
+	template<typename T>
+	constexpr void translate_inplace(Affine3<T>& mat, const Vector3<T>& vec) noexcept
+	{
+		mat.data[3] = mat.data[3] + vec.x;
+		mat.data[7] = mat.data[7] + vec.y;
+		mat.data[11] = mat.data[11] + vec.z;
+	}
+
+	template<typename T>
+	constexpr void scale_inplace(Affine3<T>& mat, const Vector3<T>& vec) noexcept
+	{
+		for (size_t column{}; column < 4; column++)
+		{
+			mat.data[column] = mat.data[column] * vec.x;
+			mat.data[column + 4] = mat.data[column + 4] * vec.y;
+			mat.data[column + 8] = mat.data[column + 8] * vec.z;
+		}
+	}
+
+	template<typename T>
+	constexpr void scale_inplace(Affine3<T>& mat, const T& scalar) noexcept
+	{
+		scale_inplace(mat, Vector3<T>{ scalar, scalar, scalar });
+	}
+
+
+	template<typename T>
+	[[nodiscard]] constexpr Affine3<T> translate(const Affine3<T>& mat, const Vector3<T>& vec) noexcept
+	{
+		Affine3<T> mat_r{ mat };
+		translate_inplace(mat_r, vec);
+
+		return mat_r;
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Affine3<T> scale(const Affine3<T>& mat, const Vector3<T>& vec) noexcept
+	{
+		Affine3<T> mat_r{ mat };
+		scale_inplace(mat_r, vec);
+
+		return mat_r;
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Affine3<T> scale(const Affine3<T>& mat, const T& scalar) noexcept
+	{
+		return scale(mat, Vector3<T>{ scalar, scalar, scalar });
+	}
+
 	template<typename T, typename U>
 	[[nodiscard]] constexpr Matrix4<T> perspective(const Angle<>& fov, const U& width, const U& height, const T& near, const T& far)
 	{
-		const T rad = fov.as_radians();
-		const T h = std::cos(static_cast<T>(0.5) * rad) / std::sin(static_cast<T>(0.5) * rad);
+		const auto [sin, cos]{ func::sincos(Angle<T>::from_radians(static_cast<T>(0.5) * fov.as_radians())) };
+		const T h = cos / sin;
 		const T w = h * height / width;
 
 		return Matrix4<T>
@@ -21,3 +21,5 @@
 
 #include "mpml/utilities/angle.hpp"
 
+#include "mpml/utilities/pack.hpp"
+
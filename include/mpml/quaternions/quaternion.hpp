@@ -8,8 +8,13 @@
 
 #include <array>
 #include <cmath>
+#include <stdexcept>
+#include <type_traits>
 
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/pack.hpp"
 #include "mpml/utilities/angle.hpp"
+#include "mpml/functions/trigo.hpp"
 
 #include "mpml/vectors/vector3.hpp"
 
@@ -18,7 +23,7 @@ namespace mpml
 
 
 template<typename T>
-class Quaternion
+class alignas(std::is_same_v<T, float> ? 16 : alignof(T)) Quaternion
 {
 public:
 
@@ -51,6 +56,9 @@ public:
 	[[nodiscard]] constexpr Quaternion<T> rotate(Angle<> angle, const Vector3<T>& axis) const noexcept;
 	[[nodiscard]] constexpr Quaternion<T> rotate(Angle<> angle) const noexcept;
 
+	// Rotates vec by this quaternion, which must be a unit quaternion
+	[[nodiscard]] constexpr Vector3<T> rotate_vector(const Vector3<T>& vec) const noexcept;
+
 
 	// Data Related
 
@@ -160,10 +168,14 @@ inline constexpr T Quaternion<T>::length() const noexcept
 {
 	T len_sqd{ length_squared() };
 
-	if (len_sqd == T{})
-		return T{};
+	if constexpr (!is_pack_v<T>)
+	{
+		if (len_sqd == T{})
+			return T{};
+	}
 
-	return T{ std::sqrt(len_sqd) };
+	using std::sqrt;
+	return T{ sqrt(len_sqd) };
 }
 
 template<typename T>
@@ -177,10 +189,15 @@ inline constexpr Quaternion<T> Quaternion<T>::normal() const noexcept
 {
 	T len{ length() };
 
-	if (len == T{})
-		return Quaternion<T>{};
+	if constexpr (is_pack_v<T>)
+		return Quaternion<T>{ *this * detail::pack::reciprocal_or_zero(len) };
+	else
+	{
+		if (len == T{})
+			return Quaternion<T>{};
 
-	return Quaternion<T>{ *this / len };
+		return Quaternion<T>{ *this / len };
+	}
 }
 
 template<typename T>
@@ -188,19 +205,40 @@ inline constexpr Quaternion<T> Quaternion<T>::inverse() const noexcept
 {
 	T len{ length_squared() };
 
-	if (len == T{})
-		return Quaternion<T>{};
+	if constexpr (is_pack_v<T>)
+		return Quaternion<T>{ conjugate() * detail::pack::reciprocal_or_zero(len) };
+	else
+	{
+		if (len == T{})
+			return Quaternion<T>{};
 
-	return Quaternion<T>{ conjugate() / len };
+		return Quaternion<T>{ conjugate() / len };
+	}
 }
 
+namespace detail
+{
+
+	// sin and cos of half the angle, computed in double for the quaternions wider than float
+	template<typename T>
+	[[nodiscard]] constexpr auto half_sincos(Angle<> angle) noexcept
+	{
+		if constexpr (std::is_floating_point_v<T> && sizeof(T) > sizeof(float))
+			return func::sincos(Angle<double>::from_radians(angle.as_radians() / 2.));
+		else
+			return func::sincos(Angle<>::from_radians(angle.as_radians() / 2.f));
+	}
+
+} // detail
+
 template<typename T>
 inline constexpr Quaternion<T> Quaternion<T>::rotate(Angle<> angle, const Vector3<T>& axis) const noexcept
 {
 	const Vector3<T> n_axis{ axis.normal() };
 
-	const T s{ static_cast<T>(std::sin(angle.as_radians() / 2.)) };
-	return Quaternion<T>{ static_cast<T>(std::cos(angle.as_radians() / 2.)), n_axis.x * s, n_axis.y * s, n_axis.z * s};
+	const auto [sin, cos]{ detail::half_sincos<T>(angle) };
+	const T s{ static_cast<T>(sin) };
+	return Quaternion<T>{ static_cast<T>(cos), n_axis.x * s, n_axis.y * s, n_axis.z * s};
 }
 
 template<typename T>
@@ -208,8 +246,20 @@ inline constexpr Quaternion<T> Quaternion<T>::rotate(Angle<> angle) const noexce
 {
 	const Vector3<T> n_axis = Vector3<T>{ x,y,z }.normal();
 
-	const T s{ static_cast<T>(std::sin(angle.as_radians() / 2.)) };
-	return Quaternion<T>{ static_cast<T>(std::cos(angle.as_radians() / 2.)), n_axis.x * s, n_axis.y * s, n_axis.z * s };
+	const auto [sin, cos]{ detail::half_sincos<T>(angle) };
+	const T s{ static_cast<T>(sin) };
+	return Quaternion<T>{ static_cast<T>(cos), n_axis.x * s, n_axis.y * s, n_axis.z * s };
+}
+
+
+template<typename T>
+inline constexpr Vector3<T> Quaternion<T>::rotate_vector(const Vector3<T>& vec) const noexcept
+{
+	// q * v * conj(q) expanded for a unit q: v + s * t + u x t, with u the vector part and t = 2 * (u x v)
+	const Vector3<T> u{ x, y, z };
+	const Vector3<T> t{ u.cross(vec) * static_cast<T>(2) };
+
+	return Vector3<T>{ vec + t * s + u.cross(t) };
 }
 
 
@@ -274,10 +324,10 @@ inline constexpr Quaternion<T>& Quaternion<T>::operator/=(const T& scalar) noexc
 template<typename T>
 inline constexpr Quaternion<T> Quaternion<T>::fromAxis(const Vector3<T>& axis, const Angle<>& angle) noexcept
 {
-	auto sin = std::sin(angle.as_radians() / 2.f);
+	const auto [sin, cos]{ detail::half_sincos<T>(angle) };
 	return 
 	{
-		std::cos(angle.as_radians() / 2.f),
+		cos,
 		sin * axis.x,
 		sin * axis.y,
 		sin * axis.z
@@ -286,9 +336,48 @@ inline constexpr Quaternion<T> Quaternion<T>::fromAxis(const Vector3<T>& axis, c
 
 
 // Overloads
+
+namespace detail::simd
+{
+
+#if defined(MPML_SIMD_SSE2)
+
+	[[nodiscard]] inline Quaternion<float> multiply(const Quaternion<float>& q1, const Quaternion<float>& q2) noexcept
+	{
+		// Lanes are s, x, y, z: each component of q1 scales a permutation of q2 with its own signs
+		const __m128 a{ _mm_load_ps(q1.data_ptr()) };
+		const __m128 b{ _mm_load_ps(q2.data_ptr()) };
+
+		const __m128 x_terms{ _mm_xor_ps(swizzle<1, 0, 3, 2>(b), _mm_setr_ps(-0.f, 0.f, -0.f, 0.f)) };
+		const __m128 y_terms{ _mm_xor_ps(swizzle<2, 3, 0, 1>(b), _mm_setr_ps(-0.f, 0.f, 0.f, -0.f)) };
+		const __m128 z_terms{ _mm_xor_ps(swizzle<3, 2, 1, 0>(b), _mm_setr_ps(-0.f, -0.f, 0.f, 0.f)) };
+
+		__m128 product{ _mm_mul_ps(swizzle<0, 0, 0, 0>(a), b) };
+		product = madd(swizzle<1, 1, 1, 1>(a), x_terms, product);
+		product = madd(swizzle<2, 2, 2, 2>(a), y_terms, product);
+		product = madd(swizzle<3, 3, 3, 3>(a), z_terms, product);
+
+		Quaternion<float> q_r;
+		_mm_store_ps(q_r.data_ptr(), product);
+		return q_r;
+	}
+
+#endif
+
+} // detail::simd
+
+
 template<typename T>
 inline constexpr Quaternion<T> operator*(const Quaternion<T>& q1, const Quaternion<T>& q2) noexcept
 {
+#if defined(MPML_SIMD_SSE2)
+	if constexpr (std::is_same_v<T, float>)
+	{
+		if (!std::is_constant_evaluated())
+			return detail::simd::multiply(q1, q2);
+	}
+#endif
+
 	return Quaternion<T>
 	{
 		q1.s * q2.s - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z,
@@ -9,6 +9,7 @@
 
 #include "mpml/matrices/matrix3.hpp"
 #include "mpml/matrices/matrix4.hpp"
+#include "mpml/matrices/affine3.hpp"
 
 #include "mpml/utilities/angle.hpp"
 
@@ -43,9 +44,14 @@ namespace mpml
 	template<typename T>
 	[[nodiscard]] constexpr Vector3<T> rotation_as_vector(Angle<> angle, const Vector3<T>& vector, const Vector3<T>& axis) noexcept
 	{
-		const Quaternion<T> rotated{ rotation_as_quaternion<T>(angle, vector, axis) };
+		return Quaternion<T>{ 0, axis }.rotate(angle).rotate_vector(vector);
+	}
 
-		return Vector3<T>{ rotated.x, rotated.y, rotated.z };
+	// Same as above with a prebuilt unit quaternion, avoids recomputing sin/cos when rotating many vectors
+	template<typename T>
+	[[nodiscard]] constexpr Vector3<T> rotation_as_vector(const Quaternion<T>& rotation, const Vector3<T>& vector) noexcept
+	{
+		return rotation.rotate_vector(vector);
 	}
 
 	template<typename T> 
@@ -54,16 +60,140 @@ namespace mpml
 		return rotation_matrix<T>(Quaternion<T>{ 0, axis }.rotate(angle));
 	}
 
+	namespace detail
+	{
+		// mat * Matrix4<T>{ rot }, the upper 3x3 block of each row is multiplied by rot and w is copied, mat_r may alias mat
+		template<typename T>
+		constexpr void rotate_to(const Matrix4<T>& mat, const Matrix3<T>& rot, Matrix4<T>& mat_r) noexcept
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const __m128 rot0{ _mm_setr_ps(rot.data[0], rot.data[1], rot.data[2], 0.f) };
+					const __m128 rot1{ _mm_setr_ps(rot.data[3], rot.data[4], rot.data[5], 0.f) };
+					const __m128 rot2{ _mm_setr_ps(rot.data[6], rot.data[7], rot.data[8], 0.f) };
+					const __m128 w_mask{ _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1)) };
+
+					for (size_t row{}; row < 16; row += 4)
+					{
+						const __m128 row_r{ _mm_loadu_ps(mat.data_ptr() + row) };
+
+						__m128 res{ _mm_and_ps(row_r, w_mask) };
+						res = simd::madd(simd::swizzle<0, 0, 0, 0>(row_r), rot0, res);
+						res = simd::madd(simd::swizzle<1, 1, 1, 1>(row_r), rot1, res);
+						res = simd::madd(simd::swizzle<2, 2, 2, 2>(row_r), rot2, res);
+
+						_mm_storeu_ps(mat_r.data_ptr() + row, res);
+					}
+
+					return;
+				}
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (std::is_same_v<T, double>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const __m256d rot0{ _mm256_setr_pd(rot.data[0], rot.data[1], rot.data[2], 0.) };
+					const __m256d rot1{ _mm256_setr_pd(rot.data[3], rot.data[4], rot.data[5], 0.) };
+					const __m256d rot2{ _mm256_setr_pd(rot.data[6], rot.data[7], rot.data[8], 0.) };
+					const __m256d w_mask{ _mm256_castsi256_pd(_mm256_setr_epi64x(0, 0, 0, -1)) };
+
+					for (size_t row{}; row < 16; row += 4)
+					{
+						const double* row_ptr{ mat.data_ptr() + row };
+
+						__m256d res{ _mm256_and_pd(_mm256_loadu_pd(row_ptr), w_mask) };
+						res = simd::madd(_mm256_broadcast_sd(row_ptr), rot0, res);
+						res = simd::madd(_mm256_broadcast_sd(row_ptr + 1), rot1, res);
+						res = simd::madd(_mm256_broadcast_sd(row_ptr + 2), rot2, res);
+
+						_mm256_storeu_pd(mat_r.data_ptr() + row, res);
+					}
+
+					return;
+				}
+			}
+#endif
+
+			for (size_t row{}; row < 16; row += 4)
+			{
+				const T x{ mat.data[row] };
+				const T y{ mat.data[row + 1] };
+				const T z{ mat.data[row + 2] };
+				const T w{ mat.data[row + 3] };
+
+				mat_r.data[row] = x * rot.data[0] + y * rot.data[3] + z * rot.data[6];
+				mat_r.data[row + 1] = x * rot.data[1] + y * rot.data[4] + z * rot.data[7];
+				mat_r.data[row + 2] = x * rot.data[2] + y * rot.data[5] + z * rot.data[8];
+				mat_r.data[row + 3] = w;
+			}
+		}
+	}
+
+	template<typename T>
+	constexpr void rotate_inplace(Matrix4<T>& mat, const Matrix3<T>& rot) noexcept
+	{
+		detail::rotate_to(mat, rot, mat);
+	}
+
+	template<typename T>
+	constexpr void rotate_inplace(Matrix4<T>& mat, const Quaternion<T>& q) noexcept
+	{
+		rotate_inplace(mat, rotation_matrix<T>(q));
+	}
+
+	template<typename T>
+	constexpr void rotate_inplace(Matrix4<T>& mat, Angle<> angle, const Vector3<T>& axis) noexcept
+	{
+		rotate_inplace(mat, rotation_matrix<T>(Quaternion<T>{ 0, axis }.rotate(angle)));
+	}
+
 	template<typename T>
 	[[nodiscard]] constexpr Matrix4<T> rotate(const Matrix4<T>& mat, Angle<> angle, const Vector3<T>& axis) noexcept
 	{
-		return mat * Matrix4<T>{rotation_matrix<T>(Quaternion<T>{ 0, axis }.rotate(angle))};
+		Matrix4<T> mat_r;
+		detail::rotate_to(mat, rotation_matrix<T>(Quaternion<T>{ 0, axis }.rotate(angle)), mat_r);
+
+		return mat_r;
 	}
 
 	template<typename T>
 	[[nodiscard]] constexpr  Matrix4<T> rotate(const Matrix4<T>& mat, const Quaternion<T>& q) noexcept
 	{
-		return mat * Matrix4<T>{rotation_matrix<T>(q)};
+		Matrix4<T> mat_r;
+		detail::rotate_to(mat, rotation_matrix<T>(q), mat_r);
+
+		return mat_r;
+	}
+
+	// Affine3 versions, a rotation has no translation so this is a single Affine3 product
+
+	template<typename T>
+	constexpr void rotate_inplace(Affine3<T>& mat, const Quaternion<T>& q) noexcept
+	{
+		mat = mat * Affine3<T>{ rotation_matrix<T>(q) };
+	}
+
+	template<typename T>
+	constexpr void rotate_inplace(Affine3<T>& mat, Angle<> angle, const Vector3<T>& axis) noexcept
+	{
+		rotate_inplace(mat, Quaternion<T>{ 0, axis }.rotate(angle));
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Affine3<T> rotate(const Affine3<T>& mat, Angle<> angle, const Vector3<T>& axis) noexcept
+	{
+		return mat * Affine3<T>{ rotation_matrix<T>(Quaternion<T>{ 0, axis }.rotate(angle)) };
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr Affine3<T> rotate(const Affine3<T>& mat, const Quaternion<T>& q) noexcept
+	{
+		return mat * Affine3<T>{ rotation_matrix<T>(q) };
 	}
 
 }
\ No newline at end of file
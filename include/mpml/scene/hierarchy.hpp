@@ -0,0 +1,315 @@
+#pragma once // hierarchy.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Propagates world matrices through parent / child hierarchies stored level by level
+//
+// Note:
+//	Nodes are kept in breadth-first order in flat arrays (parents, locals, worlds, change flags), so every depth level
+//	is one contiguous range and every parent sits in an earlier level than its children.
+//	world = local * parent_world, the Matrix4 / Affine3 composition order: the local transform applies first.
+//	update() only recomputes the nodes whose local matrix was set since the last update, and their descendants.
+//	Levels are processed in order, each one split in chunks that worker threads pick up, with a barrier between levels.
+//	Hierarchies under min_nodes_per_thread nodes per thread run on the calling thread.
+//	This header uses std::jthread, link with Threads::Threads where the platform needs it.
+// ===================================================
+
+
+#include <span>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <barrier>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+
+
+namespace mpml
+{
+
+
+	// M is a matrix type with an Identity and operator*, e.g. Matrix4<T> or Affine3<T>
+	template<typename M>
+	class TransformHierarchy
+	{
+	public:
+
+		using matrix_type = M;
+
+		static constexpr std::uint32_t no_parent{ std::numeric_limits<std::uint32_t>::max() };
+
+		// Nodes per chunk handed to a worker, and the least nodes worth one more thread
+		static constexpr size_t chunk_size{ 1024 };
+		static constexpr size_t min_nodes_per_thread{ 16384 };
+
+
+		// Initialization
+
+		// parents[i] is the parent of node i, or no_parent for a root. Every matrix starts as the identity.
+		// Throws std::out_of_range for a parent that is not a node and std::invalid_argument for a cycle
+		explicit TransformHierarchy(std::span<const std::uint32_t> parents);
+
+
+		// Nodes
+
+		[[nodiscard]] size_t size() const noexcept;
+		[[nodiscard]] size_t levels() const noexcept;
+
+		// Position of node in the breadth-first order of world_matrices()
+		[[nodiscard]] std::uint32_t slot(std::uint32_t node) const;
+
+		void set_local(std::uint32_t node, const M& local);
+		[[nodiscard]] const M& local(std::uint32_t node) const;
+
+		// Up to date after update()
+		[[nodiscard]] const M& world(std::uint32_t node) const;
+		[[nodiscard]] std::span<const M> world_matrices() const noexcept;
+
+
+		// Propagation
+
+		// True when a local matrix was set since the last update()
+		[[nodiscard]] bool dirty() const noexcept;
+
+		void update(size_t thread_count = std::thread::hardware_concurrency());
+
+
+	private:
+
+		void update_range(size_t begin, size_t end) noexcept;
+
+		std::vector<std::uint32_t> node_slots;		// node -> slot
+		std::vector<std::uint32_t> parent_slots;	// slot -> slot of the parent, no_parent for roots
+		std::vector<size_t> level_starts;			// level L spans [level_starts[L], level_starts[L + 1])
+
+		std::vector<M> locals;
+		std::vector<M> worlds;
+		std::vector<std::uint8_t> changed;
+
+		bool pending{};
+	};
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename M>
+	inline TransformHierarchy<M>::TransformHierarchy(std::span<const std::uint32_t> parents)
+	{
+		const size_t count{ parents.size() };
+
+		if (count >= no_parent)
+			throw std::length_error("Too many nodes");
+
+		// Children of each node, grouped by parent
+		std::vector<std::uint32_t> child_starts(count + 1);
+
+		for (const std::uint32_t parent : parents)
+		{
+			if (parent == no_parent)
+				continue;
+
+			if (parent >= count)
+				throw std::out_of_range("Parent index out of range");
+
+			child_starts[parent + 1]++;
+		}
+
+		for (size_t i{}; i < count; i++)
+			child_starts[i + 1] += child_starts[i];
+
+		std::vector<std::uint32_t> children(count);
+		std::vector<std::uint32_t> filled(child_starts.begin(), child_starts.end() - 1);
+
+		for (size_t i{}; i < count; i++)
+		{
+			if (parents[i] != no_parent)
+				children[filled[parents[i]]++] = static_cast<std::uint32_t>(i);
+		}
+
+		// Breadth-first order, one level at a time
+		std::vector<std::uint32_t> order;
+		order.reserve(count);
+
+		for (size_t i{}; i < count; i++)
+		{
+			if (parents[i] == no_parent)
+				order.push_back(static_cast<std::uint32_t>(i));
+		}
+
+		level_starts.push_back(0);
+
+		for (size_t level_begin{}; level_begin < order.size();)
+		{
+			const size_t level_end{ order.size() };
+
+			for (size_t i{ level_begin }; i < level_end; i++)
+				order.insert(order.end(), children.begin() + child_starts[order[i]], children.begin() + child_starts[order[i] + 1]);
+
+			level_starts.push_back(level_end);
+			level_begin = level_end;
+		}
+
+		// Nodes on a cycle are never reached from a root
+		if (order.size() != count)
+			throw std::invalid_argument("The hierarchy contains a cycle");
+
+		node_slots.resize(count);
+		for (size_t i{}; i < count; i++)
+			node_slots[order[i]] = static_cast<std::uint32_t>(i);
+
+		parent_slots.resize(count);
+		for (size_t i{}; i < count; i++)
+			parent_slots[i] = parents[order[i]] == no_parent ? no_parent : node_slots[parents[order[i]]];
+
+		locals.assign(count, M::Identity);
+		worlds.assign(count, M::Identity);
+		changed.assign(count, 0);
+	}
+
+
+	// Nodes
+	template<typename M>
+	inline size_t TransformHierarchy<M>::size() const noexcept
+	{
+		return node_slots.size();
+	}
+
+	template<typename M>
+	inline size_t TransformHierarchy<M>::levels() const noexcept
+	{
+		return level_starts.size() - 1;
+	}
+
+	template<typename M>
+	inline std::uint32_t TransformHierarchy<M>::slot(std::uint32_t node) const
+	{
+		if (node >= node_slots.size())
+			throw std::out_of_range("Index out of range");
+
+		return node_slots[node];
+	}
+
+	template<typename M>
+	inline void TransformHierarchy<M>::set_local(std::uint32_t node, const M& local)
+	{
+		const std::uint32_t index{ slot(node) };
+
+		locals[index] = local;
+		changed[index] = 1;
+		pending = true;
+	}
+
+	template<typename M>
+	inline const M& TransformHierarchy<M>::local(std::uint32_t node) const
+	{
+		return locals[slot(node)];
+	}
+
+	template<typename M>
+	inline const M& TransformHierarchy<M>::world(std::uint32_t node) const
+	{
+		return worlds[slot(node)];
+	}
+
+	template<typename M>
+	inline std::span<const M> TransformHierarchy<M>::world_matrices() const noexcept
+	{
+		return worlds;
+	}
+
+
+	// Propagation
+	template<typename M>
+	inline bool TransformHierarchy<M>::dirty() const noexcept
+	{
+		return pending;
+	}
+
+	template<typename M>
+	inline void TransformHierarchy<M>::update(size_t thread_count)
+	{
+		if (!pending)
+			return;
+
+		const size_t workers{ std::clamp<size_t>(std::min(thread_count, size() / min_nodes_per_thread), 1, size()) };
+
+		if (workers == 1)
+		{
+			update_range(0, size());
+		}
+		else
+		{
+			// Parents are final once their level is done, the barrier keeps every worker on the same level
+			std::barrier sync{ static_cast<std::ptrdiff_t>(workers) };
+			const std::unique_ptr<std::atomic<size_t>[]> cursors{ new std::atomic<size_t>[levels()] };
+
+			for (size_t level{}; level < levels(); level++)
+				cursors[level].store(level_starts[level], std::memory_order_relaxed);
+
+			const auto work{ [&] {
+				for (size_t level{}; level < levels(); level++)
+				{
+					const size_t level_end{ level_starts[level + 1] };
+
+					for (size_t begin{ cursors[level].fetch_add(chunk_size, std::memory_order_relaxed) }; begin < level_end;
+						begin = cursors[level].fetch_add(chunk_size, std::memory_order_relaxed))
+						update_range(begin, std::min(begin + chunk_size, level_end));
+
+					sync.arrive_and_wait();
+				}
+			} };
+
+			std::vector<std::jthread> threads;
+			threads.reserve(workers - 1);
+
+			for (size_t i{ 1 }; i < workers; i++)
+			{
+				try
+				{
+					threads.emplace_back(work);
+				}
+				catch (const std::system_error&)
+				{
+					// Fewer threads than planned, the chunks are shared among the ones running
+					for (; i < workers; i++)
+						sync.arrive_and_drop();
+				}
+			}
+
+			work();
+		}
+
+		std::fill(changed.begin(), changed.end(), std::uint8_t{});
+		pending = false;
+	}
+
+	template<typename M>
+	inline void TransformHierarchy<M>::update_range(size_t begin, size_t end) noexcept
+	{
+		for (size_t i{ begin }; i < end; i++)
+		{
+			const std::uint32_t parent{ parent_slots[i] };
+
+			if (parent == no_parent)
+			{
+				if (changed[i])
+					worlds[i] = locals[i];
+			}
+			else if (changed[i] | changed[parent])
+			{
+				changed[i] = 1;
+				worlds[i] = locals[i] * worlds[parent];
+			}
+		}
+	}
+
+
+
+} // mpml
@@ -0,0 +1,295 @@
+#pragma once // transform.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines a translation / rotation / scale transform that caches its matrix
+//
+// Note:
+//	compose() equals translate(rotate(scale(Matrix4<T>::Identity, scale), rotation), position):
+//	scale first, then rotation, then translation, written straight from the quaternion without any product.
+//	For float, compose() and inverse() build the rotation rows in SSE registers, scalar rows packed into vectors
+//	would cost as much as the three products they replace.
+//	matrix() returns the same matrix from a cache that only the first call after a setter rebuilds,
+//	so reading it every frame costs nothing for static entities. Updating the cache is a write, hence matrix() is not const.
+//	The rotation must be a unit quaternion, inverse() also requires a scale without zero components.
+// ===================================================
+
+
+#include <cassert>
+
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/matrices/matrix4.hpp"
+#include "mpml/matrices/affine3.hpp"
+#include "mpml/quaternions/quaternion.hpp"
+#include "mpml/quaternions/transforms.hpp"
+
+
+namespace mpml
+{
+
+
+	template<typename T>
+	class Transform
+	{
+	public:
+
+		// Initialization
+
+		constexpr Transform() noexcept = default;
+
+		constexpr Transform(const Vector3<T>& position, const Quaternion<T>& rotation = Quaternion<T>{ 1, 0, 0, 0 }, const Vector3<T>& scale = Vector3<T>{ 1, 1, 1 }) noexcept;
+
+
+		// Components
+
+		[[nodiscard]] constexpr const Vector3<T>& position() const noexcept;
+		[[nodiscard]] constexpr const Quaternion<T>& rotation() const noexcept;
+		[[nodiscard]] constexpr const Vector3<T>& scale() const noexcept;
+
+		constexpr void set_position(const Vector3<T>& position) noexcept;
+		constexpr void set_rotation(const Quaternion<T>& rotation) noexcept;
+		constexpr void set_scale(const Vector3<T>& scale) noexcept;
+
+
+		// Matrices
+
+		// Rebuilt only when a component changed since the last call
+		[[nodiscard]] constexpr const Matrix4<T>& matrix() noexcept;
+		// Always built, the cache is left untouched
+		[[nodiscard]] constexpr Matrix4<T> compose() const noexcept;
+		[[nodiscard]] constexpr Affine3<T> affine() const noexcept;
+
+		// Built from the components as scale^-1 * rotation^-1 * translation^-1, no general inverse involved
+		[[nodiscard]] constexpr Matrix4<T> inverse() const noexcept;
+
+		// True when matrix() will rebuild the cached matrix
+		[[nodiscard]] constexpr bool dirty() const noexcept;
+
+
+	private:
+
+		Vector3<T> position_value{ 0, 0, 0 };
+		Quaternion<T> rotation_value{ 1, 0, 0, 0 };
+		Vector3<T> scale_value{ 1, 1, 1 };
+
+		Matrix4<T> cached_matrix{ Matrix4<T>::Identity };
+		bool matrix_dirty{ false };
+	};
+
+
+
+	namespace detail::simd
+	{
+
+#if defined(MPML_SIMD_SSE2)
+
+		// The rows of rotation_matrix(q) with w = 0, q being a unit quaternion with lanes s, x, y, z
+		inline void rotation_rows(__m128 q, __m128& row0, __m128& row1, __m128& row2) noexcept
+		{
+			const __m128 twice{ _mm_add_ps(q, q) };
+			const __m128 squares{ _mm_mul_ps(q, twice) };
+
+			// 1 - 2(yy + zz), 1 - 2(xx + zz), 1 - 2(xx + yy)
+			const __m128 diagonal{ _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.f), swizzle<2, 1, 1, 0>(squares)), swizzle<3, 3, 2, 0>(squares)) };
+
+			// 2xy, 2xz, 2yz against 2sz, 2sy, 2sx
+			const __m128 products{ _mm_mul_ps(swizzle<1, 1, 2, 0>(q), swizzle<2, 3, 3, 0>(twice)) };
+			const __m128 s_products{ _mm_mul_ps(swizzle<0, 0, 0, 0>(q), swizzle<3, 2, 1, 0>(twice)) };
+
+			const __m128 plus{ _mm_add_ps(products, s_products) };
+			const __m128 minus{ _mm_sub_ps(products, s_products) };
+			const __m128 w_mask{ _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)) };
+
+			row0 = _mm_and_ps(shuffle<0, 1, 1, 3>(_mm_unpacklo_ps(diagonal, minus), plus), w_mask);
+			row1 = _mm_and_ps(shuffle<0, 3, 2, 3>(_mm_unpacklo_ps(plus, diagonal), minus), w_mask);
+			row2 = _mm_and_ps(shuffle<0, 2, 2, 3>(shuffle<1, 1, 2, 2>(minus, plus), diagonal), w_mask);
+		}
+
+#endif
+
+	} // detail::simd
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename T>
+	inline constexpr Transform<T>::Transform(const Vector3<T>& position, const Quaternion<T>& rotation, const Vector3<T>& scale) noexcept
+		: position_value{ position }, rotation_value{ rotation }, scale_value{ scale }, matrix_dirty{ true }
+	{
+	}
+
+
+	// Components
+	template<typename T>
+	inline constexpr const Vector3<T>& Transform<T>::position() const noexcept
+	{
+		return position_value;
+	}
+
+	template<typename T>
+	inline constexpr const Quaternion<T>& Transform<T>::rotation() const noexcept
+	{
+		return rotation_value;
+	}
+
+	template<typename T>
+	inline constexpr const Vector3<T>& Transform<T>::scale() const noexcept
+	{
+		return scale_value;
+	}
+
+	template<typename T>
+	inline constexpr void Transform<T>::set_position(const Vector3<T>& position) noexcept
+	{
+		position_value = position;
+		matrix_dirty = true;
+	}
+
+	template<typename T>
+	inline constexpr void Transform<T>::set_rotation(const Quaternion<T>& rotation) noexcept
+	{
+		rotation_value = rotation;
+		matrix_dirty = true;
+	}
+
+	template<typename T>
+	inline constexpr void Transform<T>::set_scale(const Vector3<T>& scale) noexcept
+	{
+		scale_value = scale;
+		matrix_dirty = true;
+	}
+
+
+	// Matrices
+	template<typename T>
+	inline constexpr const Matrix4<T>& Transform<T>::matrix() noexcept
+	{
+		if (matrix_dirty)
+		{
+			cached_matrix = compose();
+			matrix_dirty = false;
+		}
+
+		return cached_matrix;
+	}
+
+	template<typename T>
+	inline constexpr Matrix4<T> Transform<T>::compose() const noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				__m128 row0, row1, row2;
+				detail::simd::rotation_rows(_mm_load_ps(rotation_value.data_ptr()), row0, row1, row2);
+
+				Matrix4<T> mat_r;
+				_mm_storeu_ps(mat_r.data_ptr(), _mm_mul_ps(row0, _mm_set1_ps(scale_value.x)));
+				_mm_storeu_ps(mat_r.data_ptr() + 4, _mm_mul_ps(row1, _mm_set1_ps(scale_value.y)));
+				_mm_storeu_ps(mat_r.data_ptr() + 8, _mm_mul_ps(row2, _mm_set1_ps(scale_value.z)));
+				_mm_storeu_ps(mat_r.data_ptr() + 12, _mm_setr_ps(position_value.x, position_value.y, position_value.z, 1.f));
+
+				return mat_r;
+			}
+		}
+#endif
+
+		// Row k of the rotation scaled by scale[k], then the translation row
+		const Matrix3<T> rot{ rotation_matrix<T>(rotation_value) };
+
+		return Matrix4<T>
+		{
+			rot.data[0] * scale_value.x, rot.data[1] * scale_value.x, rot.data[2] * scale_value.x, T{},
+			rot.data[3] * scale_value.y, rot.data[4] * scale_value.y, rot.data[5] * scale_value.y, T{},
+			rot.data[6] * scale_value.z, rot.data[7] * scale_value.z, rot.data[8] * scale_value.z, T{},
+			position_value.x, position_value.y, position_value.z, T{ 1 }
+		};
+	}
+
+	template<typename T>
+	inline constexpr Affine3<T> Transform<T>::affine() const noexcept
+	{
+		const Matrix3<T> rot{ rotation_matrix<T>(rotation_value) };
+
+		return Affine3<T>
+		{
+			rot.data[0] * scale_value.x, rot.data[3] * scale_value.y, rot.data[6] * scale_value.z, position_value.x,
+			rot.data[1] * scale_value.x, rot.data[4] * scale_value.y, rot.data[7] * scale_value.z, position_value.y,
+			rot.data[2] * scale_value.x, rot.data[5] * scale_value.y, rot.data[8] * scale_value.z, position_value.z
+		};
+	}
+
+	template<typename T>
+	inline constexpr Matrix4<T> Transform<T>::inverse() const noexcept
+	{
+		assert(scale_value.x != T{} && scale_value.y != T{} && scale_value.z != T{} && "Transform::inverse() requires a non-zero scale");
+
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				// The transposed rotation is the one of the conjugate, its rows are divided by the scale lane by lane
+				const __m128 conjugate{ _mm_xor_ps(_mm_load_ps(rotation_value.data_ptr()), _mm_setr_ps(-0.f, 0.f, 0.f, 0.f)) };
+				const __m128 inv_scale{ _mm_div_ps(_mm_setr_ps(1.f, 1.f, 1.f, 0.f), _mm_setr_ps(scale_value.x, scale_value.y, scale_value.z, 1.f)) };
+
+				__m128 row0, row1, row2;
+				detail::simd::rotation_rows(conjugate, row0, row1, row2);
+
+				row0 = _mm_mul_ps(row0, inv_scale);
+				row1 = _mm_mul_ps(row1, inv_scale);
+				row2 = _mm_mul_ps(row2, inv_scale);
+
+				__m128 translation{ _mm_mul_ps(_mm_set1_ps(position_value.x), row0) };
+				translation = detail::simd::madd(_mm_set1_ps(position_value.y), row1, translation);
+				translation = detail::simd::madd(_mm_set1_ps(position_value.z), row2, translation);
+
+				Matrix4<T> mat_r;
+				_mm_storeu_ps(mat_r.data_ptr(), row0);
+				_mm_storeu_ps(mat_r.data_ptr() + 4, row1);
+				_mm_storeu_ps(mat_r.data_ptr() + 8, row2);
+				_mm_storeu_ps(mat_r.data_ptr() + 12, _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), translation));
+
+				return mat_r;
+			}
+		}
+#endif
+
+		// The transposed rotation with column k divided by scale[k]
+		const Matrix3<T> rot{ rotation_matrix<T>(rotation_value) };
+
+		const T inv_x{ T{ 1 } / scale_value.x };
+		const T inv_y{ T{ 1 } / scale_value.y };
+		const T inv_z{ T{ 1 } / scale_value.z };
+
+		const T a{ rot.data[0] * inv_x }, b{ rot.data[3] * inv_y }, c{ rot.data[6] * inv_z };
+		const T e{ rot.data[1] * inv_x }, f{ rot.data[4] * inv_y }, g{ rot.data[7] * inv_z };
+		const T i{ rot.data[2] * inv_x }, j{ rot.data[5] * inv_y }, k{ rot.data[8] * inv_z };
+
+		const Vector3<T>& pos{ position_value };
+
+		return Matrix4<T>
+		{
+			a, b, c, T{},
+			e, f, g, T{},
+			i, j, k, T{},
+			-(pos.x * a + pos.y * e + pos.z * i),
+			-(pos.x * b + pos.y * f + pos.z * j),
+			-(pos.x * c + pos.y * g + pos.z * k),
+			T{ 1 }
+		};
+	}
+
+	template<typename T>
+	inline constexpr bool Transform<T>::dirty() const noexcept
+	{
+		return matrix_dirty;
+	}
+
+
+
+} // mpml
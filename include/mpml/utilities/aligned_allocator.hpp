@@ -0,0 +1,66 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Standard allocator returning storage aligned on Alignment bytes
+// Used by the containers whose SIMD paths rely on aligned loads.
+// ===================================================
+
+
+// Dependencies
+#include <new>
+#include <cstddef>
+
+
+namespace mpml
+{
+
+	template<typename T, std::size_t Alignment = 64>
+	class AlignedAllocator
+	{
+	public:
+
+		static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two at least as large as alignof(T)");
+
+		using value_type = T;
+
+		template<typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+
+		// Initialization
+
+		constexpr AlignedAllocator() noexcept = default;
+
+		template<typename U>
+		constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+		{
+		}
+
+
+		// Operations
+
+		[[nodiscard]] T* allocate(std::size_t count)
+		{
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+		}
+
+		void deallocate(T* ptr, std::size_t) noexcept
+		{
+			::operator delete(ptr, std::align_val_t{ Alignment });
+		}
+
+
+		// Overloads
+
+		template<typename U>
+		[[nodiscard]] constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+		{
+			return true;
+		}
+	};
+
+} // mpml
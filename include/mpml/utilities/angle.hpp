@@ -52,9 +52,10 @@ namespace mpml
 			return Angle::from_radians(this->angle_rad + t.angle_rad);
 		}
 
-		[[nodiscard]] constexpr Angle operator+=(Angle t) noexcept
+		constexpr Angle& operator+=(Angle t) noexcept
 		{
 			*this = *this + t;
+			return *this;
 		}
 
 
@@ -0,0 +1,672 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines opt-in expression templates for the Vector2/3/4 and Matrix2/3/4 arithmetic
+//
+// Note:
+//	The usual operators are left untouched, an expression starts from expr::lazy():
+//		Vector3<float> r = expr::lazy(a) * s + b * t - c;	// a single pass, no intermediate Vector3
+//		Vector4<float> p = expr::lazy(M1) * M2 * v;		// evaluated as M1 * (M2 * v)
+//	Braces do not take the implicit conversion of an expression (r{ expr } is a list-initialization), use = or eval().
+//	+, - (binary and unary), * and / by a scalar build element-wise nodes, evaluated in one pass on conversion,
+//	eval(), += or -=, with the same rounding as the eager operators (Vector4 keeps the w = 1 of its operators).
+//	Matrix products stay lazy until they meet a vector: a chain of them times a vector becomes matrix-vector products,
+//	run by the SIMD detail::transform kernels for Matrix4<float> and Matrix4<double>. That is where the layer saves time,
+//	the element-wise chains compile to the same loop as the eager operators, whose temporaries GCC already removes at -O2.
+//	Any other product, and the non-trivial operands of a product, are evaluated once through the eager operators and their SIMD kernels.
+//	Nodes refer to the vectors and matrices they are built from, so an expression has to be evaluated
+//	within the full-expression that created its temporaries; keeping one in an auto variable only works on named operands.
+// ===================================================
+
+
+// Dependencies
+#include <cstddef>
+#include <utility>
+#include <concepts>
+#include <type_traits>
+
+#include "mpml/vectors/vector2.hpp"
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/vectors/vector4.hpp"
+#include "mpml/matrices/matrix2.hpp"
+#include "mpml/matrices/matrix3.hpp"
+#include "mpml/matrices/matrix4.hpp"
+
+
+namespace mpml::detail::expr
+{
+
+	// Element access of the types an expression works on
+	// size is the dimension checked by the products, elementwise_size the elements the arithmetic operators write
+
+	template<typename V>
+	struct shape
+	{
+		static constexpr bool valid{ false };
+	};
+
+	template<typename T>
+	struct shape<Vector2<T>>
+	{
+		static constexpr bool valid{ true };
+		static constexpr bool is_matrix{ false };
+		static constexpr size_t size{ 2 };
+		static constexpr size_t elementwise_size{ 2 };
+
+		using scalar_type = T;
+
+		template<size_t I>
+		[[nodiscard]] static constexpr const T& get(const Vector2<T>& vec) noexcept
+		{
+			if constexpr (I == 0)
+				return vec.x;
+			else
+				return vec.y;
+		}
+	};
+
+	template<typename T>
+	struct shape<Vector3<T>>
+	{
+		static constexpr bool valid{ true };
+		static constexpr bool is_matrix{ false };
+		static constexpr size_t size{ 3 };
+		static constexpr size_t elementwise_size{ 3 };
+
+		using scalar_type = T;
+
+		template<size_t I>
+		[[nodiscard]] static constexpr const T& get(const Vector3<T>& vec) noexcept
+		{
+			if constexpr (I == 0)
+				return vec.x;
+			else if constexpr (I == 1)
+				return vec.y;
+			else
+				return vec.z;
+		}
+	};
+
+	// The Vector4 operators work on x, y and z and set w to 1
+	template<typename T>
+	struct shape<Vector4<T>>
+	{
+		static constexpr bool valid{ true };
+		static constexpr bool is_matrix{ false };
+		static constexpr size_t size{ 4 };
+		static constexpr size_t elementwise_size{ 3 };
+
+		using scalar_type = T;
+
+		template<size_t I>
+		[[nodiscard]] static constexpr const T& get(const Vector4<T>& vec) noexcept
+		{
+			if constexpr (I == 0)
+				return vec.x;
+			else if constexpr (I == 1)
+				return vec.y;
+			else
+				return vec.z;
+		}
+	};
+
+	// Matrices go through data, in the order of their constructors
+	template<typename M, typename T, size_t N>
+	struct matrix_shape
+	{
+		static constexpr bool valid{ true };
+		static constexpr bool is_matrix{ true };
+		static constexpr size_t order{ N };
+		static constexpr size_t size{ N };
+		static constexpr size_t elementwise_size{ N * N };
+
+		using scalar_type = T;
+
+		template<size_t I>
+		[[nodiscard]] static constexpr const T& get(const M& mat) noexcept
+		{
+			return mat.data[I];
+		}
+	};
+
+	template<typename T>
+	struct shape<Matrix2<T>> : matrix_shape<Matrix2<T>, T, 2> {};
+
+	template<typename T>
+	struct shape<Matrix3<T>> : matrix_shape<Matrix3<T>, T, 3> {};
+
+	template<typename T>
+	struct shape<Matrix4<T>> : matrix_shape<Matrix4<T>, T, 4> {};
+
+
+	// Element operations
+
+	struct add
+	{
+		template<typename T>
+		[[nodiscard]] static constexpr T apply(const T& a, const T& b) noexcept { return T{ a + b }; }
+	};
+
+	struct sub
+	{
+		template<typename T>
+		[[nodiscard]] static constexpr T apply(const T& a, const T& b) noexcept { return T{ a - b }; }
+	};
+
+	struct mul
+	{
+		template<typename T>
+		[[nodiscard]] static constexpr T apply(const T& a, const T& b) noexcept { return T{ a * b }; }
+	};
+
+	struct div
+	{
+		template<typename T>
+		[[nodiscard]] static constexpr T apply(const T& a, const T& b) noexcept { return T{ a / b }; }
+	};
+
+} // mpml::detail::expr
+
+namespace mpml::expr
+{
+
+	template<typename Derived, typename V>
+	class Expression;
+
+
+	// Type traits
+
+	template<typename E>
+	concept expression = requires { typename E::value_type; }
+		&& std::is_base_of_v<Expression<E, typename E::value_type>, E>;
+
+	template<typename X>
+	concept operand = expression<X> || detail::expr::shape<X>::valid;
+
+}
+
+namespace mpml::detail::expr
+{
+
+	template<typename X>
+	struct value_of
+	{
+		using type = X;
+	};
+
+	template<mpml::expr::expression X>
+	struct value_of<X>
+	{
+		using type = typename X::value_type;
+	};
+
+	// The vector or matrix an operand evaluates to
+	template<typename X>
+	using value_t = typename value_of<X>::type;
+
+	template<typename X>
+	using scalar_t = typename shape<value_t<X>>::scalar_type;
+
+	template<typename X>
+	inline constexpr bool is_matrix_v{ shape<value_t<X>>::is_matrix };
+
+	template<typename L, typename R>
+	inline constexpr bool same_value_v{ std::is_same_v<value_t<L>, value_t<R>> };
+
+	// A matrix of order N with a vector of size N
+	template<typename M, typename V>
+	inline constexpr bool transformable_v{ is_matrix_v<M> && !is_matrix_v<V>
+		&& shape<value_t<M>>::order == shape<value_t<V>>::size && std::is_same_v<scalar_t<M>, scalar_t<V>> };
+
+	template<typename S, typename X>
+	concept scalar_of = !mpml::expr::operand<S> && std::convertible_to<const S&, scalar_t<X>>;
+
+} // mpml::detail::expr
+
+namespace mpml::expr
+{
+
+	// Base of every node: the evaluated type and the conversion to it
+	template<typename Derived, typename V>
+	class Expression
+	{
+	public:
+
+		using value_type = V;
+
+		[[nodiscard]] constexpr V eval() const noexcept;
+		[[nodiscard]] constexpr operator V() const noexcept;
+
+	private:
+
+		template<size_t... I>
+		[[nodiscard]] constexpr V gather(std::index_sequence<I...>) const noexcept;
+	};
+
+
+	// Leaves
+
+	// Refers to a vector or a matrix, what expr::lazy() returns
+	template<typename V>
+	class Terminal : public Expression<Terminal<V>, V>
+	{
+	public:
+
+		constexpr explicit Terminal(const V& value_) noexcept;
+
+		template<size_t I>
+		[[nodiscard]] constexpr const auto& get() const noexcept;
+
+		const V& value;
+	};
+
+	// Holds an evaluated product or product operand
+	template<typename V>
+	class Value : public Expression<Value<V>, V>
+	{
+	public:
+
+		constexpr explicit Value(const V& value_) noexcept;
+
+		template<size_t I>
+		[[nodiscard]] constexpr const auto& get() const noexcept;
+
+		V value;
+	};
+
+
+	// Element-wise nodes
+
+	template<typename Op, typename L, typename R>
+	class Binary : public Expression<Binary<Op, L, R>, detail::expr::value_t<L>>
+	{
+	public:
+
+		constexpr Binary(const L& lhs_, const R& rhs_) noexcept;
+
+		template<size_t I>
+		[[nodiscard]] constexpr auto get() const noexcept;
+
+		L lhs;
+		R rhs;
+	};
+
+	// Every element with a scalar, on the right
+	template<typename Op, typename E>
+	class Scaled : public Expression<Scaled<Op, E>, detail::expr::value_t<E>>
+	{
+	public:
+
+		using scalar_type = detail::expr::scalar_t<E>;
+
+		constexpr Scaled(const E& expr_, const scalar_type& k_) noexcept;
+
+		template<size_t I>
+		[[nodiscard]] constexpr auto get() const noexcept;
+
+		E expr;
+		scalar_type k;
+	};
+
+	template<typename E>
+	class Negated : public Expression<Negated<E>, detail::expr::value_t<E>>
+	{
+	public:
+
+		constexpr explicit Negated(const E& expr_) noexcept;
+
+		template<size_t I>
+		[[nodiscard]] constexpr auto get() const noexcept;
+
+		E expr;
+	};
+
+
+	// Products
+
+	// Matrix times matrix, left lazy until a vector or an evaluation comes
+	template<typename L, typename R>
+	class Product : public Expression<Product<L, R>, detail::expr::value_t<L>>
+	{
+	public:
+
+		constexpr Product(const L& lhs_, const R& rhs_) noexcept;
+
+		[[nodiscard]] constexpr detail::expr::value_t<L> evaluate() const noexcept;
+
+		L lhs;
+		R rhs;
+	};
+
+	// Matrix times vector
+	template<typename M, typename V>
+	class Transformed : public Expression<Transformed<M, V>, detail::expr::value_t<V>>
+	{
+	public:
+
+		constexpr Transformed(const M& matrix_, const V& vector_) noexcept;
+
+		[[nodiscard]] constexpr detail::expr::value_t<V> evaluate() const noexcept;
+
+		M matrix;
+		V vector;
+	};
+
+}
+
+namespace mpml::detail::expr
+{
+
+	template<typename X>
+	struct is_product : std::false_type {};
+
+	template<typename L, typename R>
+	struct is_product<mpml::expr::Product<L, R>> : std::true_type {};
+
+	template<typename M, typename V>
+	struct is_product<mpml::expr::Transformed<M, V>> : std::true_type {};
+
+	// Products are evaluated as a whole, the other nodes element by element
+	template<typename X>
+	inline constexpr bool is_product_v{ is_product<X>::value };
+
+	template<typename X>
+	struct is_matrix_product : std::false_type {};
+
+	template<typename L, typename R>
+	struct is_matrix_product<mpml::expr::Product<L, R>> : std::true_type {};
+
+	template<typename X>
+	struct is_held : std::false_type {};
+
+	template<typename V>
+	struct is_held<mpml::expr::Terminal<V>> : std::true_type {};
+
+	template<typename V>
+	struct is_held<mpml::expr::Value<V>> : std::true_type {};
+
+	// Operand of an element-wise node: products get evaluated, vectors and matrices referred to
+	template<typename X>
+	[[nodiscard]] constexpr auto elementwise_operand(const X& x) noexcept
+	{
+		if constexpr (is_product_v<X>)
+			return mpml::expr::Value<value_t<X>>{ x.eval() };
+		else if constexpr (mpml::expr::expression<X>)
+			return x;
+		else
+			return mpml::expr::Terminal<X>{ x };
+	}
+
+	// Operand of a product: each of its elements is read several times, so anything but a lazy matrix product gets evaluated first
+	template<typename X>
+	[[nodiscard]] constexpr auto product_operand(const X& x) noexcept
+	{
+		if constexpr (is_held<X>::value || is_matrix_product<X>::value)
+			return x;
+		else if constexpr (mpml::expr::expression<X>)
+			return mpml::expr::Value<value_t<X>>{ x.eval() };
+		else
+			return mpml::expr::Terminal<X>{ x };
+	}
+
+	// The vector or matrix of an operand of a product, evaluating the lazy ones
+	template<typename X>
+	[[nodiscard]] constexpr decltype(auto) held_value(const X& x) noexcept
+	{
+		if constexpr (is_held<X>::value)
+			return (x.value);
+		else
+			return x.eval();
+	}
+
+} // mpml::detail::expr
+
+namespace mpml::expr
+{
+
+	// Expression
+	template<typename Derived, typename V>
+	inline constexpr V Expression<Derived, V>::eval() const noexcept
+	{
+		if constexpr (detail::expr::is_product_v<Derived>)
+			return static_cast<const Derived&>(*this).evaluate();
+		else
+			return gather(std::make_index_sequence<detail::expr::shape<V>::elementwise_size>{});
+	}
+
+	template<typename Derived, typename V>
+	inline constexpr Expression<Derived, V>::operator V() const noexcept
+	{
+		return eval();
+	}
+
+	template<typename Derived, typename V>
+	template<size_t... I>
+	inline constexpr V Expression<Derived, V>::gather(std::index_sequence<I...>) const noexcept
+	{
+		return V{ static_cast<const Derived&>(*this).template get<I>()... };
+	}
+
+
+	// Terminal
+	template<typename V>
+	inline constexpr Terminal<V>::Terminal(const V& value_) noexcept
+		: value{ value_ }
+	{
+	}
+
+	template<typename V>
+	template<size_t I>
+	inline constexpr const auto& Terminal<V>::get() const noexcept
+	{
+		return detail::expr::shape<V>::template get<I>(value);
+	}
+
+
+	// Value
+	template<typename V>
+	inline constexpr Value<V>::Value(const V& value_) noexcept
+		: value{ value_ }
+	{
+	}
+
+	template<typename V>
+	template<size_t I>
+	inline constexpr const auto& Value<V>::get() const noexcept
+	{
+		return detail::expr::shape<V>::template get<I>(value);
+	}
+
+
+	// Binary
+	template<typename Op, typename L, typename R>
+	inline constexpr Binary<Op, L, R>::Binary(const L& lhs_, const R& rhs_) noexcept
+		: lhs{ lhs_ }, rhs{ rhs_ }
+	{
+	}
+
+	template<typename Op, typename L, typename R>
+	template<size_t I>
+	inline constexpr auto Binary<Op, L, R>::get() const noexcept
+	{
+		return Op::template apply<detail::expr::scalar_t<L>>(lhs.template get<I>(), rhs.template get<I>());
+	}
+
+
+	// Scaled
+	template<typename Op, typename E>
+	inline constexpr Scaled<Op, E>::Scaled(const E& expr_, const scalar_type& k_) noexcept
+		: expr{ expr_ }, k{ k_ }
+	{
+	}
+
+	template<typename Op, typename E>
+	template<size_t I>
+	inline constexpr auto Scaled<Op, E>::get() const noexcept
+	{
+		return Op::template apply<scalar_type>(expr.template get<I>(), k);
+	}
+
+
+	// Negated
+	template<typename E>
+	inline constexpr Negated<E>::Negated(const E& expr_) noexcept
+		: expr{ expr_ }
+	{
+	}
+
+	template<typename E>
+	template<size_t I>
+	inline constexpr auto Negated<E>::get() const noexcept
+	{
+		return detail::expr::scalar_t<E>{ -expr.template get<I>() };
+	}
+
+
+	// Product
+	template<typename L, typename R>
+	inline constexpr Product<L, R>::Product(const L& lhs_, const R& rhs_) noexcept
+		: lhs{ lhs_ }, rhs{ rhs_ }
+	{
+	}
+
+	template<typename L, typename R>
+	inline constexpr detail::expr::value_t<L> Product<L, R>::evaluate() const noexcept
+	{
+		return detail::expr::held_value(lhs) * detail::expr::held_value(rhs);
+	}
+
+
+	// Transformed
+	template<typename M, typename V>
+	inline constexpr Transformed<M, V>::Transformed(const M& matrix_, const V& vector_) noexcept
+		: matrix{ matrix_ }, vector{ vector_ }
+	{
+	}
+
+	template<typename M, typename V>
+	inline constexpr detail::expr::value_t<V> Transformed<M, V>::evaluate() const noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<detail::expr::value_t<M>, Matrix4<float>> || std::is_same_v<detail::expr::value_t<M>, Matrix4<double>>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::transform(detail::expr::held_value(matrix), detail::expr::held_value(vector));
+		}
+#endif
+
+		return detail::expr::held_value(matrix) * detail::expr::held_value(vector);
+	}
+
+
+	// Entry point
+
+	template<operand V>
+		requires (!expression<V>)
+	[[nodiscard]] inline constexpr Terminal<V> lazy(const V& value) noexcept
+	{
+		return Terminal<V>{ value };
+	}
+
+
+	// Overloads, at least one side has to be an expression
+
+	template<operand L, operand R>
+		requires (expression<L> || expression<R>) && detail::expr::same_value_v<L, R>
+	[[nodiscard]] inline constexpr auto operator+(const L& lhs, const R& rhs) noexcept
+	{
+		auto lhs_r{ detail::expr::elementwise_operand(lhs) };
+		auto rhs_r{ detail::expr::elementwise_operand(rhs) };
+
+		return Binary<detail::expr::add, decltype(lhs_r), decltype(rhs_r)>{ lhs_r, rhs_r };
+	}
+
+	template<operand L, operand R>
+		requires (expression<L> || expression<R>) && detail::expr::same_value_v<L, R>
+	[[nodiscard]] inline constexpr auto operator-(const L& lhs, const R& rhs) noexcept
+	{
+		auto lhs_r{ detail::expr::elementwise_operand(lhs) };
+		auto rhs_r{ detail::expr::elementwise_operand(rhs) };
+
+		return Binary<detail::expr::sub, decltype(lhs_r), decltype(rhs_r)>{ lhs_r, rhs_r };
+	}
+
+	template<expression E>
+	[[nodiscard]] inline constexpr auto operator-(const E& expr) noexcept
+	{
+		auto expr_r{ detail::expr::elementwise_operand(expr) };
+
+		return Negated<decltype(expr_r)>{ expr_r };
+	}
+
+	template<expression E, detail::expr::scalar_of<E> S>
+	[[nodiscard]] inline constexpr auto operator*(const E& expr, const S& k) noexcept
+	{
+		auto expr_r{ detail::expr::elementwise_operand(expr) };
+
+		return Scaled<detail::expr::mul, decltype(expr_r)>{ expr_r, static_cast<detail::expr::scalar_t<E>>(k) };
+	}
+
+	template<expression E, detail::expr::scalar_of<E> S>
+	[[nodiscard]] inline constexpr auto operator*(const S& k, const E& expr) noexcept
+	{
+		return expr * k;
+	}
+
+	template<expression E, detail::expr::scalar_of<E> S>
+	[[nodiscard]] inline constexpr auto operator/(const E& expr, const S& k) noexcept
+	{
+		auto expr_r{ detail::expr::elementwise_operand(expr) };
+
+		return Scaled<detail::expr::div, decltype(expr_r)>{ expr_r, static_cast<detail::expr::scalar_t<E>>(k) };
+	}
+
+	template<operand L, operand R>
+		requires (expression<L> || expression<R>) && detail::expr::same_value_v<L, R> && detail::expr::is_matrix_v<L>
+	[[nodiscard]] inline constexpr auto operator*(const L& lhs, const R& rhs) noexcept
+	{
+		auto lhs_r{ detail::expr::product_operand(lhs) };
+		auto rhs_r{ detail::expr::product_operand(rhs) };
+
+		return Product<decltype(lhs_r), decltype(rhs_r)>{ lhs_r, rhs_r };
+	}
+
+	template<operand M, operand V>
+		requires (expression<M> || expression<V>) && detail::expr::transformable_v<M, V>
+	[[nodiscard]] inline constexpr auto operator*(const M& matrix, const V& vector) noexcept
+	{
+		auto matrix_r{ detail::expr::product_operand(matrix) };
+		auto vector_r{ detail::expr::product_operand(vector) };
+
+		return Transformed<decltype(matrix_r), decltype(vector_r)>{ matrix_r, vector_r };
+	}
+
+	// (A * B) * v as A * (B * v), two matrix-vector products instead of a matrix product
+	template<typename L, typename R, operand V>
+		requires detail::expr::transformable_v<Product<L, R>, V>
+	[[nodiscard]] inline constexpr auto operator*(const Product<L, R>& product, const V& vector) noexcept
+	{
+		return product.lhs * (product.rhs * vector);
+	}
+
+
+	// Assignments, evaluated in one pass before being stored
+
+	template<operand V, expression E>
+		requires (!expression<V>) && std::is_same_v<V, detail::expr::value_t<E>>
+	inline constexpr V& operator+=(V& target, const E& expr) noexcept
+	{
+		target = lazy(target) + expr;
+		return target;
+	}
+
+	template<operand V, expression E>
+		requires (!expression<V>) && std::is_same_v<V, detail::expr::value_t<E>>
+	inline constexpr V& operator-=(V& target, const E& expr) noexcept
+	{
+		target = lazy(target) - expr;
+		return target;
+	}
+
+}
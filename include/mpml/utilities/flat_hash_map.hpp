@@ -0,0 +1,529 @@
+#pragma once // flat_hash_map.hpp
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines FlatHashMap, an open-addressing hash map meant for integer vector keys such as chunk coordinates
+//
+// Note:
+//	The (key, value) slots sit in one flat array next to an array of 1-byte tags, 0 for an empty slot and 0x80 | 7 bits of the hash otherwise,
+//	so a probe only compares keys on a matching tag. Probing is linear and erase() shifts the following entries back, without tombstones.
+//	The capacity is a power of two, doubled past 3/4 full. The home slot is taken from the high bits of hash * 2^64 / phi,
+//	which keeps weak hashes such as std::hash<int> usable; Vector2/3/4 of integers go through func::hash (utilities/hash.hpp).
+//	Key and Value must be default constructible and movable. Pointers to values stay valid until the next insertion or erase().
+//	The batch find() hashes the keys prefetch_distance ahead and prefetches their tag and slot (SSE2),
+//	so that the cache misses of a table larger than the cache overlap instead of adding up.
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <array>
+#include <bit>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <stdexcept> // for: std::out_of_range()
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/vectors/special_overloads/hash_vectors.hpp"
+
+
+namespace mpml
+{
+
+	template<typename Key, typename Value, typename Hash = std::hash<Key>>
+	class FlatHashMap
+	{
+	public:
+
+		using key_type = Key;
+		using mapped_type = Value;
+
+		static constexpr size_t min_capacity{ 16 };
+
+		// Keys hashed ahead of the one looked up by the batch find(), a power of two
+		static constexpr size_t prefetch_distance{ 8 };
+
+
+		// Initialization
+
+		FlatHashMap() = default;
+
+		// Room for count entries without growing
+		explicit FlatHashMap(size_t count);
+
+		FlatHashMap(const FlatHashMap&) = default;
+		FlatHashMap& operator=(const FlatHashMap&) = default;
+
+		// other is left empty, without capacity
+		FlatHashMap(FlatHashMap&& other) noexcept;
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+
+
+		// Size
+
+		[[nodiscard]] size_t size() const noexcept;
+		[[nodiscard]] bool empty() const noexcept;
+		[[nodiscard]] size_t capacity() const noexcept;
+
+		void reserve(size_t count);
+
+		// Keeps the capacity
+		void clear() noexcept;
+
+
+		// Lookup
+
+		// nullptr when key is absent
+		[[nodiscard]] Value* find(const Key& key) noexcept;
+		[[nodiscard]] const Value* find(const Key& key) const noexcept;
+
+		[[nodiscard]] bool contains(const Key& key) const noexcept;
+
+		// Throws std::out_of_range when key is absent
+		[[nodiscard]] Value& at(const Key& key);
+		[[nodiscard]] const Value& at(const Key& key) const;
+
+		// Inserts a default Value when key is absent
+		Value& operator[](const Key& key);
+
+		// out[i] = find(keys[i]), returns the number of keys found
+		size_t find(std::span<const Key> keys, std::span<Value*> out) noexcept;
+		size_t find(std::span<const Key> keys, std::span<const Value*> out) const noexcept;
+
+
+		// Modifiers
+
+		// False, the map unchanged, when key is already there
+		bool insert(const Key& key, Value value);
+
+		// False when key is absent
+		bool erase(const Key& key);
+
+
+		// Visits every entry as f(key, value), in no particular order
+		template<typename F>
+		void for_each(F&& f);
+
+		template<typename F>
+		void for_each(F&& f) const;
+
+
+	private:
+
+		struct Slot
+		{
+			Key key{};
+			Value value{};
+		};
+
+		static constexpr size_t npos{ static_cast<size_t>(-1) };
+
+		[[nodiscard]] static size_t capacity_for(size_t count) noexcept;
+		[[nodiscard]] static std::uint8_t tag_of(std::uint64_t hash) noexcept;
+
+		[[nodiscard]] std::uint64_t hash_of(const Key& key) const noexcept;
+		[[nodiscard]] size_t home(std::uint64_t hash) const noexcept;
+
+		// Slot holding key, npos when absent
+		[[nodiscard]] size_t locate(const Key& key, std::uint64_t hash) const noexcept;
+
+		// key must be absent, returns its slot
+		size_t place(const Key& key, Value&& value, std::uint64_t hash);
+
+		void prefetch(std::uint64_t hash) const noexcept;
+		void rehash(size_t new_capacity);
+
+		// found(i, slot of keys[i] or npos) for every key, in order
+		template<typename F>
+		size_t find_each(std::span<const Key> keys, F&& found) const noexcept;
+
+		std::vector<std::uint8_t> tags;
+		std::vector<Slot> slots;
+		size_t size_value{};
+		unsigned shift{ 64 };	// 64 - log2(capacity)
+
+		[[no_unique_address]] Hash hasher{};
+	};
+
+
+
+	// Class definition
+
+
+	// Initialization
+	template<typename Key, typename Value, typename Hash>
+	inline FlatHashMap<Key, Value, Hash>::FlatHashMap(size_t count)
+	{
+		reserve(count);
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline FlatHashMap<Key, Value, Hash>::FlatHashMap(FlatHashMap&& other) noexcept
+		: tags{ std::exchange(other.tags, {}) }, slots{ std::exchange(other.slots, {}) },
+		size_value{ std::exchange(other.size_value, size_t{}) }, shift{ std::exchange(other.shift, 64u) }, hasher{ std::move(other.hasher) }
+	{
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline FlatHashMap<Key, Value, Hash>& FlatHashMap<Key, Value, Hash>::operator=(FlatHashMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			tags = std::exchange(other.tags, {});
+			slots = std::exchange(other.slots, {});
+			size_value = std::exchange(other.size_value, size_t{});
+			shift = std::exchange(other.shift, 64u);
+			hasher = std::move(other.hasher);
+		}
+
+		return *this;
+	}
+
+
+	// Size
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::size() const noexcept
+	{
+		return size_value;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline bool FlatHashMap<Key, Value, Hash>::empty() const noexcept
+	{
+		return size_value == 0;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::capacity() const noexcept
+	{
+		return slots.size();
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline void FlatHashMap<Key, Value, Hash>::reserve(size_t count)
+	{
+		const size_t needed{ capacity_for(count) };
+
+		if (needed > slots.size())
+			rehash(needed);
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline void FlatHashMap<Key, Value, Hash>::clear() noexcept
+	{
+		std::fill(tags.begin(), tags.end(), std::uint8_t{});
+
+		for (Slot& slot : slots)
+			slot = Slot{};
+
+		size_value = 0;
+	}
+
+
+	// Lookup
+	template<typename Key, typename Value, typename Hash>
+	inline Value* FlatHashMap<Key, Value, Hash>::find(const Key& key) noexcept
+	{
+		const size_t index{ locate(key, hash_of(key)) };
+		return index == npos ? nullptr : &slots[index].value;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline const Value* FlatHashMap<Key, Value, Hash>::find(const Key& key) const noexcept
+	{
+		const size_t index{ locate(key, hash_of(key)) };
+		return index == npos ? nullptr : &slots[index].value;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline bool FlatHashMap<Key, Value, Hash>::contains(const Key& key) const noexcept
+	{
+		return locate(key, hash_of(key)) != npos;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline Value& FlatHashMap<Key, Value, Hash>::at(const Key& key)
+	{
+		Value* value{ find(key) };
+
+		if (value == nullptr)
+			throw std::out_of_range("Key not found");
+
+		return *value;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline const Value& FlatHashMap<Key, Value, Hash>::at(const Key& key) const
+	{
+		const Value* value{ find(key) };
+
+		if (value == nullptr)
+			throw std::out_of_range("Key not found");
+
+		return *value;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline Value& FlatHashMap<Key, Value, Hash>::operator[](const Key& key)
+	{
+		const std::uint64_t hash{ hash_of(key) };
+		size_t index{ locate(key, hash) };
+
+		if (index == npos)
+			index = place(key, Value{}, hash);
+
+		return slots[index].value;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::find(std::span<const Key> keys, std::span<Value*> out) noexcept
+	{
+		assert(out.size() >= keys.size() && "out is smaller than keys");
+
+		return find_each(keys, [&](size_t i, size_t index) {
+			out[i] = index == npos ? nullptr : &slots[index].value;
+		});
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::find(std::span<const Key> keys, std::span<const Value*> out) const noexcept
+	{
+		assert(out.size() >= keys.size() && "out is smaller than keys");
+
+		return find_each(keys, [&](size_t i, size_t index) {
+			out[i] = index == npos ? nullptr : &slots[index].value;
+		});
+	}
+
+
+	// Modifiers
+	template<typename Key, typename Value, typename Hash>
+	inline bool FlatHashMap<Key, Value, Hash>::insert(const Key& key, Value value)
+	{
+		const std::uint64_t hash{ hash_of(key) };
+
+		if (locate(key, hash) != npos)
+			return false;
+
+		place(key, std::move(value), hash);
+		return true;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline bool FlatHashMap<Key, Value, Hash>::erase(const Key& key)
+	{
+		size_t hole{ locate(key, hash_of(key)) };
+
+		if (hole == npos)
+			return false;
+
+		// Every following entry of the run moves back into the hole, unless its home lies between the hole and itself
+		const size_t mask{ slots.size() - 1 };
+
+		for (size_t next{ (hole + 1) & mask }; tags[next] != 0; next = (next + 1) & mask)
+		{
+			const size_t wanted{ home(hash_of(slots[next].key)) };
+
+			if (((next - wanted) & mask) >= ((next - hole) & mask))
+			{
+				tags[hole] = tags[next];
+				slots[hole] = std::move(slots[next]);
+				hole = next;
+			}
+		}
+
+		tags[hole] = 0;
+		slots[hole] = Slot{};
+		size_value--;
+
+		return true;
+	}
+
+
+	template<typename Key, typename Value, typename Hash>
+	template<typename F>
+	inline void FlatHashMap<Key, Value, Hash>::for_each(F&& f)
+	{
+		for (size_t i{}; i < slots.size(); i++)
+		{
+			if (tags[i] != 0)
+				f(std::as_const(slots[i].key), slots[i].value);
+		}
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	template<typename F>
+	inline void FlatHashMap<Key, Value, Hash>::for_each(F&& f) const
+	{
+		for (size_t i{}; i < slots.size(); i++)
+		{
+			if (tags[i] != 0)
+				f(slots[i].key, slots[i].value);
+		}
+	}
+
+
+	// Internals
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::capacity_for(size_t count) noexcept
+	{
+		size_t capacity_r{ min_capacity };
+
+		while (count > capacity_r - capacity_r / 4)
+			capacity_r *= 2;
+
+		return capacity_r;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline std::uint8_t FlatHashMap<Key, Value, Hash>::tag_of(std::uint64_t hash) noexcept
+	{
+		return static_cast<std::uint8_t>(0x80 | (hash & 0x7F));
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline std::uint64_t FlatHashMap<Key, Value, Hash>::hash_of(const Key& key) const noexcept
+	{
+		return static_cast<std::uint64_t>(hasher(key));
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::home(std::uint64_t hash) const noexcept
+	{
+		return static_cast<size_t>((hash * 0x9E3779B97F4A7C15) >> shift);
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::locate(const Key& key, std::uint64_t hash) const noexcept
+	{
+		if (size_value == 0)
+			return npos;
+
+		// The table is never full, a run always ends on an empty slot
+		const size_t mask{ slots.size() - 1 };
+		const std::uint8_t tag{ tag_of(hash) };
+
+		for (size_t index{ home(hash) };; index = (index + 1) & mask)
+		{
+			const std::uint8_t current{ tags[index] };
+
+			if (current == 0)
+				return npos;
+
+			if (current == tag && slots[index].key == key)
+				return index;
+		}
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline size_t FlatHashMap<Key, Value, Hash>::place(const Key& key, Value&& value, std::uint64_t hash)
+	{
+		reserve(size_value + 1);
+
+		const size_t mask{ slots.size() - 1 };
+		size_t index{ home(hash) };
+
+		while (tags[index] != 0)
+			index = (index + 1) & mask;
+
+		tags[index] = tag_of(hash);
+		slots[index] = Slot{ key, std::move(value) };
+		size_value++;
+
+		return index;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline void FlatHashMap<Key, Value, Hash>::prefetch(std::uint64_t hash) const noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		const size_t index{ home(hash) };
+
+		_mm_prefetch(reinterpret_cast<const char*>(tags.data() + index), _MM_HINT_T0);
+		_mm_prefetch(reinterpret_cast<const char*>(slots.data() + index), _MM_HINT_T0);
+#else
+		(void)hash;
+#endif
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	inline void FlatHashMap<Key, Value, Hash>::rehash(size_t new_capacity)
+	{
+		// Both arrays allocated before the map changes, which stays as it was if either allocation throws
+		std::vector<std::uint8_t> new_tags(new_capacity);
+		std::vector<Slot> new_slots(new_capacity);
+
+		std::vector<std::uint8_t> old_tags{ std::exchange(tags, std::move(new_tags)) };
+		std::vector<Slot> old_slots{ std::exchange(slots, std::move(new_slots)) };
+
+		shift = 64u - static_cast<unsigned>(std::countr_zero(new_capacity));
+
+		// The tags only depend on the hash, only the homes move
+		const size_t mask{ new_capacity - 1 };
+
+		for (size_t i{}; i < old_slots.size(); i++)
+		{
+			if (old_tags[i] == 0)
+				continue;
+
+			size_t index{ home(hash_of(old_slots[i].key)) };
+
+			while (tags[index] != 0)
+				index = (index + 1) & mask;
+
+			tags[index] = old_tags[i];
+			slots[index] = std::move(old_slots[i]);
+		}
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	template<typename F>
+	inline size_t FlatHashMap<Key, Value, Hash>::find_each(std::span<const Key> keys, F&& found) const noexcept
+	{
+		const size_t count{ keys.size() };
+
+		if (size_value == 0)
+		{
+			for (size_t i{}; i < count; i++)
+				found(i, npos);
+
+			return 0;
+		}
+
+		// hashes[i % prefetch_distance] holds the hash of key i, its slot already requested
+		std::array<std::uint64_t, prefetch_distance> hashes{};
+
+		for (size_t i{}; i < std::min(count, prefetch_distance); i++)
+		{
+			hashes[i] = hash_of(keys[i]);
+			prefetch(hashes[i]);
+		}
+
+		size_t count_r{};
+
+		for (size_t i{}; i < count; i++)
+		{
+			std::uint64_t& hash{ hashes[i % prefetch_distance] };
+			const size_t index{ locate(keys[i], hash) };
+
+			if (i + prefetch_distance < count)
+			{
+				hash = hash_of(keys[i + prefetch_distance]);
+				prefetch(hash);
+			}
+
+			count_r += index != npos;
+			found(i, index);
+		}
+
+		return count_r;
+	}
+
+
+
+} // mpml
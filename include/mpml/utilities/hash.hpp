@@ -0,0 +1,69 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Hashes integer vectors: the components are packed into 64 bits, then mixed by a multiply-xorshift finalizer
+//
+// Note:
+//	The finalizer is the one of splitmix64, every input bit reaches every output bit.
+//	Vector2 keeps the low 32 bits of each component, Vector3 the low 21 and Vector4 the low 16, so the packing is exact
+//	for int32 cells in [-2^31, 2^31) (Vector2), [-2^20, 2^20) (Vector3) and [-2^15, 2^15) (Vector4).
+//	Vectors differing only past these bits hash alike, which only costs a longer probe in a hash table, the keys being compared anyway.
+// ===================================================
+
+
+// Dependencies
+#include <cstdint>
+#include <concepts>
+
+#include "mpml/vectors/vector2.hpp"
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/vectors/vector4.hpp"
+
+
+namespace mpml::detail::hash
+{
+
+	// The low bits of value, sign extension included in two's complement then cut by the mask
+	template<unsigned Bits, std::integral T>
+	[[nodiscard]] constexpr std::uint64_t low_bits(T value) noexcept
+	{
+		return static_cast<std::uint64_t>(value) & ((std::uint64_t{ 1 } << Bits) - 1);
+	}
+
+} // mpml::detail::hash
+
+
+namespace mpml::func
+{
+
+	[[nodiscard]] constexpr std::uint64_t mix64(std::uint64_t value) noexcept
+	{
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+		return value ^ (value >> 31);
+	}
+
+
+	template<std::integral T>
+	[[nodiscard]] constexpr std::uint64_t hash(const Vector2<T>& vec) noexcept
+	{
+		using namespace detail::hash;
+		return mix64(low_bits<32>(vec.x) | (low_bits<32>(vec.y) << 32));
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr std::uint64_t hash(const Vector3<T>& vec) noexcept
+	{
+		using namespace detail::hash;
+		return mix64(low_bits<21>(vec.x) | (low_bits<21>(vec.y) << 21) | (low_bits<21>(vec.z) << 42));
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr std::uint64_t hash(const Vector4<T>& vec) noexcept
+	{
+		using namespace detail::hash;
+		return mix64(low_bits<16>(vec.x) | (low_bits<16>(vec.y) << 16) | (low_bits<16>(vec.z) << 32) | (low_bits<16>(vec.w) << 48));
+	}
+
+}
@@ -0,0 +1,812 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines Pack, a fixed number of lanes of an arithmetic type behaving like a single scalar
+//
+// Note:
+//	A Pack can be used as the T of Vector2/3/4, Vector3A, Quaternion and the matrices,
+//	Vector3<float8> then holds eight 3D vectors and every operation runs on the eight of them at once.
+//	Comparisons return a PackMask instead of a bool, conditional code goes through select(), any(), all() and none().
+//	float4 and float8 run on SSE/AVX registers when available, the other packs loop over their lanes.
+//	angle() returns an Angle of the Pack, one angle per lane. Functions returning a std::optional per vector (Matrix inverse of a singular lane...) stay scalar-only.
+// ===================================================
+
+
+// Dependencies
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept> // for: std::out_of_range()
+
+#include "mpml/utilities/simd.hpp"
+
+
+namespace mpml
+{
+
+	template<typename T, size_t N>
+	class Pack;
+
+	template<typename T, size_t N>
+	class PackMask;
+
+
+	// Type traits
+
+	template<typename T>
+	struct is_pack : std::false_type {};
+
+	template<typename T, size_t N>
+	struct is_pack<Pack<T, N>> : std::true_type {};
+
+	template<typename T>
+	inline constexpr bool is_pack_v{ is_pack<T>::value };
+
+
+	namespace detail::pack
+	{
+
+		// Unsigned integer as wide as T, masks hold all ones or all zeros lanes of it
+		template<typename T>
+		using mask_lane_t = std::conditional_t<sizeof(T) == 8, std::uint64_t,
+			std::conditional_t<sizeof(T) == 4, std::uint32_t,
+			std::conditional_t<sizeof(T) == 2, std::uint16_t, std::uint8_t>>>;
+
+		template<typename T, size_t N>
+		inline constexpr bool is_sse{
+#if defined(MPML_SIMD_SSE2)
+			std::is_same_v<T, float> && N == 4
+#else
+			false
+#endif
+		};
+
+		template<typename T, size_t N>
+		inline constexpr bool is_avx{
+#if defined(MPML_SIMD_AVX)
+			std::is_same_v<T, float> && N == 8
+#else
+			false
+#endif
+		};
+
+
+		// Lane operations, sse() and avx() only exist when the matching instruction set does
+
+		struct add
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_add_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_add_ps(a, b); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr T scalar(const T& a, const T& b) noexcept { return static_cast<T>(a + b); }
+		};
+
+		struct sub
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_sub_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_sub_ps(a, b); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr T scalar(const T& a, const T& b) noexcept { return static_cast<T>(a - b); }
+		};
+
+		struct mul
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_mul_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_mul_ps(a, b); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr T scalar(const T& a, const T& b) noexcept { return static_cast<T>(a * b); }
+		};
+
+		struct div
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_div_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_div_ps(a, b); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr T scalar(const T& a, const T& b) noexcept { return static_cast<T>(a / b); }
+		};
+
+		struct minimum
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_min_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_min_ps(a, b); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr auto scalar(const T& a, const T& b) noexcept { return a < b ? a : b; }
+		};
+
+		struct maximum
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_max_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_max_ps(a, b); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr auto scalar(const T& a, const T& b) noexcept { return a > b ? a : b; }
+		};
+
+		struct equal
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_cmpeq_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr auto scalar(const T& a, const T& b) noexcept { return a == b; }
+		};
+
+		struct not_equal
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_cmpneq_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr auto scalar(const T& a, const T& b) noexcept { return a != b; }
+		};
+
+		struct less
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_cmplt_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr auto scalar(const T& a, const T& b) noexcept { return a < b; }
+		};
+
+		struct less_equal
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a, __m128 b) noexcept { return _mm_cmple_ps(a, b); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a, __m256 b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr auto scalar(const T& a, const T& b) noexcept { return a <= b; }
+		};
+
+		struct negate
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a) noexcept { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr T scalar(const T& a) noexcept { return static_cast<T>(-a); }
+		};
+
+		struct absolute
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr T scalar(const T& a) noexcept { return static_cast<T>(std::abs(a)); }
+		};
+
+		struct square_root
+		{
+#if defined(MPML_SIMD_SSE2)
+			[[nodiscard]] static __m128 sse(__m128 a) noexcept { return _mm_sqrt_ps(a); }
+#endif
+#if defined(MPML_SIMD_AVX)
+			[[nodiscard]] static __m256 avx(__m256 a) noexcept { return _mm256_sqrt_ps(a); }
+#endif
+			template<typename T>
+			[[nodiscard]] static constexpr T scalar(const T& a) noexcept { return static_cast<T>(std::sqrt(a)); }
+		};
+
+
+		template<typename Op, typename T, size_t N>
+		[[nodiscard]] constexpr Pack<T, N> lanewise(const Pack<T, N>& a, const Pack<T, N>& b) noexcept;
+
+		template<typename Op, typename T, size_t N>
+		[[nodiscard]] constexpr Pack<T, N> lanewise(const Pack<T, N>& a) noexcept;
+
+		template<typename Op, typename T, size_t N>
+		[[nodiscard]] constexpr PackMask<T, N> compare(const Pack<T, N>& a, const Pack<T, N>& b) noexcept;
+
+	} // detail::pack
+
+
+
+	template<typename T, size_t N>
+	class alignas(sizeof(T) * N) Pack
+	{
+	public:
+
+		static_assert(std::is_arithmetic_v<T>, "Pack lanes must be arithmetic");
+		static_assert(N > 0 && (N & (N - 1)) == 0, "Pack holds a power of two number of lanes");
+
+		using value_type = T;
+		using mask_type = PackMask<T, N>;
+
+
+		// Initialization
+
+		constexpr Pack() noexcept = default;
+
+		// Broadcast to every lane
+		constexpr Pack(const T& value) noexcept;
+
+		// One value per lane
+		template<typename... U>
+			requires (sizeof...(U) == N && N > 1)
+		constexpr Pack(const U&... values) noexcept;
+
+
+		// Data related
+
+		[[nodiscard]] static constexpr Pack<T, N> load(const T* src) noexcept;
+		constexpr void store(T* dst) const noexcept;
+
+		[[nodiscard]] constexpr T* data_ptr() noexcept;
+		[[nodiscard]] constexpr const T* data_ptr() const noexcept;
+
+		[[nodiscard]] constexpr T& operator[](size_t lane);
+		[[nodiscard]] constexpr const T& operator[](size_t lane) const;
+
+
+		// Member Overloads
+
+		constexpr Pack<T, N>& operator+=(const Pack<T, N>& pack) noexcept;
+		constexpr Pack<T, N>& operator-=(const Pack<T, N>& pack) noexcept;
+		constexpr Pack<T, N>& operator*=(const Pack<T, N>& pack) noexcept;
+		constexpr Pack<T, N>& operator/=(const Pack<T, N>& pack) noexcept;
+
+		[[nodiscard]] constexpr Pack<T, N> operator-() const noexcept;
+
+
+		// Overloads, as hidden friends so that scalars convert on either side (2 * pack)
+
+		[[nodiscard]] friend constexpr Pack<T, N> operator+(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::lanewise<detail::pack::add>(a, b);
+		}
+
+		[[nodiscard]] friend constexpr Pack<T, N> operator-(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::lanewise<detail::pack::sub>(a, b);
+		}
+
+		[[nodiscard]] friend constexpr Pack<T, N> operator*(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::lanewise<detail::pack::mul>(a, b);
+		}
+
+		[[nodiscard]] friend constexpr Pack<T, N> operator/(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::lanewise<detail::pack::div>(a, b);
+		}
+
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator==(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::compare<detail::pack::equal>(a, b);
+		}
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator!=(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::compare<detail::pack::not_equal>(a, b);
+		}
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator<(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::compare<detail::pack::less>(a, b);
+		}
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator<=(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return detail::pack::compare<detail::pack::less_equal>(a, b);
+		}
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator>(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return b < a;
+		}
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator>=(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+		{
+			return b <= a;
+		}
+
+
+		// Class Members
+
+		std::array<T, N> lanes{};
+
+		static constexpr size_t size{ N };
+	};
+
+
+	template<typename T, size_t N>
+	class PackMask
+	{
+	public:
+
+		using lane_type = detail::pack::mask_lane_t<T>;
+
+
+		// Initialization
+
+		constexpr PackMask() noexcept = default;
+
+		// Same value in every lane
+		constexpr PackMask(bool value) noexcept;
+
+
+		// Data related
+
+		[[nodiscard]] constexpr bool operator[](size_t lane) const;
+		constexpr void set(size_t lane, bool value);
+
+
+		// Overloads
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator&&(const PackMask<T, N>& a, const PackMask<T, N>& b) noexcept
+		{
+			PackMask<T, N> mask_r;
+
+			for (size_t i{}; i < N; i++)
+				mask_r.lanes[i] = a.lanes[i] & b.lanes[i];
+
+			return mask_r;
+		}
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator||(const PackMask<T, N>& a, const PackMask<T, N>& b) noexcept
+		{
+			PackMask<T, N> mask_r;
+
+			for (size_t i{}; i < N; i++)
+				mask_r.lanes[i] = a.lanes[i] | b.lanes[i];
+
+			return mask_r;
+		}
+
+		[[nodiscard]] friend constexpr PackMask<T, N> operator!(const PackMask<T, N>& a) noexcept
+		{
+			PackMask<T, N> mask_r;
+
+			for (size_t i{}; i < N; i++)
+				mask_r.lanes[i] = static_cast<lane_type>(~a.lanes[i]);
+
+			return mask_r;
+		}
+
+
+		// Class Members
+
+		alignas(sizeof(T) * N) std::array<lane_type, N> lanes{};
+
+		static constexpr size_t size{ N };
+	};
+
+
+	using float4 = Pack<float, 4>;
+	using float8 = Pack<float, 8>;
+	using double2 = Pack<double, 2>;
+	using double4 = Pack<double, 4>;
+	using int4 = Pack<std::int32_t, 4>;
+	using int8 = Pack<std::int32_t, 8>;
+
+
+
+	// Class Definition
+
+
+
+	// Initialization
+
+	template<typename T, size_t N>
+	inline constexpr Pack<T, N>::Pack(const T& value) noexcept
+	{
+		lanes.fill(value);
+	}
+
+	template<typename T, size_t N>
+	template<typename... U>
+		requires (sizeof...(U) == N && N > 1)
+	inline constexpr Pack<T, N>::Pack(const U&... values) noexcept
+		: lanes{ static_cast<T>(values)... }
+	{
+	}
+
+
+	// Data related
+
+	template<typename T, size_t N>
+	inline constexpr Pack<T, N> Pack<T, N>::load(const T* src) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = src[i];
+
+		return pack_r;
+	}
+
+	template<typename T, size_t N>
+	inline constexpr void Pack<T, N>::store(T* dst) const noexcept
+	{
+		for (size_t i{}; i < N; i++)
+			dst[i] = lanes[i];
+	}
+
+	template<typename T, size_t N>
+	inline constexpr T* Pack<T, N>::data_ptr() noexcept
+	{
+		return lanes.data();
+	}
+
+	template<typename T, size_t N>
+	inline constexpr const T* Pack<T, N>::data_ptr() const noexcept
+	{
+		return lanes.data();
+	}
+
+	template<typename T, size_t N>
+	inline constexpr T& Pack<T, N>::operator[](size_t lane)
+	{
+		if (lane >= N)
+			throw std::out_of_range("lane is out of range in Pack");
+		return lanes[lane];
+	}
+
+	template<typename T, size_t N>
+	inline constexpr const T& Pack<T, N>::operator[](size_t lane) const
+	{
+		if (lane >= N)
+			throw std::out_of_range("lane is out of range in Pack");
+		return lanes[lane];
+	}
+
+
+	// Member Overloads
+
+	template<typename T, size_t N>
+	inline constexpr Pack<T, N>& Pack<T, N>::operator+=(const Pack<T, N>& pack) noexcept
+	{
+		*this = *this + pack;
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline constexpr Pack<T, N>& Pack<T, N>::operator-=(const Pack<T, N>& pack) noexcept
+	{
+		*this = *this - pack;
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline constexpr Pack<T, N>& Pack<T, N>::operator*=(const Pack<T, N>& pack) noexcept
+	{
+		*this = *this * pack;
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline constexpr Pack<T, N>& Pack<T, N>::operator/=(const Pack<T, N>& pack) noexcept
+	{
+		*this = *this / pack;
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline constexpr Pack<T, N> Pack<T, N>::operator-() const noexcept
+	{
+		return detail::pack::lanewise<detail::pack::negate>(*this);
+	}
+
+	// Lane operations
+
+	template<typename Op, typename T, size_t N>
+	inline constexpr Pack<T, N> detail::pack::lanewise(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		if (!std::is_constant_evaluated())
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (is_sse<T, N>)
+			{
+				_mm_store_ps(pack_r.lanes.data(), Op::sse(_mm_load_ps(a.lanes.data()), _mm_load_ps(b.lanes.data())));
+				return pack_r;
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (is_avx<T, N>)
+			{
+				_mm256_store_ps(pack_r.lanes.data(), Op::avx(_mm256_load_ps(a.lanes.data()), _mm256_load_ps(b.lanes.data())));
+				return pack_r;
+			}
+#endif
+		}
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = Op::scalar(a.lanes[i], b.lanes[i]);
+
+		return pack_r;
+	}
+
+	template<typename Op, typename T, size_t N>
+	inline constexpr Pack<T, N> detail::pack::lanewise(const Pack<T, N>& a) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		if (!std::is_constant_evaluated())
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (is_sse<T, N>)
+			{
+				_mm_store_ps(pack_r.lanes.data(), Op::sse(_mm_load_ps(a.lanes.data())));
+				return pack_r;
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (is_avx<T, N>)
+			{
+				_mm256_store_ps(pack_r.lanes.data(), Op::avx(_mm256_load_ps(a.lanes.data())));
+				return pack_r;
+			}
+#endif
+		}
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = Op::scalar(a.lanes[i]);
+
+		return pack_r;
+	}
+
+	template<typename Op, typename T, size_t N>
+	inline constexpr PackMask<T, N> detail::pack::compare(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+	{
+		PackMask<T, N> mask_r;
+
+		if (!std::is_constant_evaluated())
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (is_sse<T, N>)
+			{
+				_mm_store_si128(reinterpret_cast<__m128i*>(mask_r.lanes.data()), _mm_castps_si128(Op::sse(_mm_load_ps(a.lanes.data()), _mm_load_ps(b.lanes.data()))));
+				return mask_r;
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (is_avx<T, N>)
+			{
+				_mm256_store_si256(reinterpret_cast<__m256i*>(mask_r.lanes.data()), _mm256_castps_si256(Op::avx(_mm256_load_ps(a.lanes.data()), _mm256_load_ps(b.lanes.data()))));
+				return mask_r;
+			}
+#endif
+		}
+
+		for (size_t i{}; i < N; i++)
+			mask_r.set(i, Op::scalar(a.lanes[i], b.lanes[i]));
+
+		return mask_r;
+	}
+
+
+	// PackMask
+
+	template<typename T, size_t N>
+	inline constexpr PackMask<T, N>::PackMask(bool value) noexcept
+	{
+		lanes.fill(value ? static_cast<lane_type>(~lane_type{}) : lane_type{});
+	}
+
+	template<typename T, size_t N>
+	inline constexpr bool PackMask<T, N>::operator[](size_t lane) const
+	{
+		if (lane >= N)
+			throw std::out_of_range("lane is out of range in PackMask");
+		return lanes[lane] != lane_type{};
+	}
+
+	template<typename T, size_t N>
+	inline constexpr void PackMask<T, N>::set(size_t lane, bool value)
+	{
+		if (lane >= N)
+			throw std::out_of_range("lane is out of range in PackMask");
+		lanes[lane] = value ? static_cast<lane_type>(~lane_type{}) : lane_type{};
+	}
+
+
+
+	// Functions
+
+	// Lane-wise mask ? a : b
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> select(const PackMask<T, N>& mask, const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		if (!std::is_constant_evaluated())
+		{
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (detail::pack::is_sse<T, N>)
+			{
+				const __m128 m{ _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(mask.lanes.data()))) };
+				_mm_store_ps(pack_r.lanes.data(), _mm_or_ps(_mm_and_ps(m, _mm_load_ps(a.lanes.data())), _mm_andnot_ps(m, _mm_load_ps(b.lanes.data()))));
+				return pack_r;
+			}
+#endif
+#if defined(MPML_SIMD_AVX)
+			if constexpr (detail::pack::is_avx<T, N>)
+			{
+				const __m256 m{ _mm256_castsi256_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(mask.lanes.data()))) };
+				_mm256_store_ps(pack_r.lanes.data(), _mm256_blendv_ps(_mm256_load_ps(b.lanes.data()), _mm256_load_ps(a.lanes.data()), m));
+				return pack_r;
+			}
+#endif
+		}
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = mask.lanes[i] ? a.lanes[i] : b.lanes[i];
+
+		return pack_r;
+	}
+
+	namespace detail::pack
+	{
+
+		// 1 / value, with zero in the lanes where value is zero
+		template<typename T, size_t N>
+		[[nodiscard]] inline constexpr Pack<T, N> reciprocal_or_zero(const Pack<T, N>& value) noexcept
+		{
+			return select(value == Pack<T, N>{}, Pack<T, N>{}, Pack<T, N>{ T{ 1 } } / value);
+		}
+
+	} // detail::pack
+
+	// Plain condition ? a : b, lets generic code select on scalars and packs alike
+	template<typename T>
+	[[nodiscard]] inline constexpr T select(bool condition, const T& a, const T& b) noexcept
+	{
+		return condition ? a : b;
+	}
+
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr bool any(const PackMask<T, N>& mask) noexcept
+	{
+		for (const auto& lane : mask.lanes)
+			if (lane)
+				return true;
+		return false;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr bool all(const PackMask<T, N>& mask) noexcept
+	{
+		for (const auto& lane : mask.lanes)
+			if (!lane)
+				return false;
+		return true;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr bool none(const PackMask<T, N>& mask) noexcept
+	{
+		return !any(mask);
+	}
+
+
+	// Math, found through ADL so that generic code can call sqrt(x) after using std::sqrt
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> sqrt(const Pack<T, N>& pack) noexcept
+	{
+		return detail::pack::lanewise<detail::pack::square_root>(pack);
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> abs(const Pack<T, N>& pack) noexcept
+	{
+		return detail::pack::lanewise<detail::pack::absolute>(pack);
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> min(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+	{
+		return detail::pack::lanewise<detail::pack::minimum>(a, b);
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> max(const Pack<T, N>& a, const Pack<T, N>& b) noexcept
+	{
+		return detail::pack::lanewise<detail::pack::maximum>(a, b);
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> floor(const Pack<T, N>& pack) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = static_cast<T>(std::floor(pack.lanes[i]));
+
+		return pack_r;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> ceil(const Pack<T, N>& pack) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = static_cast<T>(std::ceil(pack.lanes[i]));
+
+		return pack_r;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> sin(const Pack<T, N>& pack) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = static_cast<T>(std::sin(pack.lanes[i]));
+
+		return pack_r;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> cos(const Pack<T, N>& pack) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = static_cast<T>(std::cos(pack.lanes[i]));
+
+		return pack_r;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline constexpr Pack<T, N> acos(const Pack<T, N>& pack) noexcept
+	{
+		Pack<T, N> pack_r;
+
+		for (size_t i{}; i < N; i++)
+			pack_r.lanes[i] = static_cast<T>(std::acos(pack.lanes[i]));
+
+		return pack_r;
+	}
+
+} // mpml
@@ -0,0 +1,226 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Detects the SIMD instruction sets available at compile time and pulls in the matching intrinsics.
+//
+// Note:
+//	Every SIMD path in MPML is guarded by one of the macros below and always keeps a scalar fallback,
+//	which is also the one taken during constant evaluation.
+//	Define MPML_NO_SIMD before including MPML to force the scalar code everywhere.
+// ===================================================
+
+
+#if !defined(MPML_NO_SIMD)
+
+#	if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define MPML_SIMD_SSE2 1
+#	endif
+
+#	if defined(__SSE4_1__) || (defined(_MSC_VER) && defined(__AVX__))
+#		define MPML_SIMD_SSE41 1
+#	endif
+
+#	if defined(__AVX__)
+#		define MPML_SIMD_AVX 1
+#	endif
+
+#	if defined(__AVX2__)
+#		define MPML_SIMD_AVX2 1
+#	endif
+
+#	if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#		define MPML_SIMD_FMA 1
+#	endif
+
+#	if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#		define MPML_SIMD_BMI2 1
+#	endif
+
+#endif
+
+
+#if defined(MPML_SIMD_SSE2)
+#	include <immintrin.h>
+#endif
+
+
+namespace mpml::detail::simd
+{
+
+#if defined(MPML_SIMD_SSE2)
+
+	// Lane X, Y, Z, W of vec, in that order
+	template<int X, int Y, int Z, int W>
+	[[nodiscard]] inline __m128 swizzle(__m128 vec) noexcept
+	{
+		return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(vec), _MM_SHUFFLE(W, Z, Y, X)));
+	}
+
+	// Lanes X, Y of vec1 followed by lanes Z, W of vec2
+	template<int X, int Y, int Z, int W>
+	[[nodiscard]] inline __m128 shuffle(__m128 vec1, __m128 vec2) noexcept
+	{
+		return _mm_shuffle_ps(vec1, vec2, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	// Keeps x, y, z and clears w
+	[[nodiscard]] inline __m128 xyz(__m128 vec) noexcept
+	{
+		return _mm_and_ps(vec, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+	}
+
+	// Keeps x, y, z and replaces w
+	[[nodiscard]] inline __m128 with_w(__m128 vec, float w) noexcept
+	{
+		return _mm_or_ps(xyz(vec), _mm_setr_ps(0.f, 0.f, 0.f, w));
+	}
+
+	// x + y + z + w broadcast to every lane
+	[[nodiscard]] inline __m128 sum(__m128 vec) noexcept
+	{
+		vec = _mm_add_ps(vec, shuffle<1, 0, 3, 2>(vec, vec));
+		return _mm_add_ps(vec, shuffle<2, 3, 0, 1>(vec, vec));
+	}
+
+	// Dot product of the x, y, z lanes, broadcast to every lane
+	[[nodiscard]] inline __m128 dot3(__m128 a, __m128 b) noexcept
+	{
+		return sum(xyz(_mm_mul_ps(a, b)));
+	}
+
+	// Cross product of the x, y, z lanes, w ends up as 0 for finite inputs
+	[[nodiscard]] inline __m128 cross3(__m128 a, __m128 b) noexcept
+	{
+		const __m128 temp{ _mm_sub_ps(_mm_mul_ps(a, shuffle<1, 2, 0, 3>(b, b)), _mm_mul_ps(shuffle<1, 2, 0, 3>(a, a), b)) };
+		return shuffle<1, 2, 0, 3>(temp, temp);
+	}
+
+	// 4 packed 3D vectors (12 floats) to one register per component
+	inline void deinterleave3(const float* src, __m128& x, __m128& y, __m128& z) noexcept
+	{
+		const __m128 a{ _mm_loadu_ps(src) };		// x0 y0 z0 x1
+		const __m128 b{ _mm_loadu_ps(src + 4) };	// y1 z1 x2 y2
+		const __m128 c{ _mm_loadu_ps(src + 8) };	// z2 x3 y3 z3
+
+		x = shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c));
+		y = shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c));
+		z = shuffle<0, 2, 0, 3>(shuffle<2, 2, 1, 1>(a, b), c);
+	}
+
+	// Inverse of deinterleave3
+	inline void interleave3(float* dst, __m128 x, __m128 y, __m128 z) noexcept
+	{
+		_mm_storeu_ps(dst, shuffle<0, 2, 0, 2>(shuffle<0, 0, 0, 0>(x, y), shuffle<0, 0, 1, 1>(z, x)));
+		_mm_storeu_ps(dst + 4, shuffle<0, 2, 0, 2>(shuffle<1, 1, 1, 1>(y, z), shuffle<2, 2, 2, 2>(x, y)));
+		_mm_storeu_ps(dst + 8, shuffle<0, 2, 0, 2>(shuffle<2, 2, 3, 3>(z, x), shuffle<3, 3, 3, 3>(y, z)));
+	}
+
+	// a * b + c, fused when the target allows it
+	[[nodiscard]] inline __m128 madd(__m128 a, __m128 b, __m128 c) noexcept
+	{
+#	if defined(MPML_SIMD_FMA)
+		return _mm_fmadd_ps(a, b, c);
+#	else
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+#	endif
+	}
+
+	[[nodiscard]] inline __m128d madd(__m128d a, __m128d b, __m128d c) noexcept
+	{
+#	if defined(MPML_SIMD_FMA)
+		return _mm_fmadd_pd(a, b, c);
+#	else
+		return _mm_add_pd(_mm_mul_pd(a, b), c);
+#	endif
+	}
+
+#endif
+
+#if defined(MPML_SIMD_AVX)
+
+	// Same as shuffle, within each 128-bit half
+	template<int X, int Y, int Z, int W>
+	[[nodiscard]] inline __m256 shuffle(__m256 vec1, __m256 vec2) noexcept
+	{
+		return _mm256_shuffle_ps(vec1, vec2, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	// 8 packed 3D vectors (24 floats) to one register per component
+	// Vectors 0 to 3 land in the low halves and 4 to 7 in the high halves, each half then goes through the SSE transpose
+	inline void deinterleave3(const float* src, __m256& x, __m256& y, __m256& z) noexcept
+	{
+		const __m256 a{ _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)), _mm_loadu_ps(src + 12), 1) };
+		const __m256 b{ _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 16), 1) };
+		const __m256 c{ _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 20), 1) };
+
+		x = shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c));
+		y = shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c));
+		z = shuffle<0, 2, 0, 3>(shuffle<2, 2, 1, 1>(a, b), c);
+	}
+
+	// Inverse of deinterleave3
+	inline void interleave3(float* dst, __m256 x, __m256 y, __m256 z) noexcept
+	{
+		const __m256 a{ shuffle<0, 2, 0, 2>(shuffle<0, 0, 0, 0>(x, y), shuffle<0, 0, 1, 1>(z, x)) };
+		const __m256 b{ shuffle<0, 2, 0, 2>(shuffle<1, 1, 1, 1>(y, z), shuffle<2, 2, 2, 2>(x, y)) };
+		const __m256 c{ shuffle<0, 2, 0, 2>(shuffle<2, 2, 3, 3>(z, x), shuffle<3, 3, 3, 3>(y, z)) };
+
+		_mm_storeu_ps(dst, _mm256_castps256_ps128(a));
+		_mm_storeu_ps(dst + 4, _mm256_castps256_ps128(b));
+		_mm_storeu_ps(dst + 8, _mm256_castps256_ps128(c));
+		_mm_storeu_ps(dst + 12, _mm256_extractf128_ps(a, 1));
+		_mm_storeu_ps(dst + 16, _mm256_extractf128_ps(b, 1));
+		_mm_storeu_ps(dst + 20, _mm256_extractf128_ps(c, 1));
+	}
+
+	// 4 packed 3D vectors (12 doubles) to one register per component
+	// After the first blend / permute both 128-bit halves hold the same layout: (x, y), (z, x'), (y', z')
+	inline void deinterleave3(const double* src, __m256d& x, __m256d& y, __m256d& z) noexcept
+	{
+		const __m256d a{ _mm256_loadu_pd(src) };		// x0 y0 | z0 x1
+		const __m256d b{ _mm256_loadu_pd(src + 4) };	// y1 z1 | x2 y2
+		const __m256d c{ _mm256_loadu_pd(src + 8) };	// z2 x3 | y3 z3
+
+		const __m256d xy{ _mm256_blend_pd(a, b, 0b1100) };			// x0 y0 | x2 y2
+		const __m256d zx{ _mm256_permute2f128_pd(a, c, 0x21) };	// z0 x1 | z2 x3
+		const __m256d yz{ _mm256_blend_pd(b, c, 0b1100) };			// y1 z1 | y3 z3
+
+		x = _mm256_blend_pd(xy, zx, 0b1010);
+		y = _mm256_shuffle_pd(xy, yz, 0b0101);
+		z = _mm256_blend_pd(zx, yz, 0b1010);
+	}
+
+	// Inverse of deinterleave3
+	inline void interleave3(double* dst, __m256d x, __m256d y, __m256d z) noexcept
+	{
+		const __m256d xy{ _mm256_shuffle_pd(x, y, 0b0000) };
+		const __m256d zx{ _mm256_blend_pd(z, x, 0b1010) };
+		const __m256d yz{ _mm256_shuffle_pd(y, z, 0b1111) };
+
+		_mm256_storeu_pd(dst, _mm256_permute2f128_pd(xy, zx, 0x20));
+		_mm256_storeu_pd(dst + 4, _mm256_permute2f128_pd(yz, xy, 0x30));
+		_mm256_storeu_pd(dst + 8, _mm256_permute2f128_pd(zx, yz, 0x31));
+	}
+
+	[[nodiscard]] inline __m256 madd(__m256 a, __m256 b, __m256 c) noexcept
+	{
+#	if defined(MPML_SIMD_FMA)
+		return _mm256_fmadd_ps(a, b, c);
+#	else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#	endif
+	}
+
+	[[nodiscard]] inline __m256d madd(__m256d a, __m256d b, __m256d c) noexcept
+	{
+#	if defined(MPML_SIMD_FMA)
+		return _mm256_fmadd_pd(a, b, c);
+#	else
+		return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#	endif
+	}
+
+#endif
+
+} // mpml::detail::simd
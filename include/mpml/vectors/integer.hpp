@@ -0,0 +1,349 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Integer vector operations for chunk / local coordinate math:
+// bitwise operators, floor division and Euclidean modulo (general and by powers of two), floor conversion from floating point vectors
+//
+// Note:
+//	Everything is branchless and follows func::floor_div / func::euclid_mod / func::floor_to_int of basic.hpp, component by component.
+//	Divisors must be positive; with a power of two chunk size 2^shift, a cell splits into chunk = cell >> shift and local = cell & (2^shift - 1),
+//	which stays right for negative cells (-1 is in chunk -1 at local 2^shift - 1), unlike / and %.
+//	The floating point values converted must fit in the integer type, as for static_cast.
+//
+//	The batch functions convert whole arrays of float positions or int32 cells, out may not overlap in, except cells with chunks or locals.
+//	They run 8 (AVX2) or 4 (SSE2) elements at a time on the flattened components, a Vector3 span being read as 3 * size() values.
+//	Out of range values give INT32_MIN with SIMD, where the scalar conversion is undefined.
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <concepts>
+#include <type_traits>
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/functions/basic.hpp"
+#include "mpml/vectors/vector2.hpp"
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/vectors/vector4.hpp"
+
+
+namespace mpml
+{
+
+	// Vector2
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator&(const Vector2<T>& a, const Vector2<T>& b) noexcept { return { static_cast<T>(a.x & b.x), static_cast<T>(a.y & b.y) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator|(const Vector2<T>& a, const Vector2<T>& b) noexcept { return { static_cast<T>(a.x | b.x), static_cast<T>(a.y | b.y) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator^(const Vector2<T>& a, const Vector2<T>& b) noexcept { return { static_cast<T>(a.x ^ b.x), static_cast<T>(a.y ^ b.y) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator&(const Vector2<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x & mask), static_cast<T>(vec.y & mask) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator|(const Vector2<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x | mask), static_cast<T>(vec.y | mask) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator^(const Vector2<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x ^ mask), static_cast<T>(vec.y ^ mask) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator~(const Vector2<T>& vec) noexcept { return { static_cast<T>(~vec.x), static_cast<T>(~vec.y) }; }
+
+	// Arithmetic shift for signed T
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator<<(const Vector2<T>& vec, unsigned shift) noexcept { return { static_cast<T>(vec.x << shift), static_cast<T>(vec.y << shift) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> operator>>(const Vector2<T>& vec, unsigned shift) noexcept { return { static_cast<T>(vec.x >> shift), static_cast<T>(vec.y >> shift) }; }
+
+
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr Vector2<T> floor_div(const Vector2<T>& vec, std::type_identity_t<T> divisor) noexcept
+	{
+		return { func::floor_div(vec.x, divisor), func::floor_div(vec.y, divisor) };
+	}
+
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr Vector2<T> euclid_mod(const Vector2<T>& vec, std::type_identity_t<T> divisor) noexcept
+	{
+		return { func::euclid_mod(vec.x, divisor), func::euclid_mod(vec.y, divisor) };
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> floor_div_pow2(const Vector2<T>& vec, unsigned shift) noexcept
+	{
+		return vec >> shift;
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector2<T> mod_pow2(const Vector2<T>& vec, unsigned shift) noexcept
+	{
+		return { func::mod_pow2(vec.x, shift), func::mod_pow2(vec.y, shift) };
+	}
+
+	template<std::integral I = std::int32_t, std::floating_point T>
+	[[nodiscard]] constexpr Vector2<I> floor_to_int(const Vector2<T>& vec) noexcept
+	{
+		return { func::floor_to_int<I>(vec.x), func::floor_to_int<I>(vec.y) };
+	}
+
+
+	// Vector3
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator&(const Vector3<T>& a, const Vector3<T>& b) noexcept { return { static_cast<T>(a.x & b.x), static_cast<T>(a.y & b.y), static_cast<T>(a.z & b.z) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator|(const Vector3<T>& a, const Vector3<T>& b) noexcept { return { static_cast<T>(a.x | b.x), static_cast<T>(a.y | b.y), static_cast<T>(a.z | b.z) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator^(const Vector3<T>& a, const Vector3<T>& b) noexcept { return { static_cast<T>(a.x ^ b.x), static_cast<T>(a.y ^ b.y), static_cast<T>(a.z ^ b.z) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator&(const Vector3<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x & mask), static_cast<T>(vec.y & mask), static_cast<T>(vec.z & mask) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator|(const Vector3<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x | mask), static_cast<T>(vec.y | mask), static_cast<T>(vec.z | mask) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator^(const Vector3<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x ^ mask), static_cast<T>(vec.y ^ mask), static_cast<T>(vec.z ^ mask) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator~(const Vector3<T>& vec) noexcept { return { static_cast<T>(~vec.x), static_cast<T>(~vec.y), static_cast<T>(~vec.z) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator<<(const Vector3<T>& vec, unsigned shift) noexcept { return { static_cast<T>(vec.x << shift), static_cast<T>(vec.y << shift), static_cast<T>(vec.z << shift) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> operator>>(const Vector3<T>& vec, unsigned shift) noexcept { return { static_cast<T>(vec.x >> shift), static_cast<T>(vec.y >> shift), static_cast<T>(vec.z >> shift) }; }
+
+
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr Vector3<T> floor_div(const Vector3<T>& vec, std::type_identity_t<T> divisor) noexcept
+	{
+		return { func::floor_div(vec.x, divisor), func::floor_div(vec.y, divisor), func::floor_div(vec.z, divisor) };
+	}
+
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr Vector3<T> euclid_mod(const Vector3<T>& vec, std::type_identity_t<T> divisor) noexcept
+	{
+		return { func::euclid_mod(vec.x, divisor), func::euclid_mod(vec.y, divisor), func::euclid_mod(vec.z, divisor) };
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> floor_div_pow2(const Vector3<T>& vec, unsigned shift) noexcept
+	{
+		return vec >> shift;
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector3<T> mod_pow2(const Vector3<T>& vec, unsigned shift) noexcept
+	{
+		return { func::mod_pow2(vec.x, shift), func::mod_pow2(vec.y, shift), func::mod_pow2(vec.z, shift) };
+	}
+
+	template<std::integral I = std::int32_t, std::floating_point T>
+	[[nodiscard]] constexpr Vector3<I> floor_to_int(const Vector3<T>& vec) noexcept
+	{
+		return { func::floor_to_int<I>(vec.x), func::floor_to_int<I>(vec.y), func::floor_to_int<I>(vec.z) };
+	}
+
+
+	// Vector4, w included
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator&(const Vector4<T>& a, const Vector4<T>& b) noexcept { return { static_cast<T>(a.x & b.x), static_cast<T>(a.y & b.y), static_cast<T>(a.z & b.z), static_cast<T>(a.w & b.w) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator|(const Vector4<T>& a, const Vector4<T>& b) noexcept { return { static_cast<T>(a.x | b.x), static_cast<T>(a.y | b.y), static_cast<T>(a.z | b.z), static_cast<T>(a.w | b.w) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator^(const Vector4<T>& a, const Vector4<T>& b) noexcept { return { static_cast<T>(a.x ^ b.x), static_cast<T>(a.y ^ b.y), static_cast<T>(a.z ^ b.z), static_cast<T>(a.w ^ b.w) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator&(const Vector4<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x & mask), static_cast<T>(vec.y & mask), static_cast<T>(vec.z & mask), static_cast<T>(vec.w & mask) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator|(const Vector4<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x | mask), static_cast<T>(vec.y | mask), static_cast<T>(vec.z | mask), static_cast<T>(vec.w | mask) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator^(const Vector4<T>& vec, std::type_identity_t<T> mask) noexcept { return { static_cast<T>(vec.x ^ mask), static_cast<T>(vec.y ^ mask), static_cast<T>(vec.z ^ mask), static_cast<T>(vec.w ^ mask) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator~(const Vector4<T>& vec) noexcept { return { static_cast<T>(~vec.x), static_cast<T>(~vec.y), static_cast<T>(~vec.z), static_cast<T>(~vec.w) }; }
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator<<(const Vector4<T>& vec, unsigned shift) noexcept { return { static_cast<T>(vec.x << shift), static_cast<T>(vec.y << shift), static_cast<T>(vec.z << shift), static_cast<T>(vec.w << shift) }; }
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> operator>>(const Vector4<T>& vec, unsigned shift) noexcept { return { static_cast<T>(vec.x >> shift), static_cast<T>(vec.y >> shift), static_cast<T>(vec.z >> shift), static_cast<T>(vec.w >> shift) }; }
+
+
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr Vector4<T> floor_div(const Vector4<T>& vec, std::type_identity_t<T> divisor) noexcept
+	{
+		return { func::floor_div(vec.x, divisor), func::floor_div(vec.y, divisor), func::floor_div(vec.z, divisor), func::floor_div(vec.w, divisor) };
+	}
+
+	template<std::signed_integral T>
+	[[nodiscard]] constexpr Vector4<T> euclid_mod(const Vector4<T>& vec, std::type_identity_t<T> divisor) noexcept
+	{
+		return { func::euclid_mod(vec.x, divisor), func::euclid_mod(vec.y, divisor), func::euclid_mod(vec.z, divisor), func::euclid_mod(vec.w, divisor) };
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> floor_div_pow2(const Vector4<T>& vec, unsigned shift) noexcept
+	{
+		return vec >> shift;
+	}
+
+	template<std::integral T>
+	[[nodiscard]] constexpr Vector4<T> mod_pow2(const Vector4<T>& vec, unsigned shift) noexcept
+	{
+		return { func::mod_pow2(vec.x, shift), func::mod_pow2(vec.y, shift), func::mod_pow2(vec.z, shift), func::mod_pow2(vec.w, shift) };
+	}
+
+	template<std::integral I = std::int32_t, std::floating_point T>
+	[[nodiscard]] constexpr Vector4<I> floor_to_int(const Vector4<T>& vec) noexcept
+	{
+		return { func::floor_to_int<I>(vec.x), func::floor_to_int<I>(vec.y), func::floor_to_int<I>(vec.z), func::floor_to_int<I>(vec.w) };
+	}
+
+} // mpml
+
+
+namespace mpml::detail::integer
+{
+
+	// Lanes of int32
+
+#if defined(MPML_SIMD_AVX2)
+
+	inline constexpr size_t lane_count{ 8 };
+
+	using IntLanes = __m256i;
+
+	[[nodiscard]] inline IntLanes loadu(const std::int32_t* src) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)); }
+	inline void storeu(std::int32_t* dst, IntLanes vec) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), vec); }
+
+	[[nodiscard]] inline IntLanes floor_to_int(const float* src) noexcept { return _mm256_cvttps_epi32(_mm256_floor_ps(_mm256_loadu_ps(src))); }
+
+	[[nodiscard]] inline IntLanes shift_right(IntLanes vec, unsigned shift) noexcept { return _mm256_sra_epi32(vec, _mm_cvtsi32_si128(static_cast<int>(shift))); }
+	[[nodiscard]] inline IntLanes mask_low(IntLanes vec, std::int32_t mask) noexcept { return _mm256_and_si256(vec, _mm256_set1_epi32(mask)); }
+
+#elif defined(MPML_SIMD_SSE2)
+
+	inline constexpr size_t lane_count{ 4 };
+
+	using IntLanes = __m128i;
+
+	[[nodiscard]] inline IntLanes loadu(const std::int32_t* src) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)); }
+	inline void storeu(std::int32_t* dst, IntLanes vec) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), vec); }
+
+	[[nodiscard]] inline IntLanes floor_to_int(const float* src) noexcept
+	{
+		const __m128 vec{ _mm_loadu_ps(src) };
+#	if defined(MPML_SIMD_SSE41)
+		return _mm_cvttps_epi32(_mm_floor_ps(vec));
+#	else
+		// Truncation minus one where it rounded up, the comparison mask being -1.
+		// Not where the conversion overflowed to INT32_MIN: below -2^31 that would wrap around to INT32_MAX
+		const __m128i truncated{ _mm_cvttps_epi32(vec) };
+		const __m128i overflowed{ _mm_cmpeq_epi32(truncated, _mm_set1_epi32(std::numeric_limits<std::int32_t>::min())) };
+
+		return _mm_add_epi32(truncated, _mm_andnot_si128(overflowed, _mm_castps_si128(_mm_cmplt_ps(vec, _mm_cvtepi32_ps(truncated)))));
+#	endif
+	}
+
+	[[nodiscard]] inline IntLanes shift_right(IntLanes vec, unsigned shift) noexcept { return _mm_sra_epi32(vec, _mm_cvtsi32_si128(static_cast<int>(shift))); }
+	[[nodiscard]] inline IntLanes mask_low(IntLanes vec, std::int32_t mask) noexcept { return _mm_and_si128(vec, _mm_set1_epi32(mask)); }
+
+#endif
+
+
+	// Vector3<T> read as 3 consecutive T
+	template<typename T>
+	[[nodiscard]] inline std::span<const T> components(std::span<const Vector3<T>> vecs) noexcept
+	{
+		static_assert(sizeof(Vector3<T>) == 3 * sizeof(T) && std::is_standard_layout_v<Vector3<T>>, "Vector3<T> must stay x, y, z");
+		return { reinterpret_cast<const T*>(vecs.data()), 3 * vecs.size() };
+	}
+
+	template<typename T>
+	[[nodiscard]] inline std::span<T> components(std::span<Vector3<T>> vecs) noexcept
+	{
+		static_assert(sizeof(Vector3<T>) == 3 * sizeof(T) && std::is_standard_layout_v<Vector3<T>>, "Vector3<T> must stay x, y, z");
+		return { reinterpret_cast<T*>(vecs.data()), 3 * vecs.size() };
+	}
+
+
+	inline void floor_to_int(std::span<const float> in, std::span<std::int32_t> out) noexcept
+	{
+		assert(out.size() >= in.size() && "out is smaller than in");
+
+		const size_t count{ in.size() };
+		size_t i{};
+
+#if defined(MPML_SIMD_SSE2)
+		for (; i + lane_count <= count; i += lane_count)
+			storeu(out.data() + i, floor_to_int(in.data() + i));
+#endif
+
+		for (; i < count; i++)
+			out[i] = func::floor_to_int<std::int32_t>(in[i]);
+	}
+
+	// cell (a floor_to_int result or an int32 cell, From) split by 2^shift
+	template<typename From>
+	inline void split_pow2(std::span<const From> in, unsigned shift, std::span<std::int32_t> chunks, std::span<std::int32_t> locals) noexcept
+	{
+		assert(chunks.size() >= in.size() && locals.size() >= in.size() && "chunks or locals is smaller than in");
+		assert(shift < 32 && "split_pow2: shift is too large");
+
+		const size_t count{ in.size() };
+		const std::int32_t mask{ func::mod_pow2(std::int32_t{ -1 }, shift) };
+		size_t i{};
+
+#if defined(MPML_SIMD_SSE2)
+		for (; i + lane_count <= count; i += lane_count)
+		{
+			IntLanes cell{};
+
+			if constexpr (std::is_same_v<From, float>)
+				cell = floor_to_int(in.data() + i);
+			else
+				cell = loadu(in.data() + i);
+
+			storeu(chunks.data() + i, shift_right(cell, shift));
+			storeu(locals.data() + i, mask_low(cell, mask));
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			std::int32_t cell{};
+
+			if constexpr (std::is_same_v<From, float>)
+				cell = func::floor_to_int<std::int32_t>(in[i]);
+			else
+				cell = in[i];
+
+			chunks[i] = func::floor_div_pow2(cell, shift);
+			locals[i] = cell & mask;
+		}
+	}
+
+} // mpml::detail::integer
+
+
+namespace mpml::func
+{
+
+	// floor of every value
+	inline void floor_to_int(std::span<const float> in, std::span<std::int32_t> out) noexcept { detail::integer::floor_to_int(in, out); }
+	inline void floor_to_int(std::span<const Vector3<float>> in, std::span<Vector3<std::int32_t>> out) noexcept { detail::integer::floor_to_int(detail::integer::components(in), detail::integer::components(out)); }
+
+	// chunk = floor(position) >> shift and local = floor(position) & (2^shift - 1), the cells in chunks of 2^shift
+	inline void split_pow2(std::span<const float> positions, unsigned shift, std::span<std::int32_t> chunks, std::span<std::int32_t> locals) noexcept { detail::integer::split_pow2(positions, shift, chunks, locals); }
+	inline void split_pow2(std::span<const Vector3<float>> positions, unsigned shift, std::span<Vector3<std::int32_t>> chunks, std::span<Vector3<std::int32_t>> locals) noexcept { detail::integer::split_pow2(detail::integer::components(positions), shift, detail::integer::components(chunks), detail::integer::components(locals)); }
+
+	// Same from integer cells
+	inline void split_pow2(std::span<const std::int32_t> cells, unsigned shift, std::span<std::int32_t> chunks, std::span<std::int32_t> locals) noexcept { detail::integer::split_pow2(cells, shift, chunks, locals); }
+	inline void split_pow2(std::span<const Vector3<std::int32_t>> cells, unsigned shift, std::span<Vector3<std::int32_t>> chunks, std::span<Vector3<std::int32_t>> locals) noexcept { detail::integer::split_pow2(detail::integer::components(cells), shift, detail::integer::components(chunks), detail::integer::components(locals)); }
+
+}
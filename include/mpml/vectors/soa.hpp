@@ -0,0 +1,966 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines structure-of-arrays containers for 2D, 3D and 4D vectors
+//
+// Note:
+//	Each component lives in its own 64-byte aligned array, padded to a multiple of 64 bytes,
+//	so float operations run on full SSE/AVX registers without gathers.
+//	The operations mirror the Vector2/3/4 member functions element-wise; those returning a scalar per vector write into a span.
+//	As for Vector4, the dot product, length and normal of Vec4SoA only consider x, y and z (normal keeps w),
+//	the arithmetic operators however work on all four components.
+// ===================================================
+
+
+// Dependencies
+#include <span>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept> // for: std::out_of_range()
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/aligned_allocator.hpp"
+#include "mpml/vectors/vector2.hpp"
+#include "mpml/vectors/vector3.hpp"
+#include "mpml/vectors/vector4.hpp"
+
+
+namespace mpml
+{
+
+	namespace detail::soa
+	{
+
+		// Float lanes of the widest instruction set available, the SoA operations are written once against these
+
+#if defined(MPML_SIMD_AVX)
+
+		using Lanes = __m256;
+		inline constexpr size_t lane_count{ 8 };
+
+		[[nodiscard]] inline Lanes load(const float* src) noexcept { return _mm256_load_ps(src); }
+		[[nodiscard]] inline Lanes loadu(const float* src) noexcept { return _mm256_loadu_ps(src); }
+		inline void store(float* dst, Lanes vec) noexcept { _mm256_store_ps(dst, vec); }
+		inline void storeu(float* dst, Lanes vec) noexcept { _mm256_storeu_ps(dst, vec); }
+
+		[[nodiscard]] inline Lanes set1(float value) noexcept { return _mm256_set1_ps(value); }
+
+		[[nodiscard]] inline Lanes add(Lanes a, Lanes b) noexcept { return _mm256_add_ps(a, b); }
+		[[nodiscard]] inline Lanes sub(Lanes a, Lanes b) noexcept { return _mm256_sub_ps(a, b); }
+		[[nodiscard]] inline Lanes mul(Lanes a, Lanes b) noexcept { return _mm256_mul_ps(a, b); }
+		[[nodiscard]] inline Lanes div(Lanes a, Lanes b) noexcept { return _mm256_div_ps(a, b); }
+		[[nodiscard]] inline Lanes sqrt(Lanes vec) noexcept { return _mm256_sqrt_ps(vec); }
+		[[nodiscard]] inline Lanes min(Lanes a, Lanes b) noexcept { return _mm256_min_ps(a, b); }
+		[[nodiscard]] inline Lanes max(Lanes a, Lanes b) noexcept { return _mm256_max_ps(a, b); }
+		[[nodiscard]] inline Lanes abs(Lanes vec) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), vec); }
+
+		// if_non_zero where selector != 0, otherwise if_zero
+		[[nodiscard]] inline Lanes select_non_zero(Lanes selector, Lanes if_non_zero, Lanes if_zero) noexcept
+		{
+			return _mm256_blendv_ps(if_zero, if_non_zero, _mm256_cmp_ps(selector, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+		}
+
+		// Bit k set where lane k of a is less than lane k of b
+		[[nodiscard]] inline unsigned less_bits(Lanes a, Lanes b) noexcept
+		{
+			return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+		}
+
+#elif defined(MPML_SIMD_SSE2)
+
+		using Lanes = __m128;
+		inline constexpr size_t lane_count{ 4 };
+
+		[[nodiscard]] inline Lanes load(const float* src) noexcept { return _mm_load_ps(src); }
+		[[nodiscard]] inline Lanes loadu(const float* src) noexcept { return _mm_loadu_ps(src); }
+		inline void store(float* dst, Lanes vec) noexcept { _mm_store_ps(dst, vec); }
+		inline void storeu(float* dst, Lanes vec) noexcept { _mm_storeu_ps(dst, vec); }
+
+		[[nodiscard]] inline Lanes set1(float value) noexcept { return _mm_set1_ps(value); }
+
+		[[nodiscard]] inline Lanes add(Lanes a, Lanes b) noexcept { return _mm_add_ps(a, b); }
+		[[nodiscard]] inline Lanes sub(Lanes a, Lanes b) noexcept { return _mm_sub_ps(a, b); }
+		[[nodiscard]] inline Lanes mul(Lanes a, Lanes b) noexcept { return _mm_mul_ps(a, b); }
+		[[nodiscard]] inline Lanes div(Lanes a, Lanes b) noexcept { return _mm_div_ps(a, b); }
+		[[nodiscard]] inline Lanes sqrt(Lanes vec) noexcept { return _mm_sqrt_ps(vec); }
+		[[nodiscard]] inline Lanes min(Lanes a, Lanes b) noexcept { return _mm_min_ps(a, b); }
+		[[nodiscard]] inline Lanes max(Lanes a, Lanes b) noexcept { return _mm_max_ps(a, b); }
+		[[nodiscard]] inline Lanes abs(Lanes vec) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.f), vec); }
+
+		[[nodiscard]] inline Lanes select_non_zero(Lanes selector, Lanes if_non_zero, Lanes if_zero) noexcept
+		{
+			const __m128 mask{ _mm_cmpneq_ps(selector, _mm_setzero_ps()) };
+			return _mm_or_ps(_mm_and_ps(mask, if_non_zero), _mm_andnot_ps(mask, if_zero));
+		}
+
+		[[nodiscard]] inline unsigned less_bits(Lanes a, Lanes b) noexcept
+		{
+			return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(a, b)));
+		}
+
+#else
+
+		// Without SIMD the lanes are never used, single floats keep the operations below well-formed
+		using Lanes = float;
+		inline constexpr size_t lane_count{ 1 };
+
+		[[nodiscard]] inline Lanes load(const float* src) noexcept { return *src; }
+		[[nodiscard]] inline Lanes loadu(const float* src) noexcept { return *src; }
+		inline void store(float* dst, Lanes vec) noexcept { *dst = vec; }
+		inline void storeu(float* dst, Lanes vec) noexcept { *dst = vec; }
+
+		[[nodiscard]] inline Lanes set1(float value) noexcept { return value; }
+
+		[[nodiscard]] inline Lanes add(Lanes a, Lanes b) noexcept { return a + b; }
+		[[nodiscard]] inline Lanes sub(Lanes a, Lanes b) noexcept { return a - b; }
+		[[nodiscard]] inline Lanes mul(Lanes a, Lanes b) noexcept { return a * b; }
+		[[nodiscard]] inline Lanes div(Lanes a, Lanes b) noexcept { return a / b; }
+		[[nodiscard]] inline Lanes sqrt(Lanes vec) noexcept { return std::sqrt(vec); }
+		[[nodiscard]] inline Lanes min(Lanes a, Lanes b) noexcept { return a < b ? a : b; }
+		[[nodiscard]] inline Lanes max(Lanes a, Lanes b) noexcept { return a > b ? a : b; }
+		[[nodiscard]] inline Lanes abs(Lanes vec) noexcept { return std::abs(vec); }
+
+		[[nodiscard]] inline Lanes select_non_zero(Lanes selector, Lanes if_non_zero, Lanes if_zero) noexcept
+		{
+			return selector != 0.f ? if_non_zero : if_zero;
+		}
+
+		[[nodiscard]] inline unsigned less_bits(Lanes a, Lanes b) noexcept
+		{
+			return a < b ? 1u : 0u;
+		}
+
+#endif
+
+		// Calls simd(index) on every full block of lanes below count when T is float, then scalar(index) on what is left
+		// simd must be a generic lambda so that it is only instantiated for float
+		template<typename T, typename SimdOp, typename ScalarOp>
+		inline void for_each(size_t count, [[maybe_unused]] SimdOp&& simd, ScalarOp&& scalar) noexcept
+		{
+			size_t index{};
+
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				for (; index + lane_count <= count; index += lane_count)
+					simd(index);
+			}
+#endif
+
+			for (; index < count; index++)
+				scalar(index);
+		}
+
+	} // detail::soa
+
+
+
+	template<typename T, size_t N>
+	class VecSoA
+	{
+	public:
+
+		static_assert(N >= 2 && N <= 4, "VecSoA holds 2D, 3D or 4D vectors");
+
+		using vector_type = std::conditional_t<N == 2, Vector2<T>, std::conditional_t<N == 3, Vector3<T>, Vector4<T>>>;
+
+		using component_type = std::vector<T, AlignedAllocator<T, 64>>;
+
+
+		// Initialization
+
+		VecSoA() noexcept = default;
+
+		// count null vectors
+		explicit VecSoA(size_t count);
+
+		explicit VecSoA(std::span<const vector_type> vecs);
+
+
+		// Operations
+
+		void dot(const VecSoA<T, N>& vecs, std::span<T> out) const noexcept;
+		[[nodiscard]] VecSoA<T, N> cross(const VecSoA<T, N>& vecs) const requires (N == 3);
+
+		void distance(const VecSoA<T, N>& vecs, std::span<T> out) const noexcept;
+		void distance_squared(const VecSoA<T, N>& vecs, std::span<T> out) const noexcept;
+
+		void length(std::span<T> out) const noexcept;
+		void length_squared(std::span<T> out) const noexcept;
+
+		[[nodiscard]] VecSoA<T, N> normal() const;
+		void normalize() noexcept;
+
+
+		// Reductions, component-wise
+
+		[[nodiscard]] vector_type sum() const noexcept;
+		[[nodiscard]] vector_type min() const noexcept;
+		[[nodiscard]] vector_type max() const noexcept;
+
+
+		// Data related
+
+		[[nodiscard]] size_t size() const noexcept;
+		[[nodiscard]] bool empty() const noexcept;
+
+		void resize(size_t count);
+		void clear() noexcept;
+		void push_back(const vector_type& vec);
+
+		[[nodiscard]] vector_type get(size_t index) const;
+		void set(size_t index, const vector_type& vec);
+
+		void assign(std::span<const vector_type> vecs);
+		void to_aos(std::span<vector_type> out) const noexcept;
+
+		// Storage of one component, padded_size() long
+		[[nodiscard]] std::span<T> component(size_t index);
+		[[nodiscard]] std::span<const T> component(size_t index) const;
+
+		// The count first values of each component
+		[[nodiscard]] std::span<T> x() noexcept;
+		[[nodiscard]] std::span<T> y() noexcept;
+		[[nodiscard]] std::span<T> z() noexcept requires (N >= 3);
+		[[nodiscard]] std::span<T> w() noexcept requires (N == 4);
+
+		[[nodiscard]] std::span<const T> x() const noexcept;
+		[[nodiscard]] std::span<const T> y() const noexcept;
+		[[nodiscard]] std::span<const T> z() const noexcept requires (N >= 3);
+		[[nodiscard]] std::span<const T> w() const noexcept requires (N == 4);
+
+		// Operations running over the whole padding may go up to here
+		[[nodiscard]] size_t padded_size() const noexcept;
+
+
+		// Member Overloads
+
+		VecSoA<T, N>& operator+=(const VecSoA<T, N>& vecs) noexcept;
+		VecSoA<T, N>& operator-=(const VecSoA<T, N>& vecs) noexcept;
+
+		VecSoA<T, N>& operator*=(const T& scalar) noexcept;
+		VecSoA<T, N>& operator/=(const T& scalar) noexcept;
+
+
+		// Class Members
+
+		static constexpr size_t dimensions{ N };
+
+	private:
+
+		// dot, length and normal work on x, y, z like Vector4 does
+		static constexpr size_t metric_size{ N < 3 ? N : 3 };
+
+		// Multiple of 64 bytes, hence of any lane count
+		static constexpr size_t padding_step{ 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1 };
+
+		[[nodiscard]] static constexpr vector_type make_vector(const std::array<T, N>& values) noexcept
+		{
+			if constexpr (N == 2)
+				return vector_type{ values[0], values[1] };
+			else if constexpr (N == 3)
+				return vector_type{ values[0], values[1], values[2] };
+			else
+				return vector_type{ values[0], values[1], values[2], values[3] };
+		}
+
+		[[nodiscard]] static constexpr size_t padded(size_t count) noexcept
+		{
+			return (count + padding_step - 1) / padding_step * padding_step;
+		}
+
+		// Applies op(a, b) to every component (over the padding too), writing back into this
+		template<typename SimdOp, typename ScalarOp>
+		void combine(const VecSoA<T, N>* vecs, SimdOp&& simd, ScalarOp&& scalar) noexcept;
+
+		std::array<component_type, N> components{};
+		size_t count{};
+	};
+
+
+	template<typename T>
+	using Vec2SoA = VecSoA<T, 2>;
+
+	template<typename T>
+	using Vec3SoA = VecSoA<T, 3>;
+
+	template<typename T>
+	using Vec4SoA = VecSoA<T, 4>;
+
+
+
+	// Class Definition
+
+
+
+	// Initialization
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N>::VecSoA(size_t count_)
+	{
+		resize(count_);
+	}
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N>::VecSoA(std::span<const vector_type> vecs)
+	{
+		assign(vecs);
+	}
+
+
+	// Operations
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::dot(const VecSoA<T, N>& vecs, std::span<T> out) const noexcept
+	{
+		assert(vecs.size() == size() && out.size() >= size() && "dot: sizes do not match");
+
+		detail::soa::for_each<T>(count,
+			[&](auto i) {
+				using namespace detail::soa;
+
+				Lanes sum_r{ mul(load(components[0].data() + i), load(vecs.components[0].data() + i)) };
+
+				for (size_t c{ 1 }; c < metric_size; c++)
+					sum_r = add(sum_r, mul(load(components[c].data() + i), load(vecs.components[c].data() + i)));
+
+				storeu(out.data() + i, sum_r);
+			},
+			[&](auto i) {
+				T sum_r{};
+
+				for (size_t c{}; c < metric_size; c++)
+					sum_r += components[c][i] * vecs.components[c][i];
+
+				out[i] = sum_r;
+			});
+	}
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N> VecSoA<T, N>::cross(const VecSoA<T, N>& vecs) const requires (N == 3)
+	{
+		assert(vecs.size() == size() && "cross: sizes do not match");
+
+		VecSoA<T, N> vecs_r(count);
+
+		const T* ax{ components[0].data() };
+		const T* ay{ components[1].data() };
+		const T* az{ components[2].data() };
+
+		const T* bx{ vecs.components[0].data() };
+		const T* by{ vecs.components[1].data() };
+		const T* bz{ vecs.components[2].data() };
+
+		T* rx{ vecs_r.components[0].data() };
+		T* ry{ vecs_r.components[1].data() };
+		T* rz{ vecs_r.components[2].data() };
+
+		detail::soa::for_each<T>(padded_size(),
+			[&](auto i) {
+				using namespace detail::soa;
+
+				const Lanes x1{ load(ax + i) }, y1{ load(ay + i) }, z1{ load(az + i) };
+				const Lanes x2{ load(bx + i) }, y2{ load(by + i) }, z2{ load(bz + i) };
+
+				store(rx + i, sub(mul(y1, z2), mul(z1, y2)));
+				store(ry + i, sub(mul(z1, x2), mul(x1, z2)));
+				store(rz + i, sub(mul(x1, y2), mul(y1, x2)));
+			},
+			[&](auto i) {
+				rx[i] = ay[i] * bz[i] - az[i] * by[i];
+				ry[i] = az[i] * bx[i] - ax[i] * bz[i];
+				rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+			});
+
+		return vecs_r;
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::distance(const VecSoA<T, N>& vecs, std::span<T> out) const noexcept
+	{
+		distance_squared(vecs, out);
+
+		detail::soa::for_each<T>(count,
+			[&](auto i) {
+				using namespace detail::soa;
+				storeu(out.data() + i, detail::soa::sqrt(loadu(out.data() + i)));
+			},
+			[&](auto i) {
+				out[i] = static_cast<T>(std::sqrt(out[i]));
+			});
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::distance_squared(const VecSoA<T, N>& vecs, std::span<T> out) const noexcept
+	{
+		assert(vecs.size() == size() && out.size() >= size() && "distance: sizes do not match");
+
+		detail::soa::for_each<T>(count,
+			[&](auto i) {
+				using namespace detail::soa;
+
+				const Lanes delta{ sub(load(components[0].data() + i), load(vecs.components[0].data() + i)) };
+				Lanes sum_r{ mul(delta, delta) };
+
+				for (size_t c{ 1 }; c < N; c++)
+				{
+					const Lanes delta_c{ sub(load(components[c].data() + i), load(vecs.components[c].data() + i)) };
+					sum_r = add(sum_r, mul(delta_c, delta_c));
+				}
+
+				storeu(out.data() + i, sum_r);
+			},
+			[&](auto i) {
+				T sum_r{};
+
+				for (size_t c{}; c < N; c++)
+				{
+					const T delta{ components[c][i] - vecs.components[c][i] };
+					sum_r += delta * delta;
+				}
+
+				out[i] = sum_r;
+			});
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::length(std::span<T> out) const noexcept
+	{
+		assert(out.size() >= size() && "length: out is too small");
+
+		detail::soa::for_each<T>(count,
+			[&](auto i) {
+				using namespace detail::soa;
+
+				Lanes sum_r{ mul(load(components[0].data() + i), load(components[0].data() + i)) };
+
+				for (size_t c{ 1 }; c < metric_size; c++)
+					sum_r = add(sum_r, mul(load(components[c].data() + i), load(components[c].data() + i)));
+
+				storeu(out.data() + i, detail::soa::sqrt(sum_r));
+			},
+			[&](auto i) {
+				T sum_r{};
+
+				for (size_t c{}; c < metric_size; c++)
+					sum_r += components[c][i] * components[c][i];
+
+				out[i] = sum_r == T{} ? T{} : static_cast<T>(std::sqrt(sum_r));
+			});
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::length_squared(std::span<T> out) const noexcept
+	{
+		dot(*this, out);
+	}
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N> VecSoA<T, N>::normal() const
+	{
+		VecSoA<T, N> vecs_r{ *this };
+		vecs_r.normalize();
+		return vecs_r;
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::normalize() noexcept
+	{
+		detail::soa::for_each<T>(padded_size(),
+			[&](auto i) {
+				using namespace detail::soa;
+
+				Lanes len_sqd{ mul(load(components[0].data() + i), load(components[0].data() + i)) };
+
+				for (size_t c{ 1 }; c < metric_size; c++)
+					len_sqd = add(len_sqd, mul(load(components[c].data() + i), load(components[c].data() + i)));
+
+				const Lanes len{ detail::soa::sqrt(len_sqd) };
+
+				// Null vectors stay null
+				for (size_t c{}; c < metric_size; c++)
+				{
+					const Lanes comp{ load(components[c].data() + i) };
+					store(components[c].data() + i, select_non_zero(len_sqd, div(comp, len), comp));
+				}
+			},
+			[&](auto i) {
+				T len_sqd{};
+
+				for (size_t c{}; c < metric_size; c++)
+					len_sqd += components[c][i] * components[c][i];
+
+				if (len_sqd == T{})
+					return;
+
+				const T len{ static_cast<T>(std::sqrt(len_sqd)) };
+
+				for (size_t c{}; c < metric_size; c++)
+					components[c][i] /= len;
+			});
+	}
+
+
+	// Reductions
+
+	template<typename T, size_t N>
+	inline typename VecSoA<T, N>::vector_type VecSoA<T, N>::sum() const noexcept
+	{
+		std::array<T, N> sums{};
+
+		for (size_t c{}; c < N; c++)
+		{
+			const T* comp{ components[c].data() };
+
+			size_t i{};
+
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				using namespace detail::soa;
+
+				Lanes sum_r{ set1(0.f) };
+
+				for (; i + lane_count <= count; i += lane_count)
+					sum_r = add(sum_r, load(comp + i));
+
+				alignas(32) float lanes[lane_count];
+				store(lanes, sum_r);
+
+				for (float lane : lanes)
+					sums[c] += lane;
+			}
+#endif
+
+			for (; i < count; i++)
+				sums[c] += comp[i];
+		}
+
+		return make_vector(sums);
+	}
+
+	template<typename T, size_t N>
+	inline typename VecSoA<T, N>::vector_type VecSoA<T, N>::min() const noexcept
+	{
+		assert(!empty() && "min: the container is empty");
+
+		std::array<T, N> mins{};
+
+		for (size_t c{}; c < N; c++)
+		{
+			const T* comp{ components[c].data() };
+
+			mins[c] = comp[0];
+
+			size_t i{};
+
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				using namespace detail::soa;
+
+				Lanes min_r{ set1(comp[0]) };
+
+				for (; i + lane_count <= count; i += lane_count)
+					min_r = detail::soa::min(min_r, load(comp + i));
+
+				alignas(32) float lanes[lane_count];
+				store(lanes, min_r);
+
+				for (float lane : lanes)
+					mins[c] = lane < mins[c] ? lane : mins[c];
+			}
+#endif
+
+			for (; i < count; i++)
+				mins[c] = comp[i] < mins[c] ? comp[i] : mins[c];
+		}
+
+		return make_vector(mins);
+	}
+
+	template<typename T, size_t N>
+	inline typename VecSoA<T, N>::vector_type VecSoA<T, N>::max() const noexcept
+	{
+		assert(!empty() && "max: the container is empty");
+
+		std::array<T, N> maxs{};
+
+		for (size_t c{}; c < N; c++)
+		{
+			const T* comp{ components[c].data() };
+
+			maxs[c] = comp[0];
+
+			size_t i{};
+
+#if defined(MPML_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				using namespace detail::soa;
+
+				Lanes max_r{ set1(comp[0]) };
+
+				for (; i + lane_count <= count; i += lane_count)
+					max_r = detail::soa::max(max_r, load(comp + i));
+
+				alignas(32) float lanes[lane_count];
+				store(lanes, max_r);
+
+				for (float lane : lanes)
+					maxs[c] = lane > maxs[c] ? lane : maxs[c];
+			}
+#endif
+
+			for (; i < count; i++)
+				maxs[c] = comp[i] > maxs[c] ? comp[i] : maxs[c];
+		}
+
+		return make_vector(maxs);
+	}
+
+
+	// Data related
+
+	template<typename T, size_t N>
+	inline size_t VecSoA<T, N>::size() const noexcept
+	{
+		return count;
+	}
+
+	template<typename T, size_t N>
+	inline bool VecSoA<T, N>::empty() const noexcept
+	{
+		return count == 0;
+	}
+
+	template<typename T, size_t N>
+	inline size_t VecSoA<T, N>::padded_size() const noexcept
+	{
+		return padded(count);
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::resize(size_t count_)
+	{
+		for (auto& comp : components)
+		{
+			comp.resize(padded(count_));
+
+			// Shrinking leaves old values behind, the padding is kept null
+			std::fill(comp.begin() + static_cast<std::ptrdiff_t>(std::min(count, count_)), comp.end(), T{});
+		}
+
+		count = count_;
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::clear() noexcept
+	{
+		for (auto& comp : components)
+			comp.clear();
+
+		count = 0;
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::push_back(const vector_type& vec)
+	{
+		if (count == padded_size())
+			for (auto& comp : components)
+				comp.resize(padded(count + 1));
+
+		const T* values{ &vec.x };
+
+		for (size_t c{}; c < N; c++)
+			components[c][count] = values[c];
+
+		count++;
+	}
+
+	template<typename T, size_t N>
+	inline typename VecSoA<T, N>::vector_type VecSoA<T, N>::get(size_t index) const
+	{
+		if (index >= count)
+			throw std::out_of_range("index is out of range in VecSoA");
+
+		std::array<T, N> values;
+
+		for (size_t c{}; c < N; c++)
+			values[c] = components[c][index];
+
+		return make_vector(values);
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::set(size_t index, const vector_type& vec)
+	{
+		if (index >= count)
+			throw std::out_of_range("index is out of range in VecSoA");
+
+		const T* values{ &vec.x };
+
+		for (size_t c{}; c < N; c++)
+			components[c][index] = values[c];
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::assign(std::span<const vector_type> vecs)
+	{
+		count = 0;
+		resize(vecs.size());
+
+		for (size_t i{}; i < vecs.size(); i++)
+		{
+			const T* values{ &vecs[i].x };
+
+			for (size_t c{}; c < N; c++)
+				components[c][i] = values[c];
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void VecSoA<T, N>::to_aos(std::span<vector_type> out) const noexcept
+	{
+		assert(out.size() >= size() && "to_aos: out is too small");
+
+		for (size_t i{}; i < count; i++)
+		{
+			T* values{ &out[i].x };
+
+			for (size_t c{}; c < N; c++)
+				values[c] = components[c][i];
+		}
+	}
+
+	template<typename T, size_t N>
+	inline std::span<T> VecSoA<T, N>::component(size_t index)
+	{
+		if (index >= N)
+			throw std::out_of_range("index is out of range in VecSoA");
+
+		return components[index];
+	}
+
+	template<typename T, size_t N>
+	inline std::span<const T> VecSoA<T, N>::component(size_t index) const
+	{
+		if (index >= N)
+			throw std::out_of_range("index is out of range in VecSoA");
+
+		return components[index];
+	}
+
+	template<typename T, size_t N>
+	inline std::span<T> VecSoA<T, N>::x() noexcept
+	{
+		return { components[0].data(), count };
+	}
+
+	template<typename T, size_t N>
+	inline std::span<const T> VecSoA<T, N>::x() const noexcept
+	{
+		return { components[0].data(), count };
+	}
+
+	template<typename T, size_t N>
+	inline std::span<T> VecSoA<T, N>::y() noexcept
+	{
+		return { components[1].data(), count };
+	}
+
+	template<typename T, size_t N>
+	inline std::span<const T> VecSoA<T, N>::y() const noexcept
+	{
+		return { components[1].data(), count };
+	}
+
+	template<typename T, size_t N>
+	inline std::span<T> VecSoA<T, N>::z() noexcept requires (N >= 3)
+	{
+		return { components[2].data(), count };
+	}
+
+	template<typename T, size_t N>
+	inline std::span<const T> VecSoA<T, N>::z() const noexcept requires (N >= 3)
+	{
+		return { components[2].data(), count };
+	}
+
+	template<typename T, size_t N>
+	inline std::span<T> VecSoA<T, N>::w() noexcept requires (N == 4)
+	{
+		return { components[3].data(), count };
+	}
+
+	template<typename T, size_t N>
+	inline std::span<const T> VecSoA<T, N>::w() const noexcept requires (N == 4)
+	{
+		return { components[3].data(), count };
+	}
+
+
+	// Member Overloads
+
+	template<typename T, size_t N>
+	template<typename SimdOp, typename ScalarOp>
+	inline void VecSoA<T, N>::combine(const VecSoA<T, N>* vecs, SimdOp&& simd, ScalarOp&& scalar) noexcept
+	{
+		for (size_t c{}; c < N; c++)
+		{
+			T* dst{ components[c].data() };
+			const T* src{ vecs ? vecs->components[c].data() : nullptr };
+
+			detail::soa::for_each<T>(padded_size(),
+				[&](auto i) { simd(dst + i, src ? src + i : nullptr); },
+				[&](auto i) { scalar(dst[i], src ? src[i] : T{}); });
+		}
+	}
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N>& VecSoA<T, N>::operator+=(const VecSoA<T, N>& vecs) noexcept
+	{
+		assert(vecs.size() == size() && "operator+=: sizes do not match");
+
+		combine(&vecs,
+			[](auto* dst, const auto* src) { using namespace detail::soa; store(dst, add(load(dst), load(src))); },
+			[](T& dst, const T& src) { dst += src; });
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N>& VecSoA<T, N>::operator-=(const VecSoA<T, N>& vecs) noexcept
+	{
+		assert(vecs.size() == size() && "operator-=: sizes do not match");
+
+		combine(&vecs,
+			[](auto* dst, const auto* src) { using namespace detail::soa; store(dst, sub(load(dst), load(src))); },
+			[](T& dst, const T& src) { dst -= src; });
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N>& VecSoA<T, N>::operator*=(const T& scalar) noexcept
+	{
+		combine(nullptr,
+			[&](auto* dst, const auto*) { using namespace detail::soa; store(dst, mul(load(dst), set1(scalar))); },
+			[&](T& dst, const T&) { dst *= scalar; });
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline VecSoA<T, N>& VecSoA<T, N>::operator/=(const T& scalar) noexcept
+	{
+		combine(nullptr,
+			[&](auto* dst, const auto*) { using namespace detail::soa; store(dst, div(load(dst), set1(scalar))); },
+			[&](T& dst, const T&) { dst /= scalar; });
+
+		return *this;
+	}
+
+
+	// Overloads
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> operator+(VecSoA<T, N> a, const VecSoA<T, N>& b) noexcept
+	{
+		return a += b;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> operator-(VecSoA<T, N> a, const VecSoA<T, N>& b) noexcept
+	{
+		return a -= b;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> operator*(VecSoA<T, N> a, const T& k) noexcept
+	{
+		return a *= k;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> operator*(const T& k, VecSoA<T, N> a) noexcept
+	{
+		return a *= k;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> operator/(VecSoA<T, N> a, const T& k) noexcept
+	{
+		return a /= k;
+	}
+
+
+	// Utilities, element-wise like their vectors/transforms.hpp counterparts
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> min(const VecSoA<T, N>& a, const VecSoA<T, N>& b)
+	{
+		assert(a.size() == b.size() && "min: sizes do not match");
+
+		VecSoA<T, N> vecs_r(a.size());
+
+		for (size_t c{}; c < N; c++)
+		{
+			const T* src_a{ a.component(c).data() };
+			const T* src_b{ b.component(c).data() };
+			T* dst{ vecs_r.component(c).data() };
+
+			detail::soa::for_each<T>(a.padded_size(),
+				[&](auto i) { using namespace detail::soa; store(dst + i, detail::soa::min(load(src_a + i), load(src_b + i))); },
+				[&](auto i) { dst[i] = src_a[i] < src_b[i] ? src_a[i] : src_b[i]; });
+		}
+
+		return vecs_r;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> max(const VecSoA<T, N>& a, const VecSoA<T, N>& b)
+	{
+		assert(a.size() == b.size() && "max: sizes do not match");
+
+		VecSoA<T, N> vecs_r(a.size());
+
+		for (size_t c{}; c < N; c++)
+		{
+			const T* src_a{ a.component(c).data() };
+			const T* src_b{ b.component(c).data() };
+			T* dst{ vecs_r.component(c).data() };
+
+			detail::soa::for_each<T>(a.padded_size(),
+				[&](auto i) { using namespace detail::soa; store(dst + i, detail::soa::max(load(src_a + i), load(src_b + i))); },
+				[&](auto i) { dst[i] = src_a[i] > src_b[i] ? src_a[i] : src_b[i]; });
+		}
+
+		return vecs_r;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] inline VecSoA<T, N> abs(const VecSoA<T, N>& vecs)
+	{
+		VecSoA<T, N> vecs_r(vecs.size());
+
+		for (size_t c{}; c < N; c++)
+		{
+			const T* src{ vecs.component(c).data() };
+			T* dst{ vecs_r.component(c).data() };
+
+			detail::soa::for_each<T>(vecs.padded_size(),
+				[&](auto i) { using namespace detail::soa; store(dst + i, detail::soa::abs(load(src + i))); },
+				[&](auto i) { dst[i] = std::abs(src[i]); });
+		}
+
+		return vecs_r;
+	}
+
+} // mpml
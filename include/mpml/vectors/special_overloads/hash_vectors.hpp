@@ -1,12 +1,17 @@
-#pragma once 
+#pragma once
 // MIT
 // Allosker - 2026
 // ===================================================
 // Defines some overloads and utility functions for the "unordered_map" stl container
+//
+// Note:
+//	Vectors of integers go through mpml::func::hash (utilities/hash.hpp), std::hash of an int being the identity on most standard libraries.
 // ===================================================
 
 #include <unordered_map>
+#include <concepts>
 #include "mpml/vectors/vectors.hpp"
+#include "mpml/utilities/hash.hpp"
 
 
 template <typename T>
@@ -27,12 +32,17 @@ namespace std
     template <typename U>
     struct hash<mpml::Vector2<U>>
     {
-        size_t operator ()(const mpml::Vector2<U>& vec) const 
+        size_t operator ()(const mpml::Vector2<U>& vec) const
         {
-            std::size_t seed{};
-            hash_combine(seed, vec.x, vec.y);
+            if constexpr (std::integral<U>)
+                return static_cast<size_t>(mpml::func::hash(vec));
+            else
+            {
+                std::size_t seed{};
+                hash_combine(seed, vec.x, vec.y);
 
-            return seed;
+                return seed;
+            }
         }
     };
 
@@ -41,10 +51,15 @@ namespace std
     {
         size_t operator ()(const mpml::Vector3<U>& vec) const
         {
-            std::size_t seed{};
-            hash_combine(seed, vec.x, vec.y, vec.z);
+            if constexpr (std::integral<U>)
+                return static_cast<size_t>(mpml::func::hash(vec));
+            else
+            {
+                std::size_t seed{};
+                hash_combine(seed, vec.x, vec.y, vec.z);
 
-            return seed;
+                return seed;
+            }
         }
     };
 
@@ -53,10 +68,15 @@ namespace std
     {
         size_t operator ()(const mpml::Vector4<U>& vec) const
         {
-            std::size_t seed{};
-            hash_combine(seed, vec.x, vec.y, vec.z, vec.w);
+            if constexpr (std::integral<U>)
+                return static_cast<size_t>(mpml::func::hash(vec));
+            else
+            {
+                std::size_t seed{};
+                hash_combine(seed, vec.x, vec.y, vec.z, vec.w);
 
-            return seed;
+                return seed;
+            }
         }
     };
 }
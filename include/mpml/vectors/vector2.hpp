@@ -16,6 +16,8 @@
 #include <stdexcept> // for: std::out_of_range()
 
 #include "mpml/utilities/angle.hpp"
+#include "mpml/functions/trigo.hpp"
+#include "mpml/utilities/pack.hpp"
 
 
 namespace mpml
@@ -56,7 +58,7 @@ namespace mpml
 		[[nodiscard]] constexpr T distance(const Vector2<T>& vec) const noexcept;
 		[[nodiscard]] constexpr T distance_squared(const Vector2<T>& vec) const noexcept;
 
-		[[nodiscard]] constexpr Angle<> angle(const Vector2<T>& vec) const noexcept;
+		[[nodiscard]] constexpr Angle<T> angle(const Vector2<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector2<T> project(const Vector2<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector2<T> reflect(const Vector2<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector2<T> reject(const Vector2<T>& vec) const noexcept;
@@ -158,9 +160,10 @@ namespace mpml
 	}
 
 	template<typename T>
-	inline constexpr Angle<> Vector2<T>::angle(const Vector2<T>& vec) const noexcept
+	inline constexpr Angle<T> Vector2<T>::angle(const Vector2<T>& vec) const noexcept
 	{
-		return static_cast<Angle<>>(std::acos(dot(vec) / T{length() * vec.length()}));
+		using std::acos;
+		return Angle<T>::from_radians(acos(dot(vec) / T{ length() * vec.length() }));
 	}
 
 	template<typename T>
@@ -192,17 +195,23 @@ namespace mpml
 	template<typename T>
 	inline constexpr Vector2<T> Vector2<T>::rotate(Angle<> angle) const noexcept
 	{
-		return Vector2<T>{ x * std::cos(angle.as_radians()) + y * -std::sin(angle.as_radians()), x * std::sin(angle.as_radians()) + y * std::cos(angle.as_radians())};
+		const auto [sin, cos]{ func::sincos(angle) };
+		return Vector2<T>{ x * cos + y * -sin, x * sin + y * cos };
 	}
 
 	template<typename T>
 	inline constexpr T Vector2<T>::length() const noexcept
 	{
-		T lengthSquared{ x * x + y * y }; 
+		T lengthSquared{ x * x + y * y };
 
-		if (lengthSquared == T{})
-			return T{};
-		return T{ std::sqrt(lengthSquared) };
+		if constexpr (!is_pack_v<T>)
+		{
+			if (lengthSquared == T{})
+				return T{};
+		}
+
+		using std::sqrt;
+		return T{ sqrt(lengthSquared) };
 	}
 
 	template<typename T>
@@ -215,9 +224,18 @@ namespace mpml
 	inline constexpr Vector2<T> Vector2<T>::normal() const noexcept
 	{
 		T len{ length() }; 
-		if (len == T{})
-			return Vector2<T>{};
-		return Vector2<T>{x / len, y / len};
+
+		if constexpr (is_pack_v<T>)
+		{
+			const T inv_len{ detail::pack::reciprocal_or_zero(len) };
+			return Vector2<T>{ x * inv_len, y * inv_len };
+		}
+		else
+		{
+			if (len == T{})
+				return Vector2<T>{};
+			return Vector2<T>{x / len, y / len};
+		}
 	}
 
 	template<typename T>
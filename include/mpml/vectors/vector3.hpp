@@ -17,6 +17,7 @@
 #include <stdexcept> // for: std::out_of_range()
 
 #include "mpml/utilities/angle.hpp"
+#include "mpml/utilities/pack.hpp"
 #include "mpml/vectors/vector2.hpp"
 
 
@@ -59,7 +60,7 @@ namespace mpml
 		[[nodiscard]] constexpr T distance(const Vector3<T>& vec) const noexcept;
 		[[nodiscard]] constexpr T distance_squared(const Vector3<T>& vec) const noexcept;
 
-		[[nodiscard]] constexpr Angle<> angle(const Vector3<T>& vec) const noexcept;
+		[[nodiscard]] constexpr Angle<T> angle(const Vector3<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector3<T> project(const Vector3<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector3<T> reflect(const Vector3<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector3<T> reject(const Vector3<T>& vec) const noexcept;
@@ -181,9 +182,10 @@ namespace mpml
 	}
 
 	template<typename T>
-	inline constexpr Angle<> Vector3<T>::angle(const Vector3<T>& vec) const noexcept
+	inline constexpr Angle<T> Vector3<T>::angle(const Vector3<T>& vec) const noexcept
 	{
-		return static_cast<Angle<>>(T{std::acos(dot(vec) / T{length() *  vec.length()})});
+		using std::acos;
+		return Angle<T>::from_radians(acos(dot(vec) / T{ length() * vec.length() }));
 	}
 
 	template<typename T>
@@ -210,9 +212,15 @@ namespace mpml
 	{
 		T lengthSquared{ x * x + y * y + z * z };
 
-		if (lengthSquared == T{})
-			return T{};
-		return T{ std::sqrt(lengthSquared) };
+		// sqrt(0) is already 0, packs skip the test to stay branchless
+		if constexpr (!is_pack_v<T>)
+		{
+			if (lengthSquared == T{})
+				return T{};
+		}
+
+		using std::sqrt;
+		return T{ sqrt(lengthSquared) };
 	}
 
 	template<typename T>
@@ -226,9 +234,18 @@ namespace mpml
 	{
 		T len{ length() };
 	
-		if (len == T{})
-			return T{};
-		return Vector3<T>{ x / len, y / len, z / len};
+		if constexpr (is_pack_v<T>)
+		{
+			// Zero in the lanes holding a null vector
+			const T inv_len{ detail::pack::reciprocal_or_zero(len) };
+			return Vector3<T>{ x * inv_len, y * inv_len, z * inv_len };
+		}
+		else
+		{
+			if (len == T{})
+				return T{};
+			return Vector3<T>{ x / len, y / len, z / len};
+		}
 	}
 
 	template<typename T>
@@ -0,0 +1,516 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Defines a padded 3D vector and the basic functions it possesses
+//
+// Note:
+//	Vector3A behaves like Vector3 but holds a fourth, always zero, padding component and is aligned on its padded size.
+//	Vector3A<float> therefore loads as a single SSE register and its operations run on that register outside of constant evaluation.
+//	Prefer Vector3 for storage that is uploaded or serialized as tightly packed triples.
+// ===================================================
+
+
+// Dependencies
+#include <cmath>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept> // for: std::out_of_range()
+
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/pack.hpp"
+#include "mpml/utilities/angle.hpp"
+#include "mpml/vectors/vector3.hpp"
+
+
+namespace mpml
+{
+
+	template<typename T>
+	class alignas(std::is_arithmetic_v<T> ? 4 * sizeof(T) : alignof(T)) Vector3A
+	{
+	public:
+		// Initialization
+
+		constexpr Vector3A() noexcept = default;
+		constexpr Vector3A(const T& values) noexcept;
+
+		constexpr Vector3A(const Vector3A&) noexcept = default;
+		constexpr Vector3A& operator=(const Vector3A&) noexcept = default;
+
+		constexpr Vector3A(Vector3A&&) noexcept = default;
+		constexpr Vector3A& operator=(Vector3A&&) noexcept = default;
+
+
+		constexpr Vector3A(const T& x_, const T& y_, const T& z_) noexcept;
+
+		constexpr Vector3A(const Vector3<T>& vec) noexcept;
+
+		template<typename U>
+		explicit constexpr Vector3A(const Vector3A<U>& vec) noexcept;
+
+
+		// Conversions
+
+		[[nodiscard]] constexpr operator Vector3<T>() const noexcept;
+
+
+		// Operations
+
+		[[nodiscard]] constexpr T dot(const Vector3A<T>& vec) const noexcept;
+		[[nodiscard]] constexpr Vector3A<T> cross(const Vector3A<T>& vec) const noexcept;
+
+		[[nodiscard]] constexpr T distance(const Vector3A<T>& vec) const noexcept;
+		[[nodiscard]] constexpr T distance_squared(const Vector3A<T>& vec) const noexcept;
+
+		[[nodiscard]] constexpr Angle<T> angle(const Vector3A<T>& vec) const noexcept;
+		[[nodiscard]] constexpr Vector3A<T> project(const Vector3A<T>& vec) const noexcept;
+		[[nodiscard]] constexpr Vector3A<T> reflect(const Vector3A<T>& vec) const noexcept;
+		[[nodiscard]] constexpr Vector3A<T> reject(const Vector3A<T>& vec) const noexcept;
+
+
+		[[nodiscard]] constexpr T length() const noexcept;
+		[[nodiscard]] constexpr T length_squared() const noexcept;
+
+		[[nodiscard]] constexpr Vector3A<T> normal() const noexcept;
+
+
+		// Data related
+
+		[[nodiscard]] constexpr T* data_ptr() noexcept;
+		[[nodiscard]] constexpr const T* data_ptr() const noexcept;
+
+		[[nodiscard]] constexpr T& operator[](size_t index);
+		[[nodiscard]] constexpr const T& operator[](size_t index) const;
+
+
+		// Overloads
+
+		constexpr Vector3A<T>& operator+=(const Vector3A<T>& vec) noexcept;
+		constexpr Vector3A<T>& operator-=(const Vector3A<T>& vec) noexcept;
+
+		constexpr Vector3A<T>& operator+=(const T& scalar) noexcept;
+		constexpr Vector3A<T>& operator-=(const T& scalar) noexcept;
+		constexpr Vector3A<T>& operator*=(const T& scalar) noexcept;
+		constexpr Vector3A<T>& operator/=(const T& scalar) noexcept;
+
+		[[nodiscard]] constexpr Vector3A<T> operator-() const noexcept;
+
+		[[nodiscard]] constexpr auto operator<=>(const Vector3A<T>&) const noexcept = default;
+
+
+		// Class members
+
+
+		T x{};
+		T y{};
+		T z{};
+
+		static constexpr size_t size{ 3 };
+
+	private:
+
+		// Padding lane, kept at zero by every operation
+		T padding{};
+	};
+
+
+
+	namespace detail::simd
+	{
+
+#if defined(MPML_SIMD_SSE2)
+
+		[[nodiscard]] inline __m128 load(const Vector3A<float>& vec) noexcept
+		{
+			return _mm_load_ps(vec.data_ptr());
+		}
+
+		[[nodiscard]] inline Vector3A<float> to_vector3a(__m128 vec) noexcept
+		{
+			Vector3A<float> vec_r;
+			_mm_store_ps(vec_r.data_ptr(), xyz(vec));
+			return vec_r;
+		}
+
+#endif
+
+	} // detail::simd
+
+
+
+	// Class Definition
+
+
+
+	// Intialization
+
+	template<typename T>
+	inline constexpr Vector3A<T>::Vector3A(const T& values) noexcept
+		: x{ values }, y{ values }, z{ values }
+	{
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T>::Vector3A(const T& x_, const T& y_, const T& z_) noexcept
+		: x{ x_ }, y{ y_ }, z{ z_ }
+	{
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T>::Vector3A(const Vector3<T>& vec) noexcept
+		: x{ vec.x }, y{ vec.y }, z{ vec.z }
+	{
+	}
+
+	template<typename T>
+	template<typename U>
+	inline constexpr Vector3A<T>::Vector3A(const Vector3A<U>& vec) noexcept
+		: x{ static_cast<T>(vec.x) }, y{ static_cast<T>(vec.y) }, z{ static_cast<T>(vec.z) }
+	{
+	}
+
+
+	// Conversions
+
+	template<typename T>
+	inline constexpr Vector3A<T>::operator Vector3<T>() const noexcept
+	{
+		return Vector3<T>{ x, y, z };
+	}
+
+
+	// Operations
+
+	template<typename T>
+	inline constexpr T Vector3A<T>::dot(const Vector3A<T>& vec) const noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return _mm_cvtss_f32(detail::simd::sum(_mm_mul_ps(detail::simd::load(*this), detail::simd::load(vec))));
+		}
+#endif
+
+		return T{ x * vec.x + y * vec.y + z * vec.z };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> Vector3A<T>::cross(const Vector3A<T>& vec) const noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector3a(detail::simd::cross3(detail::simd::load(*this), detail::simd::load(vec)));
+		}
+#endif
+
+		return Vector3A<T>{
+			y * vec.z - z * vec.y,
+			z * vec.x - x * vec.z,
+			x * vec.y - y * vec.x
+		};
+	}
+
+	template<typename T>
+	inline constexpr T Vector3A<T>::distance(const Vector3A<T>& vec) const noexcept
+	{
+		return T{ Vector3A<T>{*this - vec}.length() };
+	}
+
+	template<typename T>
+	inline constexpr T Vector3A<T>::distance_squared(const Vector3A<T>& vec) const noexcept
+	{
+		return T{ Vector3A<T>{*this - vec}.length_squared() };
+	}
+
+	template<typename T>
+	inline constexpr Angle<T> Vector3A<T>::angle(const Vector3A<T>& vec) const noexcept
+	{
+		using std::acos;
+		return Angle<T>::from_radians(acos(dot(vec) / T{ length() * vec.length() }));
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> Vector3A<T>::project(const Vector3A<T>& vec) const noexcept
+	{
+		Vector3A<T> norm{ vec.normal() };
+		return Vector3A<T>{ dot(norm) * norm };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> Vector3A<T>::reflect(const Vector3A<T>& vec) const noexcept
+	{
+		return Vector3A<T>{ *this - static_cast<T>(2) * project(vec) };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> Vector3A<T>::reject(const Vector3A<T>& vec) const noexcept
+	{
+		return Vector3A<T>{ *this - project(vec) };
+	}
+
+	template<typename T>
+	inline constexpr T Vector3A<T>::length() const noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const __m128 vec{ detail::simd::load(*this) };
+				return _mm_cvtss_f32(_mm_sqrt_ss(detail::simd::sum(_mm_mul_ps(vec, vec))));
+			}
+		}
+#endif
+
+		T lengthSquared{ x * x + y * y + z * z };
+
+		if constexpr (!is_pack_v<T>)
+		{
+			if (lengthSquared == T{})
+				return T{};
+		}
+
+		using std::sqrt;
+		return T{ sqrt(lengthSquared) };
+	}
+
+	template<typename T>
+	inline constexpr T Vector3A<T>::length_squared() const noexcept
+	{
+		return dot(*this);
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> Vector3A<T>::normal() const noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const __m128 vec{ detail::simd::load(*this) };
+				const __m128 len_sqd{ detail::simd::sum(_mm_mul_ps(vec, vec)) };
+
+				if (_mm_cvtss_f32(len_sqd) == 0.f)
+					return Vector3A<T>{};
+				return detail::simd::to_vector3a(_mm_div_ps(vec, _mm_sqrt_ps(len_sqd)));
+			}
+		}
+#endif
+
+		T len{ length() };
+
+		if constexpr (is_pack_v<T>)
+		{
+			const T inv_len{ detail::pack::reciprocal_or_zero(len) };
+			return Vector3A<T>{ x * inv_len, y * inv_len, z * inv_len };
+		}
+		else
+		{
+			if (len == T{})
+				return Vector3A<T>{};
+			return Vector3A<T>{ x / len, y / len, z / len };
+		}
+	}
+
+
+	// Data related
+	template<typename T>
+	inline constexpr T* Vector3A<T>::data_ptr() noexcept
+	{
+		return &x;
+	}
+
+	template<typename T>
+	inline constexpr const T* Vector3A<T>::data_ptr() const noexcept
+	{
+		return &x;
+	}
+
+	template<typename T>
+	inline constexpr T& Vector3A<T>::operator[](size_t index)
+	{
+		if (index >= size)
+			throw std::out_of_range("index is out of range in Vector3A");
+		return *(&x + index);
+	}
+
+	template<typename T>
+	inline constexpr const T& Vector3A<T>::operator[](size_t index) const
+	{
+		if (index >= size)
+			throw std::out_of_range("index is out of range in Vector3A");
+		return *(&x + index);
+	}
+
+	// Member Overloads
+	template<typename T>
+	inline constexpr Vector3A<T>& Vector3A<T>::operator+=(const Vector3A<T>& vec) noexcept
+	{
+		*this = *this + vec;
+		return *this;
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T>& Vector3A<T>::operator-=(const Vector3A<T>& vec) noexcept
+	{
+		*this = *this - vec;
+		return *this;
+	}
+
+
+	template<typename T>
+	inline constexpr Vector3A<T>& Vector3A<T>::operator+=(const T& scalar) noexcept
+	{
+		*this = *this + scalar;
+		return *this;
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T>& Vector3A<T>::operator-=(const T& scalar) noexcept
+	{
+		*this = *this - scalar;
+		return *this;
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T>& Vector3A<T>::operator*=(const T& scalar) noexcept
+	{
+		*this = *this * scalar;
+		return *this;
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T>& Vector3A<T>::operator/=(const T& scalar) noexcept
+	{
+		*this = *this / scalar;
+		return *this;
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> Vector3A<T>::operator-() const noexcept
+	{
+		return Vector3A<T>{ -x, -y, -z };
+	}
+
+
+	// Overloads
+	template<typename T>
+	inline constexpr Vector3A<T> operator+(const Vector3A<T>& a, const Vector3A<T>& b) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector3a(_mm_add_ps(detail::simd::load(a), detail::simd::load(b)));
+		}
+#endif
+
+		return Vector3A<T>{ a.x + b.x, a.y + b.y, a.z + b.z };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator-(const Vector3A<T>& a, const Vector3A<T>& b) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector3a(_mm_sub_ps(detail::simd::load(a), detail::simd::load(b)));
+		}
+#endif
+
+		return Vector3A<T>{ a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator*(const Vector3A<T>& a, const T& k) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector3a(_mm_mul_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
+		return Vector3A<T>{ a.x * k, a.y * k, a.z * k };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator/(const Vector3A<T>& a, const T& k) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector3a(_mm_div_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
+		return Vector3A<T>{ a.x / k, a.y / k, a.z / k };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator+(const Vector3A<T>& a, const T& k) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector3a(_mm_add_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
+		return Vector3A<T>{ a.x + k, a.y + k, a.z + k };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator-(const Vector3A<T>& a, const T& k) noexcept
+	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector3a(_mm_sub_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
+		return Vector3A<T>{ a.x - k, a.y - k, a.z - k };
+	}
+
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator*(const T& k, const Vector3A<T>& a) noexcept
+	{
+		return a * k;
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator/(const T& k, const Vector3A<T>& a) noexcept
+	{
+		// The padding lane would divide by zero, stays scalar
+		return Vector3A<T>{ k / a.x, k / a.y, k / a.z };
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator+(const T& k, const Vector3A<T>& a) noexcept
+	{
+		return a + k;
+	}
+
+	template<typename T>
+	inline constexpr Vector3A<T> operator-(const T& k, const Vector3A<T>& a) noexcept
+	{
+		return -(a - k);
+	}
+
+
+
+} // mpml
@@ -9,14 +9,20 @@
 //	This class acts as the foundation of all 4D based tensors.
 //  Also bear in mind that this class behaves like a 3D vector, with for only change the integration of a 4th component: w.
 //  However, this component does not participate in any operation and is as such merely here for convenience.
+//  Vector4<float> is 16-byte aligned so that its four components load as a single SSE register,
+//  the operations below run on that register outside of constant evaluation.
 // ===================================================
 
 
 // Dependencies
+#include <cmath>
 #include <utility>
 #include <algorithm>
+#include <type_traits>
 #include <stdexcept> // for: std::out_of_range()
 
+#include "mpml/utilities/simd.hpp"
+#include "mpml/utilities/pack.hpp"
 #include "mpml/utilities/angle.hpp"
 #include "mpml/vectors/vector3.hpp"
 
@@ -28,7 +34,7 @@ namespace mpml
 	class Vector3;
 
 	template<typename T>
-	class Vector4
+	class alignas(std::is_same_v<T, float> ? 16 : alignof(T)) Vector4
 	{
 	public:
 		// Initialization
@@ -63,7 +69,7 @@ namespace mpml
 		[[nodiscard]] constexpr T distance(const Vector4<T>& vec) const noexcept;
 		[[nodiscard]] constexpr T distance_squared(const Vector4<T>& vec) const noexcept;
 
-		[[nodiscard]] constexpr Angle<> angle(const Vector4<T>& vec) const noexcept;
+		[[nodiscard]] constexpr Angle<T> angle(const Vector4<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector4<T> project(const Vector4<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector4<T> reflect(const Vector4<T>& vec) const noexcept;
 		[[nodiscard]] constexpr Vector4<T> reject(const Vector4<T>& vec) const noexcept;
@@ -125,6 +131,30 @@ namespace mpml
 
 
 
+	namespace detail::simd
+	{
+
+#if defined(MPML_SIMD_SSE2)
+
+		[[nodiscard]] inline __m128 load(const Vector4<float>& vec) noexcept
+		{
+			return _mm_load_ps(vec.data_ptr());
+		}
+
+		// Results of the vector operations keep the scalar convention of a w component set to 1
+		[[nodiscard]] inline Vector4<float> to_vector4(__m128 vec) noexcept
+		{
+			Vector4<float> vec_r;
+			_mm_store_ps(vec_r.data_ptr(), with_w(vec, 1.f));
+			return vec_r;
+		}
+
+#endif
+
+	} // detail::simd
+
+
+
 	// Class Definition
 
 
@@ -167,12 +197,28 @@ namespace mpml
 	template<typename T>
 	inline constexpr T Vector4<T>::dot(const Vector4<T>& vec) const noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return _mm_cvtss_f32(detail::simd::dot3(detail::simd::load(*this), detail::simd::load(vec)));
+		}
+#endif
+
 		return T{ x * vec.x + y * vec.y + z * vec.z };
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> Vector4<T>::cross(const Vector4<T>& vec) const noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(detail::simd::cross3(detail::simd::load(*this), detail::simd::load(vec)));
+		}
+#endif
+
 		return Vector4<T>{
 			y * vec.z - z * vec.y,
 			z * vec.x - x * vec.z,
@@ -193,9 +239,10 @@ namespace mpml
 	}
 
 	template<typename T>
-	inline constexpr Angle<> Vector4<T>::angle(const Vector4<T>& vec) const noexcept
+	inline constexpr Angle<T> Vector4<T>::angle(const Vector4<T>& vec) const noexcept
 	{
-		return static_cast<Angle<>>(T{ std::acos(dot(vec) / T{length() * vec.length()}) });
+		using std::acos;
+		return Angle<T>::from_radians(acos(dot(vec) / T{ length() * vec.length() }));
 	}
 
 	template<typename T>
@@ -220,27 +267,77 @@ namespace mpml
 	template<typename T>
 	inline constexpr T Vector4<T>::length() const noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const __m128 vec{ detail::simd::load(*this) };
+				return _mm_cvtss_f32(_mm_sqrt_ss(detail::simd::dot3(vec, vec)));
+			}
+		}
+#endif
+
 		T lengthSquared{ x * x + y * y + z * z };
 
-		if (lengthSquared == T{})
-			return T{};
-		return T{ std::sqrt(lengthSquared) };
+		if constexpr (!is_pack_v<T>)
+		{
+			if (lengthSquared == T{})
+				return T{};
+		}
+
+		using std::sqrt;
+		return T{ sqrt(lengthSquared) };
 	}
 
 	template<typename T>
 	inline constexpr T Vector4<T>::length_squared() const noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const __m128 vec{ detail::simd::load(*this) };
+				return _mm_cvtss_f32(detail::simd::dot3(vec, vec));
+			}
+		}
+#endif
+
 		return T{ x * x + y * y + z * z };
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> Vector4<T>::normal() const noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const __m128 vec{ detail::simd::load(*this) };
+				const __m128 len_sqd{ detail::simd::dot3(vec, vec) };
+
+				if (_mm_cvtss_f32(len_sqd) == 0.f)
+					return T{};
+				return detail::simd::to_vector4(_mm_div_ps(vec, _mm_sqrt_ps(len_sqd)));
+			}
+		}
+#endif
+
 		T len{ length() };
 
-		if (len == T{})
-			return T{};
-		return Vector4<T>{ x / len, y / len, z / len };
+		if constexpr (is_pack_v<T>)
+		{
+			const T inv_len{ detail::pack::reciprocal_or_zero(len) };
+			return Vector4<T>{ x * inv_len, y * inv_len, z * inv_len };
+		}
+		else
+		{
+			if (len == T{})
+				return T{};
+			return Vector4<T>{ x / len, y / len, z / len };
+		}
 	}
 
 
@@ -320,7 +417,7 @@ namespace mpml
 	template<typename T>
 	inline constexpr Vector4<T> Vector4<T>::operator-() const noexcept
 	{
-		return Vector4<T>{-x, -y};
+		return Vector4<T>{-x, -y, -z, -w};
 	}
 
 
@@ -328,12 +425,28 @@ namespace mpml
 	template<typename T>
 	inline constexpr Vector4<T> operator+(const Vector4<T>& a, const Vector4<T>& b) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_add_ps(detail::simd::load(a), detail::simd::load(b)));
+		}
+#endif
+
 		return Vector4<T>{a.x + b.x, a.y + b.y, a.z + b.z};
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> operator-(const Vector4<T>& a, const Vector4<T>& b) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_sub_ps(detail::simd::load(a), detail::simd::load(b)));
+		}
+#endif
+
 		return Vector4<T>{a.x - b.x, a.y - b.y, a.z - b.z};
 	}
 
@@ -341,24 +454,56 @@ namespace mpml
 	template<typename T>
 	inline constexpr Vector4<T> operator*(const Vector4<T>& a, const T& k) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_mul_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
 		return Vector4<T>{a.x* k, a.y* k, a.z* k};
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> operator/(const Vector4<T>& a, const T& k) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_div_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
 		return Vector4<T>{a.x / k, a.y / k, a.z / k};
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> operator+(const Vector4<T>& a, const T& k) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_add_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
 		return Vector4<T>{a.x + k, a.y + k, a.z + k};
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> operator-(const Vector4<T>& a, const T& k) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_sub_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
 		return Vector4<T>{a.x - k, a.y - k, a.z - k};
 	}
 
@@ -366,24 +511,56 @@ namespace mpml
 	template<typename T>
 	inline constexpr Vector4<T> operator*(const T& k, const Vector4<T>& a) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_mul_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
 		return Vector4<T>{ a.x* k, a.y* k, a.z* k};
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> operator/(const T& k, const Vector4<T>& a) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_div_ps(_mm_set1_ps(k), detail::simd::load(a)));
+		}
+#endif
+
 		return Vector4<T>{ k / a.x, k / a.y, k / a.z };
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> operator+(const T& k, const Vector4<T>& a) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_add_ps(detail::simd::load(a), _mm_set1_ps(k)));
+		}
+#endif
+
 		return Vector4<T>{a.x + k, a.y + k, a.z + k };
 	}
 
 	template<typename T>
 	inline constexpr Vector4<T> operator-(const T& k, const Vector4<T>& a) noexcept
 	{
+#if defined(MPML_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simd::to_vector4(_mm_sub_ps(_mm_set1_ps(k), detail::simd::load(a)));
+		}
+#endif
+
 		return Vector4<T>{k - a.x, k - a.y, k - a.z };
 	}
 
@@ -11,7 +11,10 @@
 #include "mpml/vectors/vector2.hpp"
 #include "mpml/vectors/vector3.hpp"
 #include "mpml/vectors/vector4.hpp"
+#include "mpml/vectors/vector3a.hpp"
+#include "mpml/vectors/soa.hpp"
 
 // -- Utilities
 #include "mpml/vectors/transforms.hpp"
+#include "mpml/vectors/integer.hpp"
 #include "mpml/vectors/special_overloads/hash_vectors.hpp"
\ No newline at end of file
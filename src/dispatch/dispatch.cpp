@@ -0,0 +1,182 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// CPU detection and selection of the kernels behind mpml/dispatch/dispatch.hpp
+// ===================================================
+
+#include <atomic>
+#include <cassert>
+#include <algorithm>
+
+#if defined(MPML_DISPATCH_X86) && defined(_MSC_VER)
+#	include <intrin.h>
+#	include <immintrin.h>
+#endif
+
+#include "kernels.hpp"
+
+
+namespace mpml::dispatch
+{
+
+	namespace
+	{
+
+		[[nodiscard]] Level query_cpu() noexcept
+		{
+#if defined(MPML_DISPATCH_X86)
+#	if defined(_MSC_VER)
+			int info[4];
+
+			__cpuid(info, 0);
+			const int max_leaf{ info[0] };
+
+			__cpuid(info, 1);
+			const bool fma{ (info[2] & (1 << 12)) != 0 };
+			const bool os_xsave{ (info[2] & (1 << 27)) != 0 };
+
+			// The OS must also save the ymm (and zmm) registers on context switches
+			const unsigned long long xcr0{ os_xsave ? _xgetbv(0) : 0 };
+			const bool os_ymm{ (xcr0 & 0x06) == 0x06 };
+			const bool os_zmm{ (xcr0 & 0xE6) == 0xE6 };
+
+			bool avx2{}, avx512f{};
+
+			if (max_leaf >= 7)
+			{
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0;
+				avx512f = (info[1] & (1 << 16)) != 0;
+			}
+
+			if (avx512f && os_zmm)
+				return Level::avx512;
+			if (avx2 && fma && os_ymm)
+				return Level::avx2;
+			return Level::sse2;
+#	else
+			// Also checks that the OS saves the extended registers
+			__builtin_cpu_init();
+
+			if (__builtin_cpu_supports("avx512f"))
+				return Level::avx512;
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+				return Level::avx2;
+			return Level::sse2;
+#	endif
+#else
+			return Level::scalar;
+#endif
+		}
+
+		[[nodiscard]] const detail::Kernels& kernels_for(Level level) noexcept
+		{
+			using namespace detail;
+
+			static constexpr Kernels scalar_kernels{ Level::scalar, scalar::transform_points, scalar::normalize, scalar::cull_spheres };
+
+#if defined(MPML_DISPATCH_X86)
+			static constexpr Kernels sse2_kernels{ Level::sse2, sse2::transform_points, sse2::normalize, sse2::cull_spheres };
+			static constexpr Kernels avx2_kernels{ Level::avx2, avx2::transform_points, avx2::normalize, avx2::cull_spheres };
+			static constexpr Kernels avx512_kernels{ Level::avx512, avx512::transform_points, avx512::normalize, avx512::cull_spheres };
+
+			switch (level)
+			{
+			case Level::avx512:
+				return avx512_kernels;
+			case Level::avx2:
+				return avx2_kernels;
+			case Level::sse2:
+				return sse2_kernels;
+			default:
+				break;
+			}
+#else
+			(void)level;
+#endif
+
+			return scalar_kernels;
+		}
+
+		std::atomic<const detail::Kernels*> active_kernels{ nullptr };
+
+		[[nodiscard]] const detail::Kernels& kernels() noexcept
+		{
+			const detail::Kernels* current{ active_kernels.load(std::memory_order_acquire) };
+
+			if (!current)
+			{
+				current = &kernels_for(detected_level());
+				active_kernels.store(current, std::memory_order_release);
+			}
+
+			return *current;
+		}
+
+	}
+
+
+	// Levels
+
+	Level detected_level() noexcept
+	{
+		static const Level detected{ query_cpu() };
+		return detected;
+	}
+
+	Level active_level() noexcept
+	{
+		return kernels().level;
+	}
+
+	Level force_level(Level level) noexcept
+	{
+		const detail::Kernels& forced{ kernels_for(std::min(level, detected_level())) };
+		active_kernels.store(&forced, std::memory_order_release);
+
+		return forced.level;
+	}
+
+	void reset_level() noexcept
+	{
+		active_kernels.store(&kernels_for(detected_level()), std::memory_order_release);
+	}
+
+	const char* level_name(Level level) noexcept
+	{
+		switch (level)
+		{
+		case Level::scalar:
+			return "scalar";
+		case Level::sse2:
+			return "sse2";
+		case Level::avx2:
+			return "avx2";
+		case Level::avx512:
+			return "avx512";
+		}
+
+		return "unknown";
+	}
+
+
+	// Kernels
+
+	void transform_points(const Matrix4<float>& mat, std::span<const Vector3<float>> points, std::span<Vector3<float>> out) noexcept
+	{
+		assert(out.size() >= points.size() && "transform_points: out is smaller than points");
+		kernels().transform_points(mat, points.data(), out.data(), points.size());
+	}
+
+	void normalize(std::span<Vector3<float>> vectors) noexcept
+	{
+		kernels().normalize(vectors.data(), vectors.size());
+	}
+
+	std::size_t cull_spheres(std::span<const Vector4<float>> planes, std::span<const Vector4<float>> spheres, std::span<std::uint32_t> visible) noexcept
+	{
+		assert(visible.size() >= spheres.size() && "cull_spheres: visible is smaller than spheres");
+		return kernels().cull_spheres(planes.data(), planes.size(), spheres.data(), spheres.size(), visible.data());
+	}
+
+} // mpml::dispatch
@@ -0,0 +1,68 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Per instruction set kernels behind mpml/dispatch/dispatch.hpp
+//
+// Note:
+//	Each namespace is defined in its own translation unit compiled with the matching target flags.
+//	Those translation units must only touch raw members (x, y, z, data...) of the MPML types:
+//	calling inline MPML functions there would emit copies built for that instruction set,
+//	and the linker is free to keep one of them for the whole program.
+// ===================================================
+
+
+// Dependencies
+#include <cstddef>
+#include <cstdint>
+
+#include "mpml/dispatch/dispatch.hpp"
+
+
+namespace mpml::dispatch::detail
+{
+
+	// Same contracts as the public functions, spans already checked
+	struct Kernels
+	{
+		Level level;
+
+		void (*transform_points)(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept;
+		void (*normalize)(Vector3<float>* vectors, std::size_t count) noexcept;
+		std::size_t (*cull_spheres)(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept;
+	};
+
+
+	namespace scalar
+	{
+		void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept;
+		void normalize(Vector3<float>* vectors, std::size_t count) noexcept;
+		std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept;
+	}
+
+#if defined(MPML_DISPATCH_X86)
+
+	namespace sse2
+	{
+		void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept;
+		void normalize(Vector3<float>* vectors, std::size_t count) noexcept;
+		std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept;
+	}
+
+	namespace avx2
+	{
+		void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept;
+		void normalize(Vector3<float>* vectors, std::size_t count) noexcept;
+		std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept;
+	}
+
+	namespace avx512
+	{
+		void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept;
+		void normalize(Vector3<float>* vectors, std::size_t count) noexcept;
+		std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept;
+	}
+
+#endif
+
+} // mpml::dispatch::detail
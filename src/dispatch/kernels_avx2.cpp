@@ -0,0 +1,156 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// AVX2 + FMA kernels, 8 elements per iteration
+// ===================================================
+
+#include <immintrin.h>
+
+#include "kernels.hpp"
+
+
+namespace
+{
+
+	// Lanes X, Y of vec1 followed by lanes Z, W of vec2, within each 128-bit half
+	template<int X, int Y, int Z, int W>
+	inline __m256 shuffle(__m256 vec1, __m256 vec2) noexcept
+	{
+		return _mm256_shuffle_ps(vec1, vec2, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	inline __m256 load_halves(const float* low, const float* high) noexcept
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+	}
+
+	inline void store_halves(float* low, float* high, __m256 vec) noexcept
+	{
+		_mm_storeu_ps(low, _mm256_castps256_ps128(vec));
+		_mm_storeu_ps(high, _mm256_extractf128_ps(vec, 1));
+	}
+
+	// 8 packed Vector3<float> (24 floats) to one register per component, and back
+	// Points 0 to 3 go to the low halves and 4 to 7 to the high halves, so each half is the SSE transpose
+
+	inline void load_soa(const float* src, __m256& x, __m256& y, __m256& z) noexcept
+	{
+		const __m256 a{ load_halves(src, src + 12) };
+		const __m256 b{ load_halves(src + 4, src + 16) };
+		const __m256 c{ load_halves(src + 8, src + 20) };
+
+		x = shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c));
+		y = shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c));
+		z = shuffle<0, 2, 0, 3>(shuffle<2, 2, 1, 1>(a, b), c);
+	}
+
+	inline void store_soa(float* dst, __m256 x, __m256 y, __m256 z) noexcept
+	{
+		store_halves(dst, dst + 12, shuffle<0, 2, 0, 2>(shuffle<0, 0, 0, 0>(x, y), shuffle<0, 0, 1, 1>(z, x)));
+		store_halves(dst + 4, dst + 16, shuffle<0, 2, 0, 2>(shuffle<1, 1, 1, 1>(y, z), shuffle<2, 2, 2, 2>(x, y)));
+		store_halves(dst + 8, dst + 20, shuffle<0, 2, 0, 2>(shuffle<2, 2, 3, 3>(z, x), shuffle<3, 3, 3, 3>(y, z)));
+	}
+
+}
+
+
+namespace mpml::dispatch::detail::avx2
+{
+
+	void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept
+	{
+		const __m256 a{ _mm256_set1_ps(mat.a) }, b{ _mm256_set1_ps(mat.b) }, c{ _mm256_set1_ps(mat.c) };
+		const __m256 e{ _mm256_set1_ps(mat.e) }, f{ _mm256_set1_ps(mat.f) }, g{ _mm256_set1_ps(mat.g) };
+		const __m256 i{ _mm256_set1_ps(mat.i) }, j{ _mm256_set1_ps(mat.j) }, k{ _mm256_set1_ps(mat.k) };
+		const __m256 m{ _mm256_set1_ps(mat.m) }, n{ _mm256_set1_ps(mat.n) }, o{ _mm256_set1_ps(mat.o) };
+
+		std::size_t index{};
+
+		for (; index + 8 <= count; index += 8)
+		{
+			__m256 x, y, z;
+			load_soa(&points[index].x, x, y, z);
+
+			const __m256 x_r{ _mm256_fmadd_ps(a, x, _mm256_fmadd_ps(e, y, _mm256_fmadd_ps(i, z, m))) };
+			const __m256 y_r{ _mm256_fmadd_ps(b, x, _mm256_fmadd_ps(f, y, _mm256_fmadd_ps(j, z, n))) };
+			const __m256 z_r{ _mm256_fmadd_ps(c, x, _mm256_fmadd_ps(g, y, _mm256_fmadd_ps(k, z, o))) };
+
+			store_soa(&out[index].x, x_r, y_r, z_r);
+		}
+
+		scalar::transform_points(mat, points + index, out + index, count - index);
+	}
+
+	void normalize(Vector3<float>* vectors, std::size_t count) noexcept
+	{
+		std::size_t index{};
+
+		for (; index + 8 <= count; index += 8)
+		{
+			__m256 x, y, z;
+			load_soa(&vectors[index].x, x, y, z);
+
+			const __m256 len_sqd{ _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_mul_ps(z, z))) };
+			const __m256 len{ _mm256_sqrt_ps(len_sqd) };
+
+			// Null vectors are left untouched
+			const __m256 non_null{ _mm256_cmp_ps(len_sqd, _mm256_setzero_ps(), _CMP_NEQ_UQ) };
+
+			x = _mm256_blendv_ps(x, _mm256_div_ps(x, len), non_null);
+			y = _mm256_blendv_ps(y, _mm256_div_ps(y, len), non_null);
+			z = _mm256_blendv_ps(z, _mm256_div_ps(z, len), non_null);
+
+			store_soa(&vectors[index].x, x, y, z);
+		}
+
+		scalar::normalize(vectors + index, count - index);
+	}
+
+	std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept
+	{
+		std::size_t visible_count{};
+		std::size_t index{};
+
+		for (; index + 8 <= count; index += 8)
+		{
+			// Spheres 0 to 3 in the low halves, 4 to 7 in the high halves, then a 4x4 transpose per half
+			const __m256 s0{ load_halves(&spheres[index].x, &spheres[index + 4].x) };
+			const __m256 s1{ load_halves(&spheres[index + 1].x, &spheres[index + 5].x) };
+			const __m256 s2{ load_halves(&spheres[index + 2].x, &spheres[index + 6].x) };
+			const __m256 s3{ load_halves(&spheres[index + 3].x, &spheres[index + 7].x) };
+
+			const __m256 xy01{ _mm256_unpacklo_ps(s0, s1) };
+			const __m256 xy23{ _mm256_unpacklo_ps(s2, s3) };
+			const __m256 zr01{ _mm256_unpackhi_ps(s0, s1) };
+			const __m256 zr23{ _mm256_unpackhi_ps(s2, s3) };
+
+			const __m256 x{ shuffle<0, 1, 0, 1>(xy01, xy23) };
+			const __m256 y{ shuffle<2, 3, 2, 3>(xy01, xy23) };
+			const __m256 z{ shuffle<0, 1, 0, 1>(zr01, zr23) };
+			const __m256 neg_r{ _mm256_sub_ps(_mm256_setzero_ps(), shuffle<2, 3, 2, 3>(zr01, zr23)) };
+
+			int inside{ 0xFF };
+
+			for (std::size_t p{}; p < plane_count && inside; p++)
+			{
+				const __m256 dist{ _mm256_fmadd_ps(_mm256_set1_ps(planes[p].x), x,
+					_mm256_fmadd_ps(_mm256_set1_ps(planes[p].y), y,
+					_mm256_fmadd_ps(_mm256_set1_ps(planes[p].z), z, _mm256_set1_ps(planes[p].w)))) };
+
+				inside &= _mm256_movemask_ps(_mm256_cmp_ps(dist, neg_r, _CMP_GE_OQ));
+			}
+
+			for (std::uint32_t lane{}; lane < 8; lane++)
+				if (inside & (1 << lane))
+					visible[visible_count++] = static_cast<std::uint32_t>(index) + lane;
+		}
+
+		const std::size_t tail{ scalar::cull_spheres(planes, plane_count, spheres + index, count - index, visible + visible_count) };
+
+		for (std::size_t t{}; t < tail; t++)
+			visible[visible_count + t] += static_cast<std::uint32_t>(index);
+
+		return visible_count + tail;
+	}
+
+} // mpml::dispatch::detail::avx2
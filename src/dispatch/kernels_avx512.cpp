@@ -0,0 +1,216 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// AVX-512 F kernels, 16 elements per iteration
+// ===================================================
+
+#include <bit>
+#include <immintrin.h>
+
+#include "kernels.hpp"
+
+
+namespace
+{
+
+	struct Indices
+	{
+		alignas(64) std::int32_t lanes[16];
+	};
+
+	// 16 packed Vector3<float> span 3 registers: component c of point j is the float 3 * j + c
+	// It is gathered in two two-sources permutations, the first one over registers 0 and 1, the second one adding register 2
+
+	constexpr Indices deinterleave_first(int c) noexcept
+	{
+		Indices indices{};
+
+		for (int j{}; j < 16; j++)
+			indices.lanes[j] = 3 * j + c < 32 ? 3 * j + c : 0;
+
+		return indices;
+	}
+
+	constexpr Indices deinterleave_second(int c) noexcept
+	{
+		Indices indices{};
+
+		for (int j{}; j < 16; j++)
+			indices.lanes[j] = 3 * j + c < 32 ? j : 16 + (3 * j + c - 32);
+
+		return indices;
+	}
+
+	// Float k of output register o is component (16 * o + k) % 3 of point (16 * o + k) / 3
+	// The first permutation brings in x and y, the second one z
+
+	constexpr Indices interleave_first(int o) noexcept
+	{
+		Indices indices{};
+
+		for (int k{}; k < 16; k++)
+		{
+			const int g{ 16 * o + k };
+			indices.lanes[k] = g % 3 == 0 ? g / 3 : g % 3 == 1 ? 16 + g / 3 : 0;
+		}
+
+		return indices;
+	}
+
+	constexpr Indices interleave_second(int o) noexcept
+	{
+		Indices indices{};
+
+		for (int k{}; k < 16; k++)
+		{
+			const int g{ 16 * o + k };
+			indices.lanes[k] = g % 3 == 2 ? 16 + g / 3 : k;
+		}
+
+		return indices;
+	}
+
+	// Component c of sphere j (4 floats each) within a pair of registers
+	constexpr Indices sphere_component(int c) noexcept
+	{
+		Indices indices{};
+
+		for (int j{}; j < 16; j++)
+			indices.lanes[j] = 4 * (j % 8) + c;
+
+		return indices;
+	}
+
+	inline __m512i load(const Indices& indices) noexcept
+	{
+		return _mm512_load_si512(indices.lanes);
+	}
+
+	inline void load_soa(const float* src, __m512& x, __m512& y, __m512& z) noexcept
+	{
+		static constexpr Indices first[3]{ deinterleave_first(0), deinterleave_first(1), deinterleave_first(2) };
+		static constexpr Indices second[3]{ deinterleave_second(0), deinterleave_second(1), deinterleave_second(2) };
+
+		const __m512 a{ _mm512_loadu_ps(src) };
+		const __m512 b{ _mm512_loadu_ps(src + 16) };
+		const __m512 c{ _mm512_loadu_ps(src + 32) };
+
+		x = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, load(first[0]), b), load(second[0]), c);
+		y = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, load(first[1]), b), load(second[1]), c);
+		z = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, load(first[2]), b), load(second[2]), c);
+	}
+
+	inline void store_soa(float* dst, __m512 x, __m512 y, __m512 z) noexcept
+	{
+		static constexpr Indices first[3]{ interleave_first(0), interleave_first(1), interleave_first(2) };
+		static constexpr Indices second[3]{ interleave_second(0), interleave_second(1), interleave_second(2) };
+
+		for (int o{}; o < 3; o++)
+			_mm512_storeu_ps(dst + 16 * o, _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, load(first[o]), y), load(second[o]), z));
+	}
+
+}
+
+
+namespace mpml::dispatch::detail::avx512
+{
+
+	void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept
+	{
+		const __m512 a{ _mm512_set1_ps(mat.a) }, b{ _mm512_set1_ps(mat.b) }, c{ _mm512_set1_ps(mat.c) };
+		const __m512 e{ _mm512_set1_ps(mat.e) }, f{ _mm512_set1_ps(mat.f) }, g{ _mm512_set1_ps(mat.g) };
+		const __m512 i{ _mm512_set1_ps(mat.i) }, j{ _mm512_set1_ps(mat.j) }, k{ _mm512_set1_ps(mat.k) };
+		const __m512 m{ _mm512_set1_ps(mat.m) }, n{ _mm512_set1_ps(mat.n) }, o{ _mm512_set1_ps(mat.o) };
+
+		std::size_t index{};
+
+		for (; index + 16 <= count; index += 16)
+		{
+			__m512 x, y, z;
+			load_soa(&points[index].x, x, y, z);
+
+			const __m512 x_r{ _mm512_fmadd_ps(a, x, _mm512_fmadd_ps(e, y, _mm512_fmadd_ps(i, z, m))) };
+			const __m512 y_r{ _mm512_fmadd_ps(b, x, _mm512_fmadd_ps(f, y, _mm512_fmadd_ps(j, z, n))) };
+			const __m512 z_r{ _mm512_fmadd_ps(c, x, _mm512_fmadd_ps(g, y, _mm512_fmadd_ps(k, z, o))) };
+
+			store_soa(&out[index].x, x_r, y_r, z_r);
+		}
+
+		scalar::transform_points(mat, points + index, out + index, count - index);
+	}
+
+	void normalize(Vector3<float>* vectors, std::size_t count) noexcept
+	{
+		std::size_t index{};
+
+		for (; index + 16 <= count; index += 16)
+		{
+			__m512 x, y, z;
+			load_soa(&vectors[index].x, x, y, z);
+
+			const __m512 len_sqd{ _mm512_fmadd_ps(x, x, _mm512_fmadd_ps(y, y, _mm512_mul_ps(z, z))) };
+
+			// Null vectors are left untouched
+			const __mmask16 non_null{ _mm512_cmp_ps_mask(len_sqd, _mm512_setzero_ps(), _CMP_NEQ_UQ) };
+
+			// Zero-masked: GCC 12 warns on the undefined source register of the unmasked _mm512_sqrt_ps under -Wall
+			const __m512 len{ _mm512_maskz_sqrt_ps(non_null, len_sqd) };
+
+			x = _mm512_mask_div_ps(x, non_null, x, len);
+			y = _mm512_mask_div_ps(y, non_null, y, len);
+			z = _mm512_mask_div_ps(z, non_null, z, len);
+
+			store_soa(&vectors[index].x, x, y, z);
+		}
+
+		scalar::normalize(vectors + index, count - index);
+	}
+
+	std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept
+	{
+		static constexpr Indices components[4]{ sphere_component(0), sphere_component(1), sphere_component(2), sphere_component(3) };
+
+		std::size_t visible_count{};
+		std::size_t index{};
+
+		const __m512i lanes{ _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15) };
+
+		for (; index + 16 <= count; index += 16)
+		{
+			// Each register holds 4 spheres, the first 8 lanes come from registers 0 and 1, the last 8 from 2 and 3
+			const __m512 s0{ _mm512_loadu_ps(&spheres[index].x) };
+			const __m512 s1{ _mm512_loadu_ps(&spheres[index + 4].x) };
+			const __m512 s2{ _mm512_loadu_ps(&spheres[index + 8].x) };
+			const __m512 s3{ _mm512_loadu_ps(&spheres[index + 12].x) };
+
+			__m512 soa[4];
+
+			for (int c{}; c < 4; c++)
+				soa[c] = _mm512_mask_blend_ps(0xFF00, _mm512_permutex2var_ps(s0, load(components[c]), s1), _mm512_permutex2var_ps(s2, load(components[c]), s3));
+
+			const __m512 neg_r{ _mm512_sub_ps(_mm512_setzero_ps(), soa[3]) };
+
+			__mmask16 inside{ 0xFFFF };
+
+			for (std::size_t p{}; p < plane_count && inside; p++)
+			{
+				const __m512 dist{ _mm512_fmadd_ps(_mm512_set1_ps(planes[p].x), soa[0],
+					_mm512_fmadd_ps(_mm512_set1_ps(planes[p].y), soa[1],
+					_mm512_fmadd_ps(_mm512_set1_ps(planes[p].z), soa[2], _mm512_set1_ps(planes[p].w)))) };
+
+				inside = _mm512_mask_cmp_ps_mask(inside, dist, neg_r, _CMP_GE_OQ);
+			}
+
+			_mm512_mask_compressstoreu_epi32(visible + visible_count, inside, _mm512_add_epi32(lanes, _mm512_set1_epi32(static_cast<int>(index))));
+			visible_count += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(inside)));
+		}
+
+		const std::size_t tail{ scalar::cull_spheres(planes, plane_count, spheres + index, count - index, visible + visible_count) };
+
+		for (std::size_t t{}; t < tail; t++)
+			visible[visible_count + t] += static_cast<std::uint32_t>(index);
+
+		return visible_count + tail;
+	}
+
+} // mpml::dispatch::detail::avx512
@@ -0,0 +1,68 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// Portable kernels, also used for the tails of the SIMD variants
+// ===================================================
+
+#include <cmath>
+
+#include "kernels.hpp"
+
+
+namespace mpml::dispatch::detail::scalar
+{
+
+	void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept
+	{
+		for (std::size_t i{}; i < count; i++)
+		{
+			const float x{ points[i].x };
+			const float y{ points[i].y };
+			const float z{ points[i].z };
+
+			out[i].x = mat.a * x + mat.e * y + mat.i * z + mat.m;
+			out[i].y = mat.b * x + mat.f * y + mat.j * z + mat.n;
+			out[i].z = mat.c * x + mat.g * y + mat.k * z + mat.o;
+		}
+	}
+
+	void normalize(Vector3<float>* vectors, std::size_t count) noexcept
+	{
+		for (std::size_t i{}; i < count; i++)
+		{
+			Vector3<float>& vec{ vectors[i] };
+
+			const float len_sqd{ vec.x * vec.x + vec.y * vec.y + vec.z * vec.z };
+
+			if (len_sqd == 0.f)
+				continue;
+
+			const float len{ std::sqrt(len_sqd) };
+
+			vec.x /= len;
+			vec.y /= len;
+			vec.z /= len;
+		}
+	}
+
+	std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept
+	{
+		std::size_t visible_count{};
+
+		for (std::size_t i{}; i < count; i++)
+		{
+			const Vector4<float>& sphere{ spheres[i] };
+
+			bool inside{ true };
+
+			for (std::size_t p{}; p < plane_count && inside; p++)
+				inside = planes[p].x * sphere.x + planes[p].y * sphere.y + planes[p].z * sphere.z + planes[p].w >= -sphere.w;
+
+			if (inside)
+				visible[visible_count++] = static_cast<std::uint32_t>(i);
+		}
+
+		return visible_count;
+	}
+
+} // mpml::dispatch::detail::scalar
@@ -0,0 +1,139 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// SSE2 kernels, 4 elements per iteration
+// ===================================================
+
+#include <immintrin.h>
+
+#include "kernels.hpp"
+
+
+namespace
+{
+
+	// Lanes X, Y of vec1 followed by lanes Z, W of vec2
+	template<int X, int Y, int Z, int W>
+	inline __m128 shuffle(__m128 vec1, __m128 vec2) noexcept
+	{
+		return _mm_shuffle_ps(vec1, vec2, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	// 4 packed Vector3<float> (12 floats) to one register per component, and back
+
+	inline void load_soa(const float* src, __m128& x, __m128& y, __m128& z) noexcept
+	{
+		const __m128 a{ _mm_loadu_ps(src) };		// x0 y0 z0 x1
+		const __m128 b{ _mm_loadu_ps(src + 4) };	// y1 z1 x2 y2
+		const __m128 c{ _mm_loadu_ps(src + 8) };	// z2 x3 y3 z3
+
+		x = shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c));
+		y = shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c));
+		z = shuffle<0, 2, 0, 3>(shuffle<2, 2, 1, 1>(a, b), c);
+	}
+
+	inline void store_soa(float* dst, __m128 x, __m128 y, __m128 z) noexcept
+	{
+		_mm_storeu_ps(dst, shuffle<0, 2, 0, 2>(shuffle<0, 0, 0, 0>(x, y), shuffle<0, 0, 1, 1>(z, x)));
+		_mm_storeu_ps(dst + 4, shuffle<0, 2, 0, 2>(shuffle<1, 1, 1, 1>(y, z), shuffle<2, 2, 2, 2>(x, y)));
+		_mm_storeu_ps(dst + 8, shuffle<0, 2, 0, 2>(shuffle<2, 2, 3, 3>(z, x), shuffle<3, 3, 3, 3>(y, z)));
+	}
+
+	inline __m128 madd(__m128 a, __m128 b, __m128 c) noexcept
+	{
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	}
+
+}
+
+
+namespace mpml::dispatch::detail::sse2
+{
+
+	void transform_points(const Matrix4<float>& mat, const Vector3<float>* points, Vector3<float>* out, std::size_t count) noexcept
+	{
+		const __m128 a{ _mm_set1_ps(mat.a) }, b{ _mm_set1_ps(mat.b) }, c{ _mm_set1_ps(mat.c) };
+		const __m128 e{ _mm_set1_ps(mat.e) }, f{ _mm_set1_ps(mat.f) }, g{ _mm_set1_ps(mat.g) };
+		const __m128 i{ _mm_set1_ps(mat.i) }, j{ _mm_set1_ps(mat.j) }, k{ _mm_set1_ps(mat.k) };
+		const __m128 m{ _mm_set1_ps(mat.m) }, n{ _mm_set1_ps(mat.n) }, o{ _mm_set1_ps(mat.o) };
+
+		std::size_t index{};
+
+		for (; index + 4 <= count; index += 4)
+		{
+			__m128 x, y, z;
+			load_soa(&points[index].x, x, y, z);
+
+			const __m128 x_r{ madd(a, x, madd(e, y, madd(i, z, m))) };
+			const __m128 y_r{ madd(b, x, madd(f, y, madd(j, z, n))) };
+			const __m128 z_r{ madd(c, x, madd(g, y, madd(k, z, o))) };
+
+			store_soa(&out[index].x, x_r, y_r, z_r);
+		}
+
+		scalar::transform_points(mat, points + index, out + index, count - index);
+	}
+
+	void normalize(Vector3<float>* vectors, std::size_t count) noexcept
+	{
+		std::size_t index{};
+
+		for (; index + 4 <= count; index += 4)
+		{
+			__m128 x, y, z;
+			load_soa(&vectors[index].x, x, y, z);
+
+			const __m128 len_sqd{ madd(x, x, madd(y, y, _mm_mul_ps(z, z))) };
+			const __m128 len{ _mm_sqrt_ps(len_sqd) };
+
+			// Null vectors are left untouched
+			const __m128 non_null{ _mm_cmpneq_ps(len_sqd, _mm_setzero_ps()) };
+
+			x = _mm_or_ps(_mm_and_ps(non_null, _mm_div_ps(x, len)), _mm_andnot_ps(non_null, x));
+			y = _mm_or_ps(_mm_and_ps(non_null, _mm_div_ps(y, len)), _mm_andnot_ps(non_null, y));
+			z = _mm_or_ps(_mm_and_ps(non_null, _mm_div_ps(z, len)), _mm_andnot_ps(non_null, z));
+
+			store_soa(&vectors[index].x, x, y, z);
+		}
+
+		scalar::normalize(vectors + index, count - index);
+	}
+
+	std::size_t cull_spheres(const Vector4<float>* planes, std::size_t plane_count, const Vector4<float>* spheres, std::size_t count, std::uint32_t* visible) noexcept
+	{
+		std::size_t visible_count{};
+		std::size_t index{};
+
+		for (; index + 4 <= count; index += 4)
+		{
+			__m128 x{ _mm_load_ps(&spheres[index].x) };
+			__m128 y{ _mm_load_ps(&spheres[index + 1].x) };
+			__m128 z{ _mm_load_ps(&spheres[index + 2].x) };
+			__m128 r{ _mm_load_ps(&spheres[index + 3].x) };
+
+			_MM_TRANSPOSE4_PS(x, y, z, r);
+
+			const __m128 neg_r{ _mm_sub_ps(_mm_setzero_ps(), r) };
+
+			int inside{ 0xF };
+
+			for (std::size_t p{}; p < plane_count && inside; p++)
+			{
+				const __m128 dist{ madd(_mm_set1_ps(planes[p].x), x, madd(_mm_set1_ps(planes[p].y), y, madd(_mm_set1_ps(planes[p].z), z, _mm_set1_ps(planes[p].w)))) };
+				inside &= _mm_movemask_ps(_mm_cmpge_ps(dist, neg_r));
+			}
+
+			for (std::uint32_t lane{}; lane < 4; lane++)
+				if (inside & (1 << lane))
+					visible[visible_count++] = static_cast<std::uint32_t>(index) + lane;
+		}
+
+		const std::size_t tail{ scalar::cull_spheres(planes, plane_count, spheres + index, count - index, visible + visible_count) };
+
+		for (std::size_t t{}; t < tail; t++)
+			visible[visible_count + t] += static_cast<std::uint32_t>(index);
+
+		return visible_count + tail;
+	}
+
+} // mpml::dispatch::detail::sse2
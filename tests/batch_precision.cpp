@@ -0,0 +1,111 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// Checks the Precision::standard error bounds documented in mpml/functions/batch.hpp for asin and acos
+//
+// Note:
+//	Floats are swept over their bit patterns in [-1, 1] with a stride, and densely around 0.5 and 1 where the reductions switch,
+//	doubles are drawn at random, near 1 and near 0. The reference is the long double <cmath> function.
+// ===================================================
+
+
+// Dependencies
+#include <bit>
+#include <span>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "mpml/functions/batch.hpp"
+
+#include "check.hpp"
+
+
+namespace
+{
+
+	// Largest error of func over values against reference
+	template<typename T, typename Func, typename Reference>
+	double max_ulp_error(const std::vector<T>& values, Func&& func, Reference&& reference)
+	{
+		std::vector<T> results(values.size());
+		func(std::span<const T>{ values }, std::span<T>{ results });
+
+		double max_error{};
+
+		for (size_t i{}; i < values.size(); i++)
+			max_error = std::max(max_error, mpml::test::ulp_error(results[i], reference(static_cast<long double>(values[i]))));
+
+		return max_error;
+	}
+
+	std::vector<float> float_inputs()
+	{
+		std::vector<float> values;
+
+		const auto add_bits{ [&](std::uint32_t first, std::uint32_t last, std::uint32_t stride) {
+			for (std::uint32_t bits{ first }; bits <= last; bits += stride)
+			{
+				values.push_back(std::bit_cast<float>(bits));
+				values.push_back(-std::bit_cast<float>(bits));
+			}
+		} };
+
+		add_bits(0, std::bit_cast<std::uint32_t>(1.f), 127);
+		add_bits(std::bit_cast<std::uint32_t>(0.5f) - (1u << 16), std::bit_cast<std::uint32_t>(0.5f) + (1u << 16), 1);
+		add_bits(std::bit_cast<std::uint32_t>(1.f) - (1u << 16), std::bit_cast<std::uint32_t>(1.f), 1);
+
+		return values;
+	}
+
+	std::vector<double> double_inputs()
+	{
+		std::mt19937_64 gen{ 7 };
+		std::uniform_real_distribution<double> dist{ -1.0, 1.0 };
+
+		std::vector<double> values;
+
+		for (size_t i{}; i < 300'000; i++)
+		{
+			const double value{ dist(gen) };
+
+			values.push_back(value);
+			values.push_back(std::copysign(1.0 - std::ldexp(std::abs(value), -static_cast<int>(i % 48)), value));
+			values.push_back(std::ldexp(value, -static_cast<int>(i % 60)));
+		}
+
+		return values;
+	}
+
+} // namespace
+
+
+int main()
+{
+	using mpml::test::check;
+
+	const auto asin_ref{ [](long double x) { return std::asin(x); } };
+	const auto acos_ref{ [](long double x) { return std::acos(x); } };
+
+	const auto asin{ [](auto x, auto out) { mpml::func::asin(x, out); } };
+	const auto acos{ [](auto x, auto out) { mpml::func::acos(x, out); } };
+
+	const std::vector<float> floats{ float_inputs() };
+	const std::vector<double> doubles{ double_inputs() };
+
+	const double asin_f{ max_ulp_error(floats, asin, asin_ref) };
+	const double acos_f{ max_ulp_error(floats, acos, acos_ref) };
+	const double asin_d{ max_ulp_error(doubles, asin, asin_ref) };
+	const double acos_d{ max_ulp_error(doubles, acos, acos_ref) };
+
+	std::printf("asin float %.3f ulp, acos float %.3f ulp, asin double %.3f ulp, acos double %.3f ulp\n", asin_f, acos_f, asin_d, acos_d);
+
+	check(asin_f <= 3.0, "asin float within 3 ulp");
+	check(acos_f <= 1.5, "acos float within 1.5 ulp");
+	check(asin_d <= 2.5, "asin double within 2.5 ulp");
+	check(acos_d <= 2.2, "acos double within 2.2 ulp");
+
+	return mpml::test::failures;
+}
@@ -0,0 +1,46 @@
+#pragma once
+// MIT
+// Allosker - 2026
+// ===================================================
+// Minimal checks shared by the tests: every failed check prints its message, main() returns the failure count
+//
+// Note:
+//	assert() is compiled out in Release, the tests have to fail there too.
+// ===================================================
+
+
+// Dependencies
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+
+namespace mpml::test
+{
+
+	inline int failures{};
+
+	inline void check(bool condition, const char* what) noexcept
+	{
+		if (!condition)
+		{
+			std::printf("FAILED: %s\n", what);
+			failures++;
+		}
+	}
+
+	// Distance between value and the exact reference, in units in the last place of the reference rounded to T
+	template<typename T>
+	[[nodiscard]] inline double ulp_error(T value, long double reference) noexcept
+	{
+		if (std::isnan(value) && std::isnan(reference))
+			return 0.0;
+
+		const T rounded{ static_cast<T>(std::fabs(reference)) };
+		const long double ulp{ rounded == T{} ? static_cast<long double>(std::numeric_limits<T>::denorm_min())
+			: static_cast<long double>(std::nextafter(rounded, std::numeric_limits<T>::infinity())) - rounded };
+
+		return static_cast<double>(std::fabs(static_cast<long double>(value) - reference) / ulp);
+	}
+
+} // mpml::test
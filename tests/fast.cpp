@@ -0,0 +1,130 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// Checks the error bounds documented in mpml/functions/fast.hpp and the handling of short and null vectors
+//
+// Note:
+//	Random vectors with components spread over [-1e3, 1e3], against the long double length and normal.
+// ===================================================
+
+
+// Dependencies
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "mpml/functions/fast.hpp"
+
+#include "check.hpp"
+
+
+namespace
+{
+
+	// Relative error of the length and largest component error of the normal over random vectors
+	template<typename T>
+	void check_accuracy(double bound)
+	{
+		using mpml::test::check;
+
+		std::mt19937 gen{ 11 };
+		std::uniform_real_distribution<T> dist{ static_cast<T>(-1e3), static_cast<T>(1e3) };
+
+		double length_error{}, normal_error{};
+
+		for (size_t i{}; i < 100'000; i++)
+		{
+			const mpml::Vector3<T> vec{ dist(gen), dist(gen), dist(gen) };
+
+			const long double x{ vec.x }, y{ vec.y }, z{ vec.z };
+			const long double length{ std::sqrt(x * x + y * y + z * z) };
+
+			const mpml::Vector3<T> normal{ mpml::fast::normal(vec) };
+
+			length_error = std::max(length_error, static_cast<double>(std::abs(mpml::fast::length(vec) - length) / length));
+			normal_error = std::max({ normal_error,
+				static_cast<double>(std::abs(normal.x - x / length)),
+				static_cast<double>(std::abs(normal.y - y / length)),
+				static_cast<double>(std::abs(normal.z - z / length)) });
+		}
+
+		std::printf("%s: length %.3g, normal %.3g\n", sizeof(T) == 4 ? "float" : "double", length_error, normal_error);
+
+		check(length_error <= bound, "fast::length within the documented relative error");
+		check(normal_error <= bound, "fast::normal within the documented relative error");
+	}
+
+	// Vectors far below 1 still normalize, down to the smallest normal squared length of T
+	template<typename T>
+	void check_short_vectors(T short_length, double bound)
+	{
+		using mpml::test::check;
+
+		const mpml::Vector3<T> normal{ mpml::fast::normal(mpml::Vector3<T>{ short_length, T{}, T{} }) };
+		check(std::abs(normal.x - 1) <= bound && normal.y == T{} && normal.z == T{}, "fast::normal of a short vector is unit");
+
+		const T length{ mpml::fast::length(mpml::Vector3<T>{ T{}, short_length, T{} }) };
+		check(std::abs(length - short_length) <= bound * short_length, "fast::length of a short vector");
+
+		const mpml::Vector3<T> null{ mpml::fast::normal(mpml::Vector3<T>{}) };
+		check(null.x == T{} && null.y == T{} && null.z == T{}, "fast::normal of a null vector is null");
+		check(mpml::fast::length(mpml::Vector3<T>{}) == T{}, "fast::length of a null vector is 0");
+
+		// Past the floor the result is scaled up but stays finite and short of unit length
+		const mpml::Vector3<T> tiny{ mpml::fast::normal(mpml::Vector3<T>{ std::numeric_limits<T>::denorm_min(), T{}, T{} }) };
+		check(std::isfinite(tiny.x) && tiny.x > T{} && tiny.x < 1, "fast::normal of a denormal vector stays finite");
+	}
+
+	template<typename T>
+	void check_packs(T short_length, double bound)
+	{
+		using mpml::test::check;
+		using Lanes = mpml::Pack<T, 8>;
+
+		mpml::Vector3<Lanes> vecs{ Lanes{ T{} }, Lanes{ T{} }, Lanes{ T{} } };
+
+		for (size_t i{}; i < 8; i++)
+		{
+			vecs.x.lanes[i] = static_cast<T>(i) - static_cast<T>(3.5);
+			vecs.y.lanes[i] = static_cast<T>(1e-20) * static_cast<T>(i + 1);
+			vecs.z.lanes[i] = static_cast<T>(2);
+		}
+
+		const mpml::Vector3<Lanes> normals{ mpml::fast::normal(vecs) };
+
+		for (size_t i{}; i < 8; i++)
+		{
+			const mpml::Vector3<T> normal{ mpml::Vector3<T>{ vecs.x.lanes[i], vecs.y.lanes[i], vecs.z.lanes[i] }.normal() };
+
+			check(std::abs(normals.x.lanes[i] - normal.x) <= bound && std::abs(normals.z.lanes[i] - normal.z) <= bound,
+				"fast::normal of a pack matches the lane by lane normal");
+		}
+
+		const Lanes small{ mpml::fast::normal(mpml::Vector3<Lanes>{ Lanes{ short_length }, Lanes{ T{} }, Lanes{ T{} } }).x };
+
+		for (size_t i{}; i < 8; i++)
+			check(std::abs(small.lanes[i] - 1) <= bound, "fast::normal of a short pack is unit");
+	}
+
+} // namespace
+
+
+int main()
+{
+	check_accuracy<float>(3.5e-7);
+	check_accuracy<double>(3.2e-11);
+
+	check_short_vectors<float>(1e-18f, 3.5e-7);
+	check_short_vectors<double>(1e-20, 3.2e-11);
+	check_short_vectors<double>(1e-150, 3.2e-11);
+
+	check_packs<float>(1e-18f, 3.5e-7);
+	check_packs<double>(1e-150, 3.2e-11);
+
+	// Constant evaluation takes the scalar Newton steps
+	static_assert(mpml::fast::normal(mpml::Vector3<double>{ 1e-20, 0.0, 0.0 }).x > 1.0 - 3.2e-11);
+	static_assert(mpml::fast::length(mpml::Vector3<double>{ 0.0, 3.0, 4.0 }) > 5.0 - 5.0 * 3.2e-11);
+
+	return mpml::test::failures;
+}
@@ -0,0 +1,198 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// Checks FlatHashMap against std::unordered_map over random insert / erase / operator[] / find sequences
+//
+// Note:
+//	The keys are drawn from a small range so that erase() hits, and the runs it shifts back are long.
+//	An int map with std::hash<int>, the identity, and keys 1024 apart checks that weak hashes still spread.
+// ===================================================
+
+
+// Dependencies
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "mpml/utilities/flat_hash_map.hpp"
+
+#include "check.hpp"
+
+
+namespace
+{
+
+	// Same entries, found by every lookup, batch find() included
+	template<typename Key, typename Value, typename Hash>
+	[[nodiscard]] bool same_entries(const mpml::FlatHashMap<Key, Value, Hash>& map, const std::unordered_map<Key, Value, Hash>& reference, const std::vector<Key>& probes)
+	{
+		if (map.size() != reference.size() || map.empty() != reference.empty())
+			return false;
+
+		size_t visited{};
+		bool match{ true };
+
+		map.for_each([&](const Key& key, const Value& value) {
+			const auto it{ reference.find(key) };
+			match = match && it != reference.end() && it->second == value;
+			visited++;
+		});
+
+		if (!match || visited != reference.size())
+			return false;
+
+		std::vector<const Value*> found(probes.size());
+		const size_t found_count{ map.find(std::span<const Key>{ probes }, std::span<const Value*>{ found }) };
+
+		size_t expected_count{};
+
+		for (size_t i{}; i < probes.size(); i++)
+		{
+			const auto it{ reference.find(probes[i]) };
+			const Value* value{ map.find(probes[i]) };
+
+			if (it == reference.end())
+				match = match && value == nullptr && found[i] == nullptr && !map.contains(probes[i]);
+			else
+				match = match && value != nullptr && *value == it->second && found[i] == value && map.contains(probes[i]);
+
+			expected_count += it != reference.end();
+		}
+
+		return match && found_count == expected_count;
+	}
+
+	template<typename Key, typename Hash, typename MakeKey>
+	void check_random(const char* what, MakeKey&& make_key)
+	{
+		using mpml::test::check;
+
+		std::mt19937 gen{ 7 };
+		std::uniform_int_distribution<int> operation{ 0, 9 };
+
+		mpml::FlatHashMap<Key, int, Hash> map;
+		std::unordered_map<Key, int, Hash> reference;
+
+		bool match{ true };
+
+		for (int step{}; step < 200'000; step++)
+		{
+			const Key key{ make_key(gen) };
+
+			switch (operation(gen))
+			{
+			case 0: case 1: case 2:
+				match = match && map.insert(key, step) == reference.emplace(key, step).second;
+				break;
+
+			case 3: case 4: case 5:
+				match = match && map.erase(key) == (reference.erase(key) == 1);
+				break;
+
+			case 6: case 7:
+				map[key] += step;
+				reference[key] += step;
+				break;
+
+			default:
+			{
+				const int* value{ map.find(key) };
+				const auto it{ reference.find(key) };
+				match = match && (it == reference.end() ? value == nullptr : value != nullptr && *value == it->second);
+				break;
+			}
+			}
+
+			if (step % 20'000 == 0)
+			{
+				std::vector<Key> probes(1000);
+
+				for (Key& probe : probes)
+					probe = make_key(gen);
+
+				match = match && same_entries(map, reference, probes);
+			}
+		}
+
+		std::vector<Key> probes(1000);
+
+		for (Key& probe : probes)
+			probe = make_key(gen);
+
+		match = match && same_entries(map, reference, probes);
+		check(match, what);
+
+		// at() throws on a missing key, clear() keeps the capacity
+		Key missing{ make_key(gen) };
+
+		while (reference.contains(missing))
+			missing = make_key(gen);
+
+		bool thrown{};
+
+		try
+		{
+			(void)map.at(missing);
+		}
+		catch (const std::out_of_range&)
+		{
+			thrown = true;
+		}
+
+		check(thrown, "FlatHashMap::at() throws std::out_of_range on a missing key");
+		check(reference.empty() || map.at(reference.begin()->first) == reference.begin()->second, "FlatHashMap::at() of a present key");
+
+		const size_t capacity{ map.capacity() };
+		map.clear();
+
+		check(map.empty() && map.capacity() == capacity && map.find(missing) == nullptr, "FlatHashMap::clear() empties the map, keeps the capacity");
+	}
+
+	void check_moves()
+	{
+		using mpml::test::check;
+		using Map = mpml::FlatHashMap<mpml::Vector3<int>, int>;
+
+		Map a;
+		a[{ 1, 2, 3 }] = 4;
+
+		Map b{ std::move(a) };
+		check(a.empty() && a.capacity() == 0 && a.find({ 1, 2, 3 }) == nullptr, "a moved-from FlatHashMap is empty");
+		check(b.size() == 1 && b.at({ 1, 2, 3 }) == 4, "a moved-to FlatHashMap holds the entries");
+
+		a[{ -5, 0, 5 }] = 6;
+		b = std::move(a);
+		check(a.empty() && !a.contains({ -5, 0, 5 }) && b.size() == 1 && b.at({ -5, 0, 5 }) == 6, "FlatHashMap move assignment");
+
+		Map c{ b };
+		c[{ 7, 7, 7 }] = 1;
+		check(b.size() == 1 && c.size() == 2, "a copied FlatHashMap is independent");
+	}
+
+} // namespace
+
+
+int main()
+{
+	check_random<mpml::Vector3<int>, std::hash<mpml::Vector3<int>>>("FlatHashMap of Vector3<int> matches std::unordered_map", [](std::mt19937& gen) {
+		std::uniform_int_distribution<int> dist{ -12, 12 };
+		return mpml::Vector3<int>{ dist(gen), dist(gen), dist(gen) };
+	});
+
+	check_random<int, std::hash<int>>("FlatHashMap of int with the identity hash matches std::unordered_map", [](std::mt19937& gen) {
+		std::uniform_int_distribution<int> dist{ -4000, 4000 };
+		return dist(gen) * 1024;
+	});
+
+	check_moves();
+
+	// Integer vectors are hashed by func::hash, not by combining std::hash of the components
+	const mpml::Vector3<int> cell{ -3, 17, 1 << 19 };
+	mpml::test::check(std::hash<mpml::Vector3<int>>{}(cell) == static_cast<size_t>(mpml::func::hash(cell)), "std::hash<Vector3<int>> goes through func::hash");
+	mpml::test::check(std::hash<mpml::Vector2<std::int64_t>>{}({ -1, 2 }) == static_cast<size_t>(mpml::func::hash(mpml::Vector2<std::int64_t>{ -1, 2 })), "std::hash<Vector2<int64>> goes through func::hash");
+
+	return mpml::test::failures;
+}
@@ -0,0 +1,178 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// Checks the integer vector operations of mpml/vectors/integer.hpp on negative values, where / and % round the wrong way
+//
+// Note:
+//	The references are floor(a / b) and a - b * floor(a / b) computed in long double, exact over the ranges used.
+//	The batch functions run on counts that are not a multiple of the lane count, so the scalar tail is checked too.
+// ===================================================
+
+
+// Dependencies
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+#include "mpml/vectors/integer.hpp"
+
+#include "check.hpp"
+
+
+namespace
+{
+
+	template<typename T>
+	[[nodiscard]] T floor_div_reference(T a, T b)
+	{
+		return static_cast<T>(std::floor(static_cast<long double>(a) / static_cast<long double>(b)));
+	}
+
+	template<typename T>
+	[[nodiscard]] T euclid_mod_reference(T a, T b)
+	{
+		return static_cast<T>(a - b * floor_div_reference(a, b));
+	}
+
+	template<typename T>
+	void check_division(T range)
+	{
+		using mpml::test::check;
+
+		std::mt19937 gen{ 17 };
+		std::uniform_int_distribution<T> value_dist{ -range, range };
+		std::uniform_int_distribution<T> divisor_dist{ 1, 100 };
+		std::uniform_int_distribution<unsigned> shift_dist{ 0, 12 };
+
+		bool division{ true }, pow2{ true };
+
+		for (size_t i{}; i < 100'000; i++)
+		{
+			const mpml::Vector3<T> vec{ value_dist(gen), value_dist(gen), -divisor_dist(gen) };
+			const T divisor{ divisor_dist(gen) };
+
+			const mpml::Vector3<T> quotient{ mpml::floor_div(vec, divisor) };
+			const mpml::Vector3<T> remainder{ mpml::euclid_mod(vec, divisor) };
+
+			division = division
+				&& quotient == mpml::Vector3<T>{ floor_div_reference(vec.x, divisor), floor_div_reference(vec.y, divisor), floor_div_reference(vec.z, divisor) }
+				&& remainder == mpml::Vector3<T>{ euclid_mod_reference(vec.x, divisor), euclid_mod_reference(vec.y, divisor), euclid_mod_reference(vec.z, divisor) };
+
+			const unsigned shift{ shift_dist(gen) };
+			const T size{ static_cast<T>(T{ 1 } << shift) };
+
+			pow2 = pow2
+				&& mpml::floor_div_pow2(vec, shift) == mpml::floor_div(vec, size)
+				&& mpml::mod_pow2(vec, shift) == mpml::euclid_mod(vec, size)
+				&& (vec & static_cast<T>(size - 1)) == mpml::euclid_mod(vec, size);
+		}
+
+		check(division, "floor_div and euclid_mod round toward -inf on negative values");
+		check(pow2, "floor_div_pow2, mod_pow2 and the mask agree with floor_div and euclid_mod");
+
+		// Cell -1 is the last local cell of chunk -1
+		check(mpml::floor_div(mpml::Vector2<T>{ -1, -16 }, 16) == mpml::Vector2<T>{ -1, -1 }, "floor_div of -1 and -16 by 16");
+		check(mpml::euclid_mod(mpml::Vector4<T>{ -1, -16, -17, 15 }, 16) == mpml::Vector4<T>{ 15, 0, 15, 15 }, "euclid_mod by 16 around 0");
+	}
+
+	void check_floor_to_int()
+	{
+		using mpml::test::check;
+
+		std::mt19937 gen{ 29 };
+		std::uniform_real_distribution<float> dist{ -1e4f, 1e4f };
+
+		// Integers, values just past them and the halves, then random values, 1003 of them to leave a scalar tail
+		std::vector<float> values{ -1.f, -0.5f, -1e-7f, -0.f, 0.f, 0.5f, 1.f, -16.f, -16.5f, -15.99f, -1024.f, -1024.25f, 1023.75f };
+
+		while (values.size() < 1003)
+			values.push_back(dist(gen));
+
+		std::vector<std::int32_t> floors(values.size());
+		mpml::func::floor_to_int(values, floors);
+
+		bool batch{ true }, vector{ true };
+
+		for (size_t i{}; i < values.size(); i++)
+		{
+			const std::int32_t reference{ static_cast<std::int32_t>(std::floor(values[i])) };
+
+			batch = batch && floors[i] == reference;
+			vector = vector && mpml::floor_to_int(mpml::Vector3<float>{ values[i], -values[i], values[i] - 0.5f })
+				== mpml::Vector3<std::int32_t>{ reference, static_cast<std::int32_t>(std::floor(-values[i])), static_cast<std::int32_t>(std::floor(values[i] - 0.5f)) };
+		}
+
+		check(batch, "func::floor_to_int of a span rounds negative values down");
+		check(vector, "floor_to_int of a Vector3 rounds negative values down");
+
+		// Chunks and locals of 2^4 cells, from the positions and from the cells
+		constexpr unsigned shift{ 4 };
+
+		std::vector<std::int32_t> chunks(values.size()), locals(values.size());
+		std::vector<std::int32_t> cell_chunks(values.size()), cell_locals(values.size());
+
+		mpml::func::split_pow2(std::span<const float>{ values }, shift, chunks, locals);
+		mpml::func::split_pow2(std::span<const std::int32_t>{ floors }, shift, cell_chunks, cell_locals);
+
+		bool split{ true };
+
+		for (size_t i{}; i < values.size(); i++)
+		{
+			const std::int32_t chunk{ floor_div_reference(floors[i], std::int32_t{ 16 }) };
+			const std::int32_t local{ euclid_mod_reference(floors[i], std::int32_t{ 16 }) };
+
+			split = split && chunks[i] == chunk && locals[i] == local && cell_chunks[i] == chunk && cell_locals[i] == local;
+		}
+
+		check(split, "split_pow2 of negative positions and cells");
+
+		const std::vector<mpml::Vector3<float>> positions{ { -0.5f, -16.f, -17.25f }, { 15.5f, 16.f, -1e-3f } };
+		std::vector<mpml::Vector3<std::int32_t>> vector_chunks(2), vector_locals(2);
+
+		mpml::func::split_pow2(std::span<const mpml::Vector3<float>>{ positions }, shift, vector_chunks, vector_locals);
+
+		check(vector_chunks[0] == mpml::Vector3<std::int32_t>{ -1, -1, -2 } && vector_locals[0] == mpml::Vector3<std::int32_t>{ 15, 0, 14 }
+			&& vector_chunks[1] == mpml::Vector3<std::int32_t>{ 0, 1, -1 } && vector_locals[1] == mpml::Vector3<std::int32_t>{ 15, 0, 15 },
+			"split_pow2 of Vector3 positions");
+	}
+
+	// Documented for the SIMD lanes only, the scalar conversion being undefined there
+	void check_out_of_range()
+	{
+#if defined(MPML_SIMD_SSE2)
+		using mpml::test::check;
+
+		constexpr std::int32_t int_min{ std::numeric_limits<std::int32_t>::min() };
+
+		std::vector<float> values(16, -3e9f);
+		values[1] = 3e9f;
+		values[2] = -1e20f;
+		values[3] = std::numeric_limits<float>::quiet_NaN();
+
+		std::vector<std::int32_t> floors(values.size());
+		mpml::func::floor_to_int(values, floors);
+
+		bool clamped{ true };
+
+		for (std::int32_t value : floors)
+			clamped = clamped && value == int_min;
+
+		check(clamped, "func::floor_to_int gives INT32_MIN out of range with SIMD");
+#endif
+	}
+
+} // namespace
+
+
+int main()
+{
+	check_division<std::int32_t>(1'000'000);
+	check_division<std::int64_t>(1'000'000'000'000);
+
+	check_floor_to_int();
+	check_out_of_range();
+
+	return mpml::test::failures;
+}
@@ -0,0 +1,115 @@
+// MIT
+// Allosker - 2026
+// ===================================================
+// Checks that ChunkedVoxelRay::next_chunk() lands on the cell that stepping with next() reaches
+//
+// Note:
+//	Origins, directions and cell sizes are dyadic, so every boundary distance is exact in float and double
+//	and boundaries crossed at the same distance are true ties: axis-tied and diagonal rays hit them all the time.
+// ===================================================
+
+
+// Dependencies
+#include <array>
+#include <random>
+
+#include "mpml/geometry/voxel_ray.hpp"
+
+#include "check.hpp"
+
+
+namespace
+{
+
+	template<typename T>
+	[[nodiscard]] bool same_state(const mpml::ChunkedVoxelRay<T>& a, const mpml::ChunkedVoxelRay<T>& b)
+	{
+		return a.cell() == b.cell() && a.chunk() == b.chunk() && a.local() == b.local() && a.index() == b.index()
+			&& a.distance() == b.distance() && a.normal() == b.normal();
+	}
+
+	// Jumps a chunk at a time on one copy, steps cell by cell to the next chunk on the other, until both end
+	template<typename T>
+	[[nodiscard]] bool jumps_match(const mpml::Vector3<T>& origin, const mpml::Vector3<T>& direction, T max_distance, T cell_size, int chunk_size)
+	{
+		const mpml::VoxelRay<T> ray{ origin, direction, max_distance, cell_size };
+
+		mpml::ChunkedVoxelRay<T> jumping{ ray, chunk_size };
+		mpml::ChunkedVoxelRay<T> stepping{ ray, chunk_size };
+
+		while (true)
+		{
+			const mpml::Vector3<int> chunk{ stepping.chunk() };
+
+			bool stepped{};
+			while ((stepped = stepping.next()) && stepping.chunk() == chunk) {}
+
+			if (jumping.next_chunk() != stepped)
+				return false;
+
+			if (!stepped)
+				return jumping.done();
+
+			if (!same_state(jumping, stepping))
+				return false;
+		}
+	}
+
+	template<typename T>
+	void check_ties()
+	{
+		using mpml::test::check;
+		using Vec = mpml::Vector3<T>;
+
+		// x and y boundaries at the same distance right at the start, next() steps x then y
+		check(jumps_match<T>(Vec{ -1.5, 0.5, 0.5 }, Vec{ -2, -2, 0 }, 100, 1, 16), "next_chunk() on a tie at the first boundary");
+		check(jumps_match<T>(Vec{ 0.5, 0.5, 0.5 }, Vec{ 1, 1, 1 }, 100, 1, 4), "next_chunk() along the main diagonal");
+		check(jumps_match<T>(Vec{ 0, 0, 0 }, Vec{ -1, 1, -1 }, 100, 1, 8), "next_chunk() on a diagonal through cell corners");
+		check(jumps_match<T>(Vec{ 3.25, -7.75, 0 }, Vec{ 0, 2, -2 }, 100, T{ 0.5 }, 4), "next_chunk() on a y / z tie");
+		check(jumps_match<T>(Vec{ 1, 2, 3 }, Vec{ 4, 0, 0 }, 100, 1, 16), "next_chunk() along a single axis");
+	}
+
+	template<typename T>
+	void check_random_rays()
+	{
+		using mpml::test::check;
+
+		std::mt19937 gen{ 23 };
+		std::uniform_int_distribution<int> origin_dist{ -320, 320 };
+		std::uniform_int_distribution<size_t> pick{ 0, 8 };
+
+		constexpr std::array<T, 9> components{ -4, -2, -1, T{ -0.5 }, 0, T{ 0.5 }, 1, 2, 4 };
+		constexpr std::array<int, 4> chunk_sizes{ 1, 2, 4, 16 };
+		constexpr std::array<T, 2> cell_sizes{ 1, T{ 0.5 } };
+
+		int mismatches{};
+
+		for (size_t i{}; i < 20'000; i++)
+		{
+			const mpml::Vector3<T> origin{ static_cast<T>(origin_dist(gen)) / 8, static_cast<T>(origin_dist(gen)) / 8, static_cast<T>(origin_dist(gen)) / 8 };
+			const mpml::Vector3<T> direction{ components[pick(gen)], components[pick(gen)], components[pick(gen)] };
+
+			if (direction == mpml::Vector3<T>{ 0, 0, 0 })
+				continue;
+
+			mismatches += jumps_match<T>(origin, direction, 60, cell_sizes[i % 2], chunk_sizes[(i / 2) % 4]) ? 0 : 1;
+		}
+
+		std::printf("%s: %d mismatches\n", sizeof(T) == 4 ? "float" : "double", mismatches);
+
+		check(mismatches == 0, "next_chunk() matches next() on random axis-tied and diagonal rays");
+	}
+
+} // namespace
+
+
+int main()
+{
+	check_ties<float>();
+	check_ties<double>();
+
+	check_random_rays<float>();
+	check_random_rays<double>();
+
+	return mpml::test::failures;
+}